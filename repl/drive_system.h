@@ -31,7 +31,7 @@ This utility is intended mainly for libraries to use - as such, the core of Toy
 
 ### Implementation Details
 
-The drive system uses a Toy's Dictionary structure to store the mappings between keys and values - this dictionary object is a static global which persists for the lifetime of the program.
+The drive system uses a Toy's Dictionary structure to store the mappings between keys and values - this dictionary object is a static global which persists for the lifetime of the program. It's shared by every thread, so the drive paths should all be set before any interpreters start running on other threads - after that, it's only read.
 !*/
 
 #include "toy_common.h"
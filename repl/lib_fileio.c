@@ -236,11 +236,33 @@ static int nativeRead(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 		}
 
 		case TOY_LITERAL_STRING: {
-			char value[TOY_MAX_STRING_LENGTH] = {0};
-			fscanf(file->fp, "%4095[^\n]", value);
-			value[TOY_MAX_STRING_LENGTH - 1] = '\0';
-
-			resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(value));
+			//read up to (but not including) the end of the line, however long it is
+			char* value = NULL;
+			int capacity = 0;
+			int length = 0;
+			int c;
+
+			while ((c = fgetc(file->fp)) != EOF && c != '\n') {
+				if (length + 1 > capacity) {
+					int oldCapacity = capacity;
+					capacity = TOY_GROW_CAPACITY(capacity);
+					value = TOY_GROW_ARRAY(char, value, oldCapacity, capacity);
+				}
+
+				value[length++] = (char)c;
+			}
+
+			if (c == '\n') {
+				ungetc(c, file->fp);
+			}
+
+			if (value != NULL) {
+				resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(value, length));
+				TOY_FREE_ARRAY(char, value, capacity);
+			}
+			else {
+				resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefStringLength("", 0));
+			}
 
 			break;
 		}
@@ -10,8 +10,8 @@
 
 typedef struct Toy_Runner {
 	Toy_Interpreter interpreter;
-	const unsigned char* bytecode;
-	size_t size;
+	Toy_Bytecode bytecode; //owned by the runner, and decoded once for every run
+	bool mapped; //bytecode files are mapped rather than read
 
 	bool dirty;
 } Toy_Runner;
@@ -56,7 +56,7 @@ static int nativeLoadScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argu
 		return -1;
 	}
 
-	const unsigned char* bytecode = Toy_compileString(source, &fileSize);
+	const unsigned char* bytecode = Toy_compileStringCached(source, &fileSize);
 	free((void*)source);
 
 	if (!bytecode) {
@@ -71,10 +71,12 @@ static int nativeLoadScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argu
 	Toy_setInterpreterAssert(&runner->interpreter, interpreter->assertOutput);
 	Toy_setInterpreterError(&runner->interpreter, interpreter->errorOutput);
 	runner->interpreter.hooks = interpreter->hooks;
+	runner->interpreter.lookupCache = interpreter->lookupCache;
 	runner->interpreter.scope = NULL;
 	Toy_resetInterpreter(&runner->interpreter);
-	runner->bytecode = bytecode;
-	runner->size = fileSize;
+	Toy_initBytecode(&runner->bytecode, bytecode, fileSize);
+	runner->bytecode.writable = true;
+	runner->mapped = false;
 	runner->dirty = false;
 
 	//build the opaque object, and push it to the stack
@@ -116,9 +118,9 @@ static int nativeLoadScriptBytecode(Toy_Interpreter* interpreter, Toy_LiteralArr
 	const char* filePath = Toy_toCString(TOY_AS_STRING(filePathLiteral));
 	size_t filePathLength = Toy_lengthRefString(TOY_AS_STRING(filePathLiteral));
 
-	//load the bytecode
+	//map the bytecode
 	size_t fileSize = 0;
-	unsigned char* bytecode = (unsigned char*)Toy_readFile(filePath, &fileSize);
+	const unsigned char* bytecode = Toy_mapFile(filePath, &fileSize);
 
 	if (!bytecode) {
 		interpreter->errorOutput("Failed to load bytecode file\n");
@@ -131,10 +133,12 @@ static int nativeLoadScriptBytecode(Toy_Interpreter* interpreter, Toy_LiteralArr
 	Toy_setInterpreterAssert(&runner->interpreter, interpreter->assertOutput);
 	Toy_setInterpreterError(&runner->interpreter, interpreter->errorOutput);
 	runner->interpreter.hooks = interpreter->hooks;
+	runner->interpreter.lookupCache = interpreter->lookupCache;
 	runner->interpreter.scope = NULL;
 	Toy_resetInterpreter(&runner->interpreter);
-	runner->bytecode = bytecode;
-	runner->size = fileSize;
+	Toy_initBytecode(&runner->bytecode, bytecode, fileSize);
+	runner->bytecode.writable = true; //the mapping is private
+	runner->mapped = true;
 	runner->dirty = false;
 
 	//build the opaque object, and push it to the stack
@@ -176,10 +180,7 @@ static int nativeRunScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argum
 		return -1;
 	}
 
-	unsigned char* bytecodeCopy = TOY_ALLOCATE(unsigned char, runner->size);
-	memcpy(bytecodeCopy, runner->bytecode, runner->size); //need a COPY of the bytecode, because the interpreter eats it
-
-	Toy_runInterpreter(&runner->interpreter, bytecodeCopy, runner->size);
+	Toy_runInterpreterBytecode(&runner->interpreter, &runner->bytecode);
 	runner->dirty = true;
 
 	//cleanup
@@ -395,8 +396,15 @@ static int nativeFreeScript(Toy_Interpreter* interpreter, Toy_LiteralArray* argu
 
 	//clear out the runner object
 	runner->interpreter.hooks = NULL;
+	runner->interpreter.lookupCache = NULL;
 	Toy_freeInterpreter(&runner->interpreter);
-	TOY_FREE_ARRAY(unsigned char, runner->bytecode, runner->size);
+	if (runner->mapped) {
+		Toy_unmapFile(runner->bytecode.data, runner->bytecode.length);
+	}
+	else {
+		TOY_FREE_ARRAY(unsigned char, runner->bytecode.data, runner->bytecode.length);
+	}
+	Toy_freeBytecode(&runner->bytecode);
 
 	TOY_FREE(Toy_Runner, runner);
 
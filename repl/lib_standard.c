@@ -660,26 +660,12 @@ static int nativeConcat(Toy_Interpreter* interpreter, Toy_LiteralArray* argument
 			return -1;
 		}
 
-		//get the combined length for the new string
-		size_t length = TOY_AS_STRING(selfLiteral)->length + TOY_AS_STRING(otherLiteral)->length + 1;
-
-		if (length > TOY_MAX_STRING_LENGTH) {
-			interpreter->errorOutput("Can't concatenate these strings, result is too long (error found in concat)\n");
-			Toy_freeLiteral(selfLiteral);
-			Toy_freeLiteral(otherLiteral);
-			return -1;
-		}
-
-		//allocate the space and generate
-		char* buffer = TOY_ALLOCATE(char, length);
-		snprintf(buffer, length, "%s%s", Toy_toCString(TOY_AS_STRING(selfLiteral)), Toy_toCString(TOY_AS_STRING(otherLiteral)));
-
-		Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer));
+		//generate the combined string
+		Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_concatRefString(TOY_AS_STRING(selfLiteral), TOY_AS_STRING(otherLiteral)));
 
 		//push and clean up
 		Toy_pushLiteralArray(&interpreter->stack, result);
 
-		TOY_FREE_ARRAY(char, buffer, length);
 		Toy_freeLiteral(selfLiteral);
 		Toy_freeLiteral(otherLiteral);
 		Toy_freeLiteral(result);
@@ -1685,6 +1671,7 @@ static int nativeSort(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 
 	//call the quicksort util
 	if (!sorted) {
+		Toy_unshareLiteralArray(TOY_AS_ARRAY(selfLiteral)); //sorts in place
 		recursiveLiteralQuicksortUtil(interpreter, TOY_AS_ARRAY(selfLiteral)->literals, TOY_AS_ARRAY(selfLiteral)->count, fnLiteral);
 	}
 
@@ -1718,7 +1705,7 @@ static int nativeToLower(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	}
 
 	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
-	const char* self = Toy_toCString(selfRefString);
+	const char* self = Toy_dataRefString(selfRefString);
 
 	//allocate buffer space for the result
 	char* result = TOY_ALLOCATE(char, Toy_lengthRefString(selfRefString) + 1);
@@ -1743,17 +1730,20 @@ static int nativeToLower(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	return 1;
 }
 
-static char* toStringUtilObject = NULL;
+static _Thread_local Toy_RefString* toStringUtilObject = NULL;
 static void toStringUtil(const char* input) {
-	size_t len = strlen(input) + 1;
-
-	if (len > TOY_MAX_STRING_LENGTH) {
-		len = TOY_MAX_STRING_LENGTH; //TODO: don't truncate
+	//copied straight into the result, however long it is
+	if (toStringUtilObject == NULL) {
+		toStringUtilObject = Toy_createRefString(input);
+		return;
 	}
 
-	toStringUtilObject = TOY_ALLOCATE(char, len);
+	Toy_RefString* tail = Toy_createRefString(input);
+	Toy_RefString* result = Toy_concatRefString(toStringUtilObject, tail);
 
-	snprintf(toStringUtilObject, len, "%s", input);
+	Toy_deleteRefString(toStringUtilObject);
+	Toy_deleteRefString(tail);
+	toStringUtilObject = result;
 }
 
 static int nativeToString(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
@@ -1772,17 +1762,23 @@ static int nativeToString(Toy_Interpreter* interpreter, Toy_LiteralArray* argume
 		Toy_freeLiteral(selfLiteralIdn);
 	}
 
+	//strings are already strings
+	if (TOY_IS_STRING(selfLiteral)) {
+		Toy_pushLiteralArray(&interpreter->stack, selfLiteral);
+		Toy_freeLiteral(selfLiteral);
+		return 1;
+	}
+
 	//print it to a custom function
 	Toy_printLiteralCustom(selfLiteral, toStringUtil);
 
-	//create the resulting string and push it
-	Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_createRefString(toStringUtilObject)); //internal copy
+	//take the resulting string and push it
+	Toy_Literal result = TOY_TO_STRING_LITERAL(toStringUtilObject); //NO copy
+	toStringUtilObject = NULL;
 
 	Toy_pushLiteralArray(&interpreter->stack, result);
 
 	//cleanup
-	TOY_FREE_ARRAY(char, toStringUtilObject, Toy_lengthRefString( TOY_AS_STRING(result) ) + 1);
-	toStringUtilObject = NULL;
 
 	Toy_freeLiteral(result);
 	Toy_freeLiteral(selfLiteral);
@@ -1812,7 +1808,7 @@ static int nativeToUpper(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	}
 
 	Toy_RefString* selfRefString = TOY_AS_STRING(selfLiteral);
-	const char* self = Toy_toCString(selfRefString);
+	const char* self = Toy_dataRefString(selfRefString);
 
 	//allocate buffer space for the result
 	char* result = TOY_ALLOCATE(char, Toy_lengthRefString(selfRefString) + 1);
@@ -1886,7 +1882,7 @@ static int nativeTrim(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 
 		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
 			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i] == Toy_toCString(trimCharsRefString)[trimIndex]) {
+			if (Toy_dataRefString(selfRefString)[i] == Toy_dataRefString(trimCharsRefString)[trimIndex]) {
 				break;
 			}
 
@@ -1904,12 +1900,12 @@ static int nativeTrim(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 	}
 
 	//again, from the back
-	for (int i = (int)Toy_lengthRefString(selfRefString); i >= 0; i--) {
+	for (int i = (int)Toy_lengthRefString(selfRefString); i > 0; i--) {
 		int trimIndex = 0;
 
 		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
 			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i-1] == Toy_toCString(trimCharsRefString)[trimIndex]) {
+			if (Toy_dataRefString(selfRefString)[i-1] == Toy_dataRefString(trimCharsRefString)[trimIndex]) {
 				break;
 			}
 
@@ -1932,9 +1928,7 @@ static int nativeTrim(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(""));
 	}
 	else {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, bufferEnd - bufferBegin + 1, "%s", &Toy_toCString(selfRefString)[ bufferBegin ]);
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer)); //internal copy
+		resultLiteral = TOY_TO_STRING_LITERAL(Toy_sliceRefString(selfRefString, bufferBegin, bufferEnd - bufferBegin));
 	}
 
 	//wrap up the buffer and return it
@@ -1997,7 +1991,7 @@ static int nativeTrimBegin(Toy_Interpreter* interpreter, Toy_LiteralArray* argum
 
 		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
 			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i] == Toy_toCString(trimCharsRefString)[trimIndex]) {
+			if (Toy_dataRefString(selfRefString)[i] == Toy_dataRefString(trimCharsRefString)[trimIndex]) {
 				break;
 			}
 
@@ -2020,9 +2014,7 @@ static int nativeTrimBegin(Toy_Interpreter* interpreter, Toy_LiteralArray* argum
 		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(""));
 	}
 	else {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, bufferEnd - bufferBegin + 1, "%s", &Toy_toCString(selfRefString)[ bufferBegin ]);
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer)); //internal copy
+		resultLiteral = TOY_TO_STRING_LITERAL(Toy_sliceRefString(selfRefString, bufferBegin, bufferEnd - bufferBegin));
 	}
 
 	//wrap up the buffer and return it
@@ -2080,12 +2072,12 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 	size_t bufferEnd = Toy_lengthRefString(selfRefString);
 
 	//again, from the back
-	for (int i = (int)Toy_lengthRefString(selfRefString); i >= 0; i--) {
+	for (int i = (int)Toy_lengthRefString(selfRefString); i > 0; i--) {
 		int trimIndex = 0;
 
 		while (trimIndex < (int)Toy_lengthRefString(trimCharsRefString)) {
 			//there is a match - DON'T increment anymore
-			if (Toy_toCString(selfRefString)[i-1] == Toy_toCString(trimCharsRefString)[trimIndex]) {
+			if (Toy_dataRefString(selfRefString)[i-1] == Toy_dataRefString(trimCharsRefString)[trimIndex]) {
 				break;
 			}
 
@@ -2108,9 +2100,7 @@ static int nativeTrimEnd(Toy_Interpreter* interpreter, Toy_LiteralArray* argumen
 		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(""));
 	}
 	else {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, bufferEnd - bufferBegin + 1, "%s", &Toy_toCString(selfRefString)[ bufferBegin ]);
-		resultLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer)); //internal copy
+		resultLiteral = TOY_TO_STRING_LITERAL(Toy_sliceRefString(selfRefString, bufferBegin, bufferEnd - bufferBegin));
 	}
 
 	//wrap up the buffer and return it
@@ -133,6 +133,16 @@ int main(int argc, const char* argv[]) {
 		printf(TOY_CC_NOTICE "Toy Programming Language Version %d.%d.%d, built '%s'\n" TOY_CC_RESET, TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, TOY_VERSION_BUILD);
 	}
 
+	//optimizer
+	if (Toy_commandLine.optimize) {
+		Toy_setBytecodeOptimization(true);
+	}
+
+	//bytecode cache
+	if (Toy_commandLine.cachedirectory) {
+		Toy_setBytecodeCacheDirectory(Toy_commandLine.cachedirectory);
+	}
+
 	//run source file
 	if (Toy_commandLine.sourcefile) {
 		//only works on toy files
@@ -145,6 +155,11 @@ int main(int argc, const char* argv[]) {
 		//run the source file
 		Toy_runSourceFile(Toy_commandLine.sourcefile);
 
+		if (Toy_commandLine.verbose && Toy_commandLine.cachedirectory) {
+			Toy_BytecodeCacheStats stats = Toy_getBytecodeCacheStats();
+			printf(TOY_CC_NOTICE "Bytecode cache: %d hits, %d misses\n" TOY_CC_RESET, stats.hits, stats.misses);
+		}
+
 		//lib cleanup
 		Toy_freeDriveSystem();
 
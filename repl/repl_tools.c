@@ -13,8 +13,17 @@
 #include "toy_compiler.h"
 #include "toy_interpreter.h"
 
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 //IO functions
 const unsigned char* Toy_readFile(const char* path, size_t* fileSize) {
@@ -50,6 +59,57 @@ const unsigned char* Toy_readFile(const char* path, size_t* fileSize) {
 	return buffer;
 }
 
+#ifndef _WIN32
+
+const unsigned char* Toy_mapFile(const char* path, size_t* fileSize) {
+	int fd = open(path, O_RDONLY);
+
+	if (fd < 0) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open file \"%s\"\n" TOY_CC_RESET, path);
+		return NULL;
+	}
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		fprintf(stderr, TOY_CC_ERROR "Could not map file \"%s\"\n" TOY_CC_RESET, path);
+		close(fd);
+		return NULL;
+	}
+
+	//private, so any writes are copied rather than reaching the file - pages that are never written stay shared
+	void* buffer = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd); //the mapping keeps the file open
+
+	if (buffer == MAP_FAILED) {
+		fprintf(stderr, TOY_CC_ERROR "Could not map file \"%s\"\n" TOY_CC_RESET, path);
+		return NULL;
+	}
+
+	*fileSize = (size_t)info.st_size;
+
+	return (const unsigned char*)buffer;
+}
+
+void Toy_unmapFile(const unsigned char* buffer, size_t fileSize) {
+	if (buffer != NULL) {
+		munmap((void*)buffer, fileSize);
+	}
+}
+
+#else
+
+//no mapping on this platform, so fall back to reading the whole file
+const unsigned char* Toy_mapFile(const char* path, size_t* fileSize) {
+	return Toy_readFile(path, fileSize);
+}
+
+void Toy_unmapFile(const unsigned char* buffer, size_t fileSize) {
+	free((void*)buffer);
+}
+
+#endif
+
 int Toy_writeFile(const char* path, const unsigned char* bytes, size_t size) {
 	FILE* file = fopen(path, "wb");
 
@@ -71,6 +131,12 @@ int Toy_writeFile(const char* path, const unsigned char* bytes, size_t size) {
 }
 
 //repl functions
+static bool optimizeBytecode = false;
+
+void Toy_setBytecodeOptimization(bool enabled) {
+	optimizeBytecode = enabled;
+}
+
 const unsigned char* Toy_compileString(const char* source, size_t* size) {
 	Toy_Lexer lexer;
 	Toy_Parser parser;
@@ -96,7 +162,12 @@ const unsigned char* Toy_compileString(const char* source, size_t* size) {
 		node = Toy_scanParser(&parser);
 	}
 
-	//step 2 - get the bytecode dump
+	//step 2 - optionally, optimize the written code
+	if (optimizeBytecode) {
+		Toy_optimizeCompiler(&compiler);
+	}
+
+	//step 3 - get the bytecode dump
 	const unsigned char* tb = Toy_collateCompiler(&compiler, size);
 
 	//cleanup
@@ -108,30 +179,162 @@ const unsigned char* Toy_compileString(const char* source, size_t* size) {
 	return tb;
 }
 
+static void injectLibraries(Toy_Interpreter* interpreter) {
+	Toy_injectNativeHook(interpreter, "toy_version_info", Toy_hookToyVersionInfo);
+	Toy_injectNativeHook(interpreter, "standard", Toy_hookStandard);
+	Toy_injectNativeHook(interpreter, "random", Toy_hookRandom);
+	Toy_injectNativeHook(interpreter, "runner", Toy_hookRunner);
+	Toy_injectNativeHook(interpreter, "fileio", Toy_hookFileIO);
+	Toy_injectNativeHook(interpreter, "math", Toy_hookMath);
+}
+
+//the bytecode cache - compiled sources are stored as .tb files, named after a hash of the source and the interpreter's version
+static const char* cacheDirectory = NULL;
+static atomic_int cacheHits = 0;
+static atomic_int cacheMisses = 0;
+
+void Toy_setBytecodeCacheDirectory(const char* directory) {
+	cacheDirectory = directory;
+}
+
+Toy_BytecodeCacheStats Toy_getBytecodeCacheStats() {
+	return (Toy_BytecodeCacheStats){ .hits = cacheHits, .misses = cacheMisses };
+}
+
+//FNV-1a, 64 bits wide
+static uint64_t hashBytes(uint64_t hash, const void* bytes, size_t length) {
+	for (size_t i = 0; i < length; i++) {
+		hash ^= ((const unsigned char*)bytes)[i];
+		hash *= 1099511628211u;
+	}
+
+	return hash;
+}
+
+bool Toy_getBytecodeCachePath(const char* source, char* buffer, size_t bufferSize) {
+	if (cacheDirectory == NULL) {
+		return false;
+	}
+
+	//any change to the source, the interpreter or the optimization setting gives a new key, so old entries are never used again
+	const unsigned char version[4] = { TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, optimizeBytecode };
+	const char* build = TOY_VERSION_BUILD;
+	size_t length = strlen(source);
+
+	uint64_t hash = 14695981039346656037u;
+	hash = hashBytes(hash, version, sizeof(version));
+	hash = hashBytes(hash, build, strlen(build) + 1);
+	hash = hashBytes(hash, source, length);
+
+	int written = snprintf(buffer, bufferSize, "%s/%016llx-%zx.tb", cacheDirectory, (unsigned long long)hash, length);
+
+	return written > 0 && (size_t)written < bufferSize;
+}
+
+//a missing file is a normal cache miss, so this doesn't print errors like Toy_readFile()
+static const unsigned char* readCacheFile(const char* path, size_t* fileSize) {
+	FILE* file = fopen(path, "rb");
+
+	if (file == NULL) {
+		return NULL;
+	}
+
+	fseek(file, 0L, SEEK_END);
+	long size = ftell(file);
+	rewind(file);
+
+	unsigned char* buffer = size > 3 ? (unsigned char*)malloc(size) : NULL;
+
+	if (buffer == NULL || fread(buffer, 1, size, file) != (size_t)size) {
+		free(buffer);
+		fclose(file);
+		return NULL;
+	}
+
+	fclose(file);
+
+	//the version is part of the key, so this only catches damaged files
+	if (buffer[0] != TOY_VERSION_MAJOR || buffer[1] != TOY_VERSION_MINOR || buffer[2] != TOY_VERSION_PATCH) {
+		free(buffer);
+		return NULL;
+	}
+
+	*fileSize = (size_t)size;
+	return buffer;
+}
+
+const unsigned char* Toy_compileStringCached(const char* source, size_t* size) {
+	char path[4096];
+
+	if (!Toy_getBytecodeCachePath(source, path, sizeof(path))) {
+		return Toy_compileString(source, size);
+	}
+
+	//hit
+	const unsigned char* tb = readCacheFile(path, size);
+
+	if (tb != NULL) {
+		cacheHits++;
+		return tb;
+	}
+
+	//miss
+	cacheMisses++;
+	tb = Toy_compileString(source, size);
+
+	if (tb == NULL) {
+		return NULL;
+	}
+
+	//write to a temporary file first, so other processes never see a partial entry
+	char temp[4096 + 32];
+#ifndef _WIN32
+	snprintf(temp, sizeof(temp), "%s.%ld.tmp", path, (long)getpid());
+#else
+	snprintf(temp, sizeof(temp), "%s.tmp", path);
+#endif
+
+	if (Toy_writeFile(temp, tb, *size) == 0 && rename(temp, path) != 0) {
+		remove(temp);
+	}
+
+	return tb;
+}
+
 void Toy_runBinary(const unsigned char* tb, size_t size) {
 	Toy_Interpreter interpreter;
 	Toy_initInterpreter(&interpreter);
 
 	//inject the libs
-	Toy_injectNativeHook(&interpreter, "toy_version_info", Toy_hookToyVersionInfo);
-	Toy_injectNativeHook(&interpreter, "standard", Toy_hookStandard);
-	Toy_injectNativeHook(&interpreter, "random", Toy_hookRandom);
-	Toy_injectNativeHook(&interpreter, "runner", Toy_hookRunner);
-	Toy_injectNativeHook(&interpreter, "fileio", Toy_hookFileIO);
-	Toy_injectNativeHook(&interpreter, "math", Toy_hookMath);
+	injectLibraries(&interpreter);
 
 	Toy_runInterpreter(&interpreter, tb, (int)size);
 	Toy_freeInterpreter(&interpreter);
 }
 
 void Toy_runBinaryFile(const char* fname) {
-	size_t size = 0; //not used
-	const unsigned char* tb = Toy_readFile(fname, &size);
+	size_t size = 0;
+	const unsigned char* tb = Toy_mapFile(fname, &size);
 	if (!tb) {
 		return;
 	}
-	Toy_runBinary(tb, size);
-	//interpreter takes ownership of the binary data
+
+	//the mapping is private, so it can be quickened in place
+	Toy_Bytecode bytecode;
+	Toy_initBytecode(&bytecode, tb, size);
+	bytecode.writable = true;
+
+	Toy_Interpreter interpreter;
+	Toy_initInterpreter(&interpreter);
+
+	//inject the libs
+	injectLibraries(&interpreter);
+
+	Toy_runInterpreterBytecode(&interpreter, &bytecode);
+	Toy_freeInterpreter(&interpreter);
+
+	Toy_freeBytecode(&bytecode);
+	Toy_unmapFile(tb, size);
 }
 
 void Toy_runSource(const char* source) {
@@ -150,8 +353,15 @@ void Toy_runSourceFile(const char* fname) {
 	if (!source) {
 		return;
 	}
-	Toy_runSource(source);
+
+	const unsigned char* tb = Toy_compileStringCached(source, &size);
 	free((void*)source);
+
+	if (!tb) {
+		return;
+	}
+
+	Toy_runBinary(tb, size);
 }
 
 //utils for debugging the header
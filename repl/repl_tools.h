@@ -23,6 +23,24 @@ On error, this function returns `NULL`.
 !*/
 const unsigned char* Toy_readFile(const char* path, size_t* fileSize);
 
+/*!
+### const unsigned char* Toy_mapFile(const char* path, size_t* fileSize)
+
+This function maps a file into memory, rather than reading it, and sets the variable pointed to by `fileSize` to its size. The mapping is private and copy-on-write - it can be written to (such as by quickening), but those changes never reach the file, and any pages that aren't written to are shared with every other process mapping the same file. Unlike `Toy_readFile()`, the buffer isn't null terminated, so this is intended for bytecode rather than source code.
+
+The buffer must be released with `Toy_unmapFile()`. On platforms without `mmap()`, the file is read instead.
+
+On error, this function returns `NULL`.
+!*/
+const unsigned char* Toy_mapFile(const char* path, size_t* fileSize);
+
+/*!
+### void Toy_unmapFile(const unsigned char* buffer, size_t fileSize)
+
+This function releases a buffer returned by `Toy_mapFile()`.
+!*/
+void Toy_unmapFile(const unsigned char* buffer, size_t fileSize);
+
 /*!
 ### int Toy_writeFile(const char* path, const unsigned char* bytes, size_t size)
 
@@ -41,6 +59,50 @@ On error, this function returns `NULL`.
 !*/
 const unsigned char* Toy_compileString(const char* source, size_t* size);
 
+/*!
+### void Toy_setBytecodeOptimization(bool enabled)
+
+This function sets whether `Toy_compileString()` runs `Toy_optimizeCompiler()` before collating the bytecode. It is disabled by default.
+!*/
+void Toy_setBytecodeOptimization(bool enabled);
+
+/*!
+### const unsigned char* Toy_compileStringCached(const char* source, size_t* size)
+
+This function behaves like `Toy_compileString()`, except that it first looks for the compiled bytecode in the bytecode cache (see `Toy_setBytecodeCacheDirectory()`). On a hit, the source isn't parsed at all; on a miss, the result is written to the cache for next time. If no cache directory is set, this is the same as `Toy_compileString()`.
+
+On error, this function returns `NULL`.
+!*/
+const unsigned char* Toy_compileStringCached(const char* source, size_t* size);
+
+/*!
+### void Toy_setBytecodeCacheDirectory(const char* directory)
+
+This function enables the bytecode cache, which stores compiled sources as `.tb` files within `directory` (which must already exist). Passing `NULL` disables it again - it is disabled by default. The string isn't copied, so it must outlive its use.
+
+Each entry is named after a hash of the source code, along with the interpreter's version and build, so editing a script or updating the interpreter never uses a stale entry. Old entries are simply left behind, and the directory can be cleared at any time.
+!*/
+void Toy_setBytecodeCacheDirectory(const char* directory);
+
+/*!
+### bool Toy_getBytecodeCachePath(const char* source, char* buffer, size_t bufferSize)
+
+This function writes the path of the cache entry for `source` into `buffer`, whether or not it exists. It returns false if the cache is disabled, or if `buffer` is too small.
+!*/
+bool Toy_getBytecodeCachePath(const char* source, char* buffer, size_t bufferSize);
+
+/*!
+### Toy_BytecodeCacheStats Toy_getBytecodeCacheStats()
+
+This function returns the number of times `Toy_compileStringCached()` has hit and missed the bytecode cache.
+!*/
+typedef struct Toy_BytecodeCacheStats {
+	int hits;
+	int misses;
+} Toy_BytecodeCacheStats;
+
+Toy_BytecodeCacheStats Toy_getBytecodeCacheStats();
+
 /*!
 ### void Toy_runBinary(const unsigned char* tb, size_t size)
 
@@ -56,7 +118,7 @@ void Toy_runBinary(const unsigned char* tb, size_t size);
 /*!
 ### void Toy_runBinaryFile(const char* fname)
 
-This function loads in the binary file specified by `fname`, and passes it to `Toy_runBinary()`.
+This function maps the binary file specified by `fname` with `Toy_mapFile()`, and runs it with the same libraries as `Toy_runBinary()`. The file is never copied into the interpreter.
 !*/
 void Toy_runBinaryFile(const char* fname);
 
@@ -70,7 +132,7 @@ void Toy_runSource(const char* source);
 /*!
 ### void Toy_runSourceFile(const char* fname)
 
-This function loads in the file specified by `fname`, compiles it, and passes it to `Toy_runBinary()`.
+This function loads in the file specified by `fname`, compiles it with `Toy_compileStringCached()`, and passes it to `Toy_runBinary()`.
 !*/
 void Toy_runSourceFile(const char* fname);
 
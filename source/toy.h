@@ -17,11 +17,13 @@ The most important macro is `TOY_API`, which specifies functions intended for th
 * [toy_common.h](toy_common_h.md)
 * [toy_console_colors.h](toy_console_colors_h.md)
 * [toy_memory.h](toy_memory_h.md)
+* [toy_context.h](toy_context_h.md)
 !*/
 
 #include "toy_common.h"
 #include "toy_console_colors.h"
 #include "toy_memory.h"
+#include "toy_context.h"
 
 /*!
 ## Core Pipeline
@@ -41,12 +43,17 @@ I should note that the parser -> compiler phase is actually made up of two steps
 * [toy_parser.h](toy_parser_h.md)
 * [toy_compiler.h](toy_compiler_h.md)
 * [toy_interpreter.h](toy_interpreter_h.md)
+
+Hosts that run the same script many times can fork a pre-warmed interpreter instead of setting up a new one each time.
+
+* [toy_interpreter_pool.h](toy_interpreter_pool_h.md)
 !*/
 
 #include "toy_lexer.h"
 #include "toy_parser.h"
 #include "toy_compiler.h"
 #include "toy_interpreter.h"
+#include "toy_interpreter_pool.h"
 
 /*!
 ## Building Block Structures
@@ -4,6 +4,127 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+//arenas hand out chunks of this size, unless a larger array is needed
+#define TOY_AST_ARENA_CHUNK_SIZE (16 * 1024)
+
+//each allocation records where it came from, so a node can be freed without knowing which parser made it
+typedef struct Toy_private_ast_header {
+	Toy_ASTArena* arena; //NULL when on the heap
+} Toy_private_ast_header;
+
+#define HEADER_OF(nodes)	(((Toy_private_ast_header*)(nodes)) - 1)
+#define NODES_OF(header)	((Toy_ASTNode*)((header) + 1))
+#define SIZE_OF(count)		(sizeof(Toy_private_ast_header) + sizeof(Toy_ASTNode) * (count))
+
+static Toy_private_ast_header* arenaAllocate(Toy_ASTArena* arena, size_t size) {
+	Toy_private_ast_chunk* chunk = arena->chunks;
+
+	//the tail of a full chunk is abandoned
+	if (chunk == NULL || chunk->capacity - chunk->count < size) {
+		size_t capacity = size > TOY_AST_ARENA_CHUNK_SIZE ? size : TOY_AST_ARENA_CHUNK_SIZE;
+
+		chunk = (Toy_private_ast_chunk*)TOY_ALLOCATE(unsigned char, sizeof(Toy_private_ast_chunk) + capacity);
+		chunk->next = arena->chunks;
+		chunk->capacity = capacity;
+		chunk->count = 0;
+
+		arena->chunks = chunk;
+	}
+
+	Toy_private_ast_header* header = (Toy_private_ast_header*)((unsigned char*)(chunk + 1) + chunk->count);
+	chunk->count += size;
+
+	header->arena = arena;
+	return header;
+}
+
+void Toy_initASTArena(Toy_ASTArena* arena) {
+	arena->chunks = NULL;
+}
+
+void Toy_clearASTArena(Toy_ASTArena* arena) {
+	if (arena->chunks == NULL) {
+		return;
+	}
+
+	Toy_private_ast_chunk* chunk = arena->chunks->next;
+
+	while (chunk != NULL) {
+		Toy_private_ast_chunk* next = chunk->next;
+		TOY_FREE_ARRAY(unsigned char, chunk, sizeof(Toy_private_ast_chunk) + chunk->capacity);
+		chunk = next;
+	}
+
+	arena->chunks->next = NULL;
+	arena->chunks->count = 0;
+}
+
+void Toy_freeASTArena(Toy_ASTArena* arena) {
+	Toy_clearASTArena(arena);
+
+	if (arena->chunks != NULL) {
+		TOY_FREE_ARRAY(unsigned char, arena->chunks, sizeof(Toy_private_ast_chunk) + arena->chunks->capacity);
+	}
+
+	arena->chunks = NULL;
+}
+
+Toy_ASTNode* Toy_private_allocateASTNodes(Toy_ASTArena* arena, int count) {
+	Toy_private_ast_header* header;
+
+	if (arena != NULL) {
+		header = arenaAllocate(arena, SIZE_OF(count));
+	}
+	else {
+		header = (Toy_private_ast_header*)TOY_ALLOCATE(unsigned char, SIZE_OF(count));
+		header->arena = NULL;
+	}
+
+	return NODES_OF(header);
+}
+
+Toy_ASTNode* Toy_private_growASTNodes(Toy_ASTArena* arena, Toy_ASTNode* nodes, int oldCount, int count) {
+	if (nodes == NULL) {
+		return Toy_private_allocateASTNodes(arena, count);
+	}
+
+	Toy_private_ast_header* header = HEADER_OF(nodes);
+
+	if (header->arena == NULL) {
+		header = (Toy_private_ast_header*)TOY_GROW_ARRAY(unsigned char, header, SIZE_OF(oldCount), SIZE_OF(count));
+		return NODES_OF(header);
+	}
+
+	//the most recent allocation can grow in place
+	Toy_private_ast_chunk* chunk = header->arena->chunks;
+	unsigned char* top = (unsigned char*)(chunk + 1) + chunk->count;
+	size_t extra = sizeof(Toy_ASTNode) * (count - oldCount);
+
+	if ((unsigned char*)(nodes + oldCount) == top && chunk->capacity - chunk->count >= extra) {
+		chunk->count += extra;
+		return nodes;
+	}
+
+	Toy_private_ast_header* grown = arenaAllocate(header->arena, SIZE_OF(count));
+	memcpy(NODES_OF(grown), nodes, sizeof(Toy_ASTNode) * oldCount);
+
+	return NODES_OF(grown);
+}
+
+void Toy_private_freeASTNodes(Toy_ASTNode* nodes, int count) {
+	if (nodes == NULL) {
+		return;
+	}
+
+	Toy_private_ast_header* header = HEADER_OF(nodes);
+
+	//nodes within an arena are released along with it
+	if (header->arena == NULL) {
+		TOY_FREE_ARRAY(unsigned char, header, SIZE_OF(count));
+	}
+}
 
 static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 	//don't free a NULL node
@@ -44,7 +165,7 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 				for (int i = 0; i < node->block.count; i++) {
 					freeASTNodeCustom(node->block.nodes + i, false);
 				}
-				TOY_FREE_ARRAY(Toy_ASTNode, node->block.nodes, node->block.capacity);
+				Toy_private_freeASTNodes(node->block.nodes, node->block.capacity);
 			}
 		break;
 
@@ -53,7 +174,7 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 				for (int i = 0; i < node->compound.count; i++) {
 					freeASTNodeCustom(node->compound.nodes + i, false);
 				}
-				TOY_FREE_ARRAY(Toy_ASTNode, node->compound.nodes, node->compound.capacity);
+				Toy_private_freeASTNodes(node->compound.nodes, node->compound.capacity);
 			}
 		break;
 
@@ -79,7 +200,7 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 				for (int i = 0; i < node->fnCollection.count; i++) {
 					freeASTNodeCustom(node->fnCollection.nodes + i, false);
 				}
-				TOY_FREE_ARRAY(Toy_ASTNode, node->fnCollection.nodes, node->fnCollection.capacity);
+				Toy_private_freeASTNodes(node->fnCollection.nodes, node->fnCollection.capacity);
 			}
 		break;
 
@@ -158,7 +279,7 @@ static void freeASTNodeCustom(Toy_ASTNode* node, bool freeSelf) {
 	}
 
 	if (freeSelf) {
-		TOY_FREE(Toy_ASTNode, node);
+		Toy_private_freeASTNodes(node, 1);
 	}
 }
 
@@ -167,25 +288,25 @@ void Toy_freeASTNode(Toy_ASTNode* node) {
 }
 
 //various emitters
-void Toy_emitASTNodeLiteral(Toy_ASTNode** nodeHandle, Toy_Literal literal) {
+void Toy_emitASTNodeLiteral(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal literal) {
 	//allocate a new node
-	*nodeHandle = TOY_ALLOCATE(Toy_ASTNode, 1);
+	*nodeHandle = Toy_private_allocateASTNodes(arena, 1);
 
 	(*nodeHandle)->type = TOY_AST_NODE_LITERAL;
 	(*nodeHandle)->atomic.literal = Toy_copyLiteral(literal);
 }
 
-void Toy_emitASTNodeUnary(Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child) {
+void Toy_emitASTNodeUnary(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child) {
 	//allocate a new node
-	*nodeHandle = TOY_ALLOCATE(Toy_ASTNode, 1);
+	*nodeHandle = Toy_private_allocateASTNodes(arena, 1);
 
 	(*nodeHandle)->type = TOY_AST_NODE_UNARY;
 	(*nodeHandle)->unary.opcode = opcode;
 	(*nodeHandle)->unary.child = child;
 }
 
-void Toy_emitASTNodeBinary(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeBinary(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_BINARY;
 	tmp->binary.opcode = opcode;
@@ -195,8 +316,8 @@ void Toy_emitASTNodeBinary(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcod
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeTernary(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeTernary(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_TERNARY;
 	tmp->ternary.condition = condition;
@@ -206,8 +327,8 @@ void Toy_emitASTNodeTernary(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, To
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeGrouping(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeGrouping(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_GROUPING;
 	tmp->grouping.child = *nodeHandle;
@@ -215,8 +336,8 @@ void Toy_emitASTNodeGrouping(Toy_ASTNode** nodeHandle) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeBlock(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeBlock(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_BLOCK;
 	tmp->block.nodes = NULL; //NOTE: appended by the parser
@@ -226,8 +347,8 @@ void Toy_emitASTNodeBlock(Toy_ASTNode** nodeHandle) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeCompound(Toy_ASTNode** nodeHandle, Toy_LiteralType literalType) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeCompound(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_LiteralType literalType) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_COMPOUND;
 	tmp->compound.literalType = literalType;
@@ -245,8 +366,8 @@ void Toy_setASTNodePair(Toy_ASTNode* node, Toy_ASTNode* left, Toy_ASTNode* right
 	node->pair.right = right;
 }
 
-void Toy_emitASTNodeIndex(Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeIndex(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_INDEX;
 	tmp->index.first = first;
@@ -256,8 +377,8 @@ void Toy_emitASTNodeIndex(Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTN
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeVarDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal typeLiteral, Toy_ASTNode* expression) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeVarDecl(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal typeLiteral, Toy_ASTNode* expression) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_VAR_DECL;
 	tmp->varDecl.identifier = identifier;
@@ -267,8 +388,8 @@ void Toy_emitASTNodeVarDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, To
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnCollection(Toy_ASTNode** nodeHandle) { //a collection of nodes, intended for use with functions
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnCollection(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle) { //a collection of nodes, intended for use with functions
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_FN_COLLECTION;
 	tmp->fnCollection.nodes = NULL;
@@ -278,8 +399,8 @@ void Toy_emitASTNodeFnCollection(Toy_ASTNode** nodeHandle) { //a collection of n
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnDecl(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_FN_DECL;
 	tmp->fnDecl.identifier = identifier;
@@ -290,8 +411,8 @@ void Toy_emitASTNodeFnDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnCall(Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnCall(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_FN_CALL;
 	tmp->fnCall.arguments = arguments;
@@ -300,8 +421,8 @@ void Toy_emitASTNodeFnCall(Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFnReturn(Toy_ASTNode** nodeHandle, Toy_ASTNode* returns) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFnReturn(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* returns) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_FN_RETURN;
 	tmp->returns.returns = returns;
@@ -309,8 +430,8 @@ void Toy_emitASTNodeFnReturn(Toy_ASTNode** nodeHandle, Toy_ASTNode* returns) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeIf(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeIf(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_IF;
 	tmp->pathIf.condition = condition;
@@ -320,8 +441,8 @@ void Toy_emitASTNodeIf(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_AST
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeWhile(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeWhile(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_WHILE;
 	tmp->pathWhile.condition = condition;
@@ -330,8 +451,8 @@ void Toy_emitASTNodeWhile(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeFor(Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeFor(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_FOR;
 	tmp->pathFor.preClause = preClause;
@@ -342,24 +463,24 @@ void Toy_emitASTNodeFor(Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_AS
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeBreak(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeBreak(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_BREAK;
 
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeContinue(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeContinue(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_CONTINUE;
 
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeAnd(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeAnd(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_AND;
 	tmp->binary.left = *nodeHandle;
@@ -368,8 +489,8 @@ void Toy_emitASTNodeAnd(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeOr(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeOr(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_OR;
 	tmp->binary.left = *nodeHandle;
@@ -378,8 +499,8 @@ void Toy_emitASTNodeOr(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs) {
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePrefixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePrefixIncrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_PREFIX_INCREMENT;
 	tmp->prefixIncrement.identifier = Toy_copyLiteral(identifier);
@@ -387,8 +508,8 @@ void Toy_emitASTNodePrefixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identi
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePrefixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePrefixDecrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_PREFIX_DECREMENT;
 	tmp->prefixDecrement.identifier = Toy_copyLiteral(identifier);
@@ -396,8 +517,8 @@ void Toy_emitASTNodePrefixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identi
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePostfixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePostfixIncrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_POSTFIX_INCREMENT;
 	tmp->postfixIncrement.identifier = Toy_copyLiteral(identifier);
@@ -405,8 +526,8 @@ void Toy_emitASTNodePostfixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal ident
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePostfixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePostfixDecrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_POSTFIX_DECREMENT;
 	tmp->postfixDecrement.identifier = Toy_copyLiteral(identifier);
@@ -414,8 +535,8 @@ void Toy_emitASTNodePostfixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal ident
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodeImport(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodeImport(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_IMPORT;
 	tmp->import.identifier = Toy_copyLiteral(identifier);
@@ -424,8 +545,8 @@ void Toy_emitASTNodeImport(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy
 	*nodeHandle = tmp;
 }
 
-void Toy_emitASTNodePass(Toy_ASTNode** nodeHandle) {
-	Toy_ASTNode* tmp = TOY_ALLOCATE(Toy_ASTNode, 1);
+void Toy_emitASTNodePass(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle) {
+	Toy_ASTNode* tmp = Toy_private_allocateASTNodes(arena, 1);
 
 	tmp->type = TOY_AST_NODE_PASS;
 
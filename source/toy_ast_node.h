@@ -8,6 +8,9 @@
 //nodes are the intermediaries between parsers and compilers
 typedef union Toy_private_node Toy_ASTNode;
 
+//nodes are allocated from an arena, or from the heap when it's NULL
+typedef struct Toy_ASTArena Toy_ASTArena;
+
 typedef enum Toy_ASTNodeType {
 	TOY_AST_NODE_ERROR,
 	TOY_AST_NODE_LITERAL, //a simple value
@@ -40,7 +43,7 @@ typedef enum Toy_ASTNodeType {
 } Toy_ASTNodeType;
 
 //literals
-void Toy_emitASTNodeLiteral(Toy_ASTNode** nodeHandle, Toy_Literal literal);
+void Toy_emitASTNodeLiteral(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal literal);
 
 typedef struct Toy_NodeLiteral {
 	Toy_ASTNodeType type;
@@ -48,7 +51,7 @@ typedef struct Toy_NodeLiteral {
 } Toy_NodeLiteral;
 
 //unary operator
-void Toy_emitASTNodeUnary(Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child);
+void Toy_emitASTNodeUnary(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Opcode opcode, Toy_ASTNode* child);
 
 typedef struct Toy_NodeUnary {
 	Toy_ASTNodeType type;
@@ -57,7 +60,7 @@ typedef struct Toy_NodeUnary {
 } Toy_NodeUnary;
 
 //binary operator
-void Toy_emitASTNodeBinary(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode); //handled node becomes lhs
+void Toy_emitASTNodeBinary(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs, Toy_Opcode opcode); //handled node becomes lhs
 
 typedef struct Toy_NodeBinary {
 	Toy_ASTNodeType type;
@@ -67,7 +70,7 @@ typedef struct Toy_NodeBinary {
 } Toy_NodeBinary;
 
 //ternary operator
-void Toy_emitASTNodeTernary(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
+void Toy_emitASTNodeTernary(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
 
 typedef struct Toy_NodeTernary {
 	Toy_ASTNodeType type;
@@ -77,7 +80,7 @@ typedef struct Toy_NodeTernary {
 } Toy_NodeTernary;
 
 //grouping of other AST nodes
-void Toy_emitASTNodeGrouping(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeGrouping(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeGrouping {
 	Toy_ASTNodeType type;
@@ -85,7 +88,7 @@ typedef struct Toy_NodeGrouping {
 } Toy_NodeGrouping;
 
 //block of statement nodes
-void Toy_emitASTNodeBlock(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeBlock(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeBlock {
 	Toy_ASTNodeType type;
@@ -95,7 +98,7 @@ typedef struct Toy_NodeBlock {
 } Toy_NodeBlock;
 
 //compound literals (array, dictionary)
-void Toy_emitASTNodeCompound(Toy_ASTNode** nodeHandle, Toy_LiteralType literalType);
+void Toy_emitASTNodeCompound(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_LiteralType literalType);
 
 typedef struct Toy_NodeCompound {
 	Toy_ASTNodeType type;
@@ -113,7 +116,7 @@ typedef struct Toy_NodePair {
 	Toy_ASTNode* right;
 } Toy_NodePair;
 
-void Toy_emitASTNodeIndex(Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third);
+void Toy_emitASTNodeIndex(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* first, Toy_ASTNode* second, Toy_ASTNode* third);
 
 typedef struct Toy_NodeIndex {
 	Toy_ASTNodeType type;
@@ -123,7 +126,7 @@ typedef struct Toy_NodeIndex {
 } Toy_NodeIndex;
 
 //variable declaration
-void Toy_emitASTNodeVarDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal type, Toy_ASTNode* expression);
+void Toy_emitASTNodeVarDecl(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal type, Toy_ASTNode* expression);
 
 typedef struct Toy_NodeVarDecl {
 	Toy_ASTNodeType type;
@@ -133,7 +136,7 @@ typedef struct Toy_NodeVarDecl {
 } Toy_NodeVarDecl;
 
 //NOTE: fnCollection is used by fnDecl, fnCall and fnReturn
-void Toy_emitASTNodeFnCollection(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeFnCollection(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeFnCollection {
 	Toy_ASTNodeType type;
@@ -143,7 +146,7 @@ typedef struct Toy_NodeFnCollection {
 } Toy_NodeFnCollection;
 
 //function declaration
-void Toy_emitASTNodeFnDecl(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block);
+void Toy_emitASTNodeFnDecl(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_ASTNode* arguments, Toy_ASTNode* returns, Toy_ASTNode* block);
 
 typedef struct Toy_NodeFnDecl {
 	Toy_ASTNodeType type;
@@ -154,7 +157,7 @@ typedef struct Toy_NodeFnDecl {
 } Toy_NodeFnDecl;
 
 //function call
-void Toy_emitASTNodeFnCall(Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments);
+void Toy_emitASTNodeFnCall(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* arguments);
 
 typedef struct Toy_NodeFnCall {
 	Toy_ASTNodeType type;
@@ -163,7 +166,7 @@ typedef struct Toy_NodeFnCall {
 } Toy_NodeFnCall;
 
 //function return
-void Toy_emitASTNodeFnReturn(Toy_ASTNode** nodeHandle, Toy_ASTNode* returns);
+void Toy_emitASTNodeFnReturn(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* returns);
 
 typedef struct Toy_NodeFnReturn {
 	Toy_ASTNodeType type;
@@ -171,11 +174,11 @@ typedef struct Toy_NodeFnReturn {
 } Toy_NodeFnReturn;
 
 //control flow path - if-else, while, for, break, continue, return
-void Toy_emitASTNodeIf(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
-void Toy_emitASTNodeWhile(Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath);
-void Toy_emitASTNodeFor(Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath);
-void Toy_emitASTNodeBreak(Toy_ASTNode** nodeHandle);
-void Toy_emitASTNodeContinue(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeIf(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath, Toy_ASTNode* elsePath);
+void Toy_emitASTNodeWhile(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* condition, Toy_ASTNode* thenPath);
+void Toy_emitASTNodeFor(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* preClause, Toy_ASTNode* condition, Toy_ASTNode* postClause, Toy_ASTNode* thenPath);
+void Toy_emitASTNodeBreak(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodeContinue(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle);
 
 typedef struct Toy_NodeIf {
 	Toy_ASTNodeType type;
@@ -207,7 +210,7 @@ typedef struct Toy_NodeContinue {
 } Toy_NodeContinue;
 
 //and operator
-void Toy_emitASTNodeAnd(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs); //handled node becomes lhs
+void Toy_emitASTNodeAnd(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs); //handled node becomes lhs
 
 typedef struct Toy_NodeAnd {
 	Toy_ASTNodeType type;
@@ -216,7 +219,7 @@ typedef struct Toy_NodeAnd {
 } Toy_NodeAnd;
 
 //or operator
-void Toy_emitASTNodeOr(Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs); //handled node becomes lhs
+void Toy_emitASTNodeOr(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_ASTNode* rhs); //handled node becomes lhs
 
 typedef struct Toy_NodeOr {
 	Toy_ASTNodeType type;
@@ -225,10 +228,10 @@ typedef struct Toy_NodeOr {
 } Toy_NodeOr;
 
 //pre-post increment/decrement
-void Toy_emitASTNodePrefixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
-void Toy_emitASTNodePrefixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
-void Toy_emitASTNodePostfixIncrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
-void Toy_emitASTNodePostfixDecrement(Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePrefixIncrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePrefixDecrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePostfixIncrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
+void Toy_emitASTNodePostfixDecrement(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier);
 
 typedef struct Toy_NodePrefixIncrement {
 	Toy_ASTNodeType type;
@@ -251,7 +254,7 @@ typedef struct Toy_NodePostfixDecrement {
 } Toy_NodePostfixDecrement;
 
 //import a library
-void Toy_emitASTNodeImport(Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias);
+void Toy_emitASTNodeImport(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle, Toy_Literal identifier, Toy_Literal alias);
 
 typedef struct Toy_NodeImport {
 	Toy_ASTNodeType type;
@@ -260,7 +263,7 @@ typedef struct Toy_NodeImport {
 } Toy_NodeImport;
 
 //for doing nothing
-void Toy_emitASTNodePass(Toy_ASTNode** nodeHandle);
+void Toy_emitASTNodePass(Toy_ASTArena* arena, Toy_ASTNode** nodeHandle);
 
 union Toy_private_node {
 	Toy_ASTNodeType type;
@@ -294,3 +297,23 @@ union Toy_private_node {
 
 //see toy_parser.h for more documentation on this function
 TOY_API void Toy_freeASTNode(Toy_ASTNode* node);
+
+//arenas hold the nodes of a tree, so they can be released all at once - each parser has one
+typedef struct Toy_private_ast_chunk {
+	struct Toy_private_ast_chunk* next;
+	size_t capacity; //in bytes, following this header
+	size_t count;
+} Toy_private_ast_chunk;
+
+struct Toy_ASTArena {
+	Toy_private_ast_chunk* chunks; //the chunk being carved up is first
+};
+
+void Toy_initASTArena(Toy_ASTArena* arena);
+void Toy_clearASTArena(Toy_ASTArena* arena); //every node is released at once, but the current chunk is kept for reuse
+void Toy_freeASTArena(Toy_ASTArena* arena);
+
+//used in place of TOY_ALLOCATE, TOY_GROW_ARRAY and TOY_FREE_ARRAY for nodes, including the arrays of block, compound and fnCollection nodes
+Toy_ASTNode* Toy_private_allocateASTNodes(Toy_ASTArena* arena, int count);
+Toy_ASTNode* Toy_private_growASTNodes(Toy_ASTArena* arena, Toy_ASTNode* nodes, int oldCount, int count); //an existing array stays in its own arena
+void Toy_private_freeASTNodes(Toy_ASTNode* nodes, int count);
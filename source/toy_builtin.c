@@ -10,17 +10,8 @@
 static Toy_Literal addition(Toy_Interpreter* interpreter, Toy_Literal lhs, Toy_Literal rhs) {
 	//special case for string concatenation ONLY
 	if (TOY_IS_STRING(lhs) && TOY_IS_STRING(rhs)) {
-		//check for overflow
-		int totalLength = TOY_AS_STRING(lhs)->length + TOY_AS_STRING(rhs)->length;
-		if (totalLength > TOY_MAX_STRING_LENGTH) {
-			interpreter->errorOutput("Can't concatenate these strings (result is too long)\n");
-			return TOY_TO_NULL_LITERAL;
-		}
-
 		//concat the strings
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, TOY_MAX_STRING_LENGTH, "%s%s", Toy_toCString(TOY_AS_STRING(lhs)), Toy_toCString(TOY_AS_STRING(rhs)));
-		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, totalLength));
+		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_concatRefString(TOY_AS_STRING(lhs), TOY_AS_STRING(rhs)));
 
 		Toy_freeLiteral(lhs);
 		Toy_freeLiteral(rhs);
@@ -895,11 +886,7 @@ int Toy_private_index(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 			//simple indexing if second is null
 			if (TOY_IS_NULL(second)) {
 
-				const char* cstr = Toy_toCString(TOY_AS_STRING(compound));
-				char buf[16];
-
-				snprintf(buf, 16, "%s", &(cstr[ TOY_AS_INTEGER(first) ]) );
-				Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buf, 1));
+				Toy_Literal result = TOY_TO_STRING_LITERAL(Toy_sliceRefString(TOY_AS_STRING(compound), TOY_AS_INTEGER(first), 1));
 
 				Toy_pushLiteralArray(&interpreter->stack, result);
 
@@ -914,30 +901,39 @@ int Toy_private_index(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 				return 1;
 			}
 
-			//start building a new string from the old one
-			char* result = TOY_ALLOCATE(char, TOY_MAX_STRING_LENGTH);
-
-			//copy compound into result
-			int resultIndex = 0;
+			//a contiguous slice can share the original
+			if (TOY_AS_INTEGER(third) == 1) {
+				int resultLength = TOY_AS_INTEGER(second) - TOY_AS_INTEGER(first) + 1;
+				Toy_RefString* slice = Toy_sliceRefString(TOY_AS_STRING(compound), TOY_AS_INTEGER(first), resultLength > 0 ? resultLength : 0);
 
-			if (TOY_AS_INTEGER(third) > 0) {
-				for (int i = TOY_AS_INTEGER(first); i <= TOY_AS_INTEGER(second); i += TOY_AS_INTEGER(third)) {
-					result[ resultIndex++ ] = Toy_toCString(TOY_AS_STRING(compound))[ i ];
-				}
+				Toy_freeLiteral(compound);
+				compound = TOY_TO_STRING_LITERAL(slice);
 			}
 			else {
-				for (int i = TOY_AS_INTEGER(second); i >= TOY_AS_INTEGER(first); i += TOY_AS_INTEGER(third)) {
-					result[ resultIndex++ ] = Toy_toCString(TOY_AS_STRING(compound))[ i ];
-				}
-			}
+				//start building a new string from the old one
+				int resultCapacity = (int)Toy_lengthRefString(TOY_AS_STRING(compound)) + 1;
+				char* result = TOY_ALLOCATE(char, resultCapacity);
 
-			result[ resultIndex ] = '\0';
+				//copy compound into result
+				int resultIndex = 0;
 
-			//finally, swap out the compound for the result
-			Toy_freeLiteral(compound);
-			compound = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(result, resultIndex));
+				if (TOY_AS_INTEGER(third) > 0) {
+					for (int i = TOY_AS_INTEGER(first); i <= TOY_AS_INTEGER(second); i += TOY_AS_INTEGER(third)) {
+						result[ resultIndex++ ] = Toy_dataRefString(TOY_AS_STRING(compound))[ i ];
+					}
+				}
+				else {
+					for (int i = TOY_AS_INTEGER(second); i >= TOY_AS_INTEGER(first); i += TOY_AS_INTEGER(third)) {
+						result[ resultIndex++ ] = Toy_dataRefString(TOY_AS_STRING(compound))[ i ];
+					}
+				}
+
+				//finally, swap out the compound for the result
+				Toy_freeLiteral(compound);
+				compound = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(result, resultIndex));
 
-			TOY_FREE_ARRAY(char, result, TOY_MAX_STRING_LENGTH);
+				TOY_FREE_ARRAY(char, result, resultCapacity);
+			}
 
 			//leave the string on the stack
 			Toy_pushLiteralArray(&interpreter->stack, compound);
@@ -1047,50 +1043,53 @@ int Toy_private_index(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments)
 				return -1;
 			}
 
-			//start building a new string from the old one
-			char* result = TOY_ALLOCATE(char, TOY_MAX_STRING_LENGTH);
+			//start building a new string from the old one, with room for all of assign
+			int assignLength = TOY_AS_STRING(assign)->length;
+			int resultCapacity = compoundLength + assignLength + 1;
+			char* result = TOY_ALLOCATE(char, resultCapacity);
 
 			//if third is abs(1), simply insert into the correct positions
 			int resultIndex = 0;
 			if (TOY_AS_INTEGER(third) == 1 || TOY_AS_INTEGER(third) == -1) {
-				for (int i = 0; i < TOY_AS_INTEGER(first); i++) {
-					result[ resultIndex++ ] = Toy_toCString(TOY_AS_STRING(compound))[ i ];
-				}
+				memcpy(result, Toy_dataRefString(TOY_AS_STRING(compound)), TOY_AS_INTEGER(first));
+				resultIndex += TOY_AS_INTEGER(first);
 
-				int assignLength = TOY_AS_STRING(assign)->length;
-				int min = TOY_AS_INTEGER(third) > 0 ? 0 : assignLength - 1;
-
-				for (int i = min; i >= 0 && i < assignLength; i += TOY_AS_INTEGER(third)) {
-					result[ resultIndex++ ] = Toy_toCString(TOY_AS_STRING(assign))[ i ];
+				if (TOY_AS_INTEGER(third) > 0) {
+					memcpy(&result[ resultIndex ], Toy_dataRefString(TOY_AS_STRING(assign)), assignLength);
+					resultIndex += assignLength;
 				}
-
-				for (int i = TOY_AS_INTEGER(second) + 1; i < compoundLength; i++) {
-					result[ resultIndex++ ] = Toy_toCString(TOY_AS_STRING(compound))[ i ];
+				else {
+					for (int i = assignLength - 1; i >= 0; i--) {
+						result[ resultIndex++ ] = Toy_dataRefString(TOY_AS_STRING(assign))[ i ];
+					}
 				}
 
-				result[ resultIndex ] = '\0';
+				int tailLength = compoundLength - (TOY_AS_INTEGER(second) + 1);
+				if (tailLength > 0) {
+					memcpy(&result[ resultIndex ], &Toy_dataRefString(TOY_AS_STRING(compound))[ TOY_AS_INTEGER(second) + 1 ], tailLength);
+					resultIndex += tailLength;
+				}
 			}
 
 			//else override elements of the array instead
 			else {
 				//copy compound to result
-				snprintf(result, TOY_MAX_STRING_LENGTH, "%s", Toy_toCString(TOY_AS_STRING(compound)));
+				memcpy(result, Toy_dataRefString(TOY_AS_STRING(compound)), compoundLength);
 
-				int assignLength = TOY_AS_STRING(assign)->length;
 				int min = TOY_AS_INTEGER(third) > 0 ? TOY_AS_INTEGER(first) : TOY_AS_INTEGER(second) - 1;
 
 				int assignIndex = 0;
 				for (int i = min; i >= TOY_AS_INTEGER(first) && i <= TOY_AS_INTEGER(second) && assignIndex < assignLength; i += TOY_AS_INTEGER(third)) {
-					result[ i ] = Toy_toCString(TOY_AS_STRING(assign))[ assignIndex++ ];
+					result[ i ] = Toy_dataRefString(TOY_AS_STRING(assign))[ assignIndex++ ];
 				}
-				resultIndex = strlen(result);
+				resultIndex = compoundLength;
 			}
 
 			//finally, swap out the compound for the result
 			Toy_freeLiteral(compound);
 			compound = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(result, resultIndex));
 
-			TOY_FREE_ARRAY(char, result, TOY_MAX_STRING_LENGTH);
+			TOY_FREE_ARRAY(char, result, resultCapacity);
 
 			//leave the string on the stack
 			Toy_pushLiteralArray(&interpreter->stack, compound);
@@ -1201,8 +1200,7 @@ int Toy_private_set(Toy_Interpreter* interpreter, Toy_LiteralArray* arguments) {
 			}
 
 			//don't use pushLiteralArray, since we're setting
-			Toy_freeLiteral(TOY_AS_ARRAY(obj)->literals[TOY_AS_INTEGER(key)]); //BUGFIX: clear any existing data first
-			TOY_AS_ARRAY(obj)->literals[TOY_AS_INTEGER(key)] = Toy_copyLiteral(val);
+			Toy_setLiteralArray(TOY_AS_ARRAY(obj), key, val);
 
 			if (!Toy_setScopeVariable(interpreter->scope, idn, obj, true)) {
 				interpreter->errorOutput("Incorrect type assigned to array in set: \"");
@@ -32,9 +32,11 @@ Toy_CommandLine Toy_commandLine = {
 	.outfile = "out.tb",
 	.source = NULL,
 	.initialfile = NULL,
+	.cachedirectory = NULL,
 	.enablePrintNewline = true,
 	.parseBytecodeHeader = false,
-	.verbose = false
+	.verbose = false,
+	.optimize = false
 };
 
 void Toy_initCommandLine(int argc, const char* argv[]) {
@@ -94,6 +96,13 @@ void Toy_initCommandLine(int argc, const char* argv[]) {
 			continue;
 		}
 
+		if ((!strcmp(argv[i], "-x") || !strcmp(argv[i], "--cache")) && i + 1 < argc) {
+			Toy_commandLine.cachedirectory = (char*)argv[i + 1];
+			i++;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
 		if (!strcmp(argv[i], "-p")) {
 			Toy_commandLine.parseBytecodeHeader = true;
 
@@ -104,6 +113,12 @@ void Toy_initCommandLine(int argc, const char* argv[]) {
 			continue;
 		}
 
+		if (!strcmp(argv[i], "-O") || !strcmp(argv[i], "--optimize")) {
+			Toy_commandLine.optimize = true;
+			Toy_commandLine.error = false;
+			continue;
+		}
+
 		if (!strcmp(argv[i], "-n")) {
 			Toy_commandLine.enablePrintNewline = false;
 			Toy_commandLine.error = false;
@@ -139,7 +154,9 @@ void Toy_helpCommandLine(int argc, const char* argv[]) {
 	printf("  -c, --compile filename\tParse and compile the specified source file into an output file.\n");
 	printf("  -o, --output outfile\t\tName of the output file built with --compile (default: out.tb).\n");
 	printf("  -t, --initial filename\tStart the repl as normal, after first running the given file.\n");
+	printf("  -x, --cache directory\t\tReuse compiled source files from this directory, compiling them only when changed.\n");
 	printf("  -p\t\t\t\tParse the given bytecode's header, then exit (requires file.tb).\n");
+	printf("  -O, --optimize\t\tOptimize the bytecode as it is compiled.\n");
 	printf("  -n\t\t\t\tDisable the newline character at the end of the print statement.\n");
 }
 
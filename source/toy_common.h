@@ -54,7 +54,7 @@ The current minor version of Toy. This value is embedded into the bytecode, and
 This value MUST fit into an unsigned char.
 !*/
 
-#define TOY_VERSION_MINOR 3
+#define TOY_VERSION_MINOR 4
 
 /*!
 ### TOY_VERSION_PATCH
@@ -94,9 +94,11 @@ typedef struct {
 	char* outfile; //defaults to out.tb
 	char* source;
 	char* initialfile;
+	char* cachedirectory;
 	bool enablePrintNewline;
 	bool parseBytecodeHeader;
 	bool verbose;
+	bool optimize;
 } Toy_CommandLine;
 
 //these are intended for the repl only, despite using the api prefix
@@ -11,16 +11,382 @@
 #include <stdio.h>
 #include <string.h>
 
+//local variable tracking
+static void pushCompilerScope(Toy_Compiler* compiler, bool hasSlots) {
+	if (compiler->scopeCount + 1 > compiler->scopeCapacity) {
+		int oldCapacity = compiler->scopeCapacity;
+
+		compiler->scopeCapacity = TOY_GROW_CAPACITY(oldCapacity);
+		compiler->scopes = TOY_GROW_ARRAY(Toy_private_compiler_scope, compiler->scopes, oldCapacity, compiler->scopeCapacity);
+	}
+
+	Toy_private_compiler_scope* scope = &compiler->scopes[compiler->scopeCount++];
+	scope->locals = NULL;
+	scope->capacity = 0;
+	scope->count = 0;
+	scope->slotCount = 0;
+	scope->hasSlots = hasSlots;
+	scope->opaque = false;
+}
+
+static void popCompilerScope(Toy_Compiler* compiler) {
+	Toy_private_compiler_scope* scope = &compiler->scopes[--compiler->scopeCount];
+
+	for (int i = 0; i < scope->count; i++) {
+		Toy_freeLiteral(scope->locals[i].identifier);
+	}
+
+	TOY_FREE_ARRAY(Toy_private_compiler_local, scope->locals, scope->capacity);
+}
+
+static Toy_private_compiler_local* findCompilerLocal(Toy_private_compiler_scope* scope, Toy_Literal identifier) {
+	for (int i = 0; i < scope->count; i++) {
+		if (Toy_literalsAreEqual(scope->locals[i].identifier, identifier)) {
+			return &scope->locals[i];
+		}
+	}
+
+	return NULL;
+}
+
+//add a local to the innermost scope, giving it a slot if possible
+static Toy_private_compiler_local* addCompilerLocal(Toy_Compiler* compiler, Toy_Literal identifier, bool slotted) {
+	Toy_private_compiler_scope* scope = &compiler->scopes[compiler->scopeCount - 1];
+
+	//the global scope is never resolved, so don't bother searching it for duplicates
+	Toy_private_compiler_local* local = scope->hasSlots ? findCompilerLocal(scope, identifier) : NULL;
+	if (local != NULL) {
+		return local;
+	}
+
+	if (scope->count + 1 > scope->capacity) {
+		int oldCapacity = scope->capacity;
+
+		scope->capacity = TOY_GROW_CAPACITY(oldCapacity);
+		scope->locals = TOY_GROW_ARRAY(Toy_private_compiler_local, scope->locals, oldCapacity, scope->capacity);
+	}
+
+	local = &scope->locals[scope->count++];
+	local->identifier = Toy_copyLiteral(identifier);
+	local->slot = (slotted && scope->hasSlots && scope->slotCount < 256) ? scope->slotCount++ : -1;
+	local->declared = false;
+
+	return local;
+}
+
+static void declareCompilerLocal(Toy_Compiler* compiler, Toy_Literal identifier) {
+	addCompilerLocal(compiler, identifier, false)->declared = true;
+}
+
+//find the slot of a local variable, if it has one
+static bool resolveCompilerLocal(Toy_Compiler* compiler, Toy_Literal identifier, int* depth, int* slot) {
+	for (int i = compiler->scopeCount - 1; i >= 0; i--) {
+		//nothing in the global scope has a slot
+		if (!compiler->scopes[i].hasSlots) {
+			return false;
+		}
+
+		Toy_private_compiler_local* local = findCompilerLocal(&compiler->scopes[i], identifier);
+
+		if (local != NULL && local->declared) {
+			*depth = compiler->scopeCount - 1 - i;
+			*slot = local->slot;
+			return local->slot >= 0 && *depth < 256;
+		}
+
+		//anything could be declared here
+		if (compiler->scopes[i].opaque) {
+			return false;
+		}
+	}
+
+	return false;
+}
+
+//find the variables declared directly within this statement, without entering any new scopes
+static void collectCompilerLocals(Toy_Compiler* compiler, Toy_ASTNode* node) {
+	if (node == NULL) {
+		return;
+	}
+
+	switch(node->type) {
+		case TOY_AST_NODE_VAR_DECL:
+			addCompilerLocal(compiler, node->varDecl.identifier, true);
+			break;
+
+		case TOY_AST_NODE_IF:
+			collectCompilerLocals(compiler, node->pathIf.thenPath);
+			collectCompilerLocals(compiler, node->pathIf.elsePath);
+			break;
+
+		case TOY_AST_NODE_WHILE:
+			collectCompilerLocals(compiler, node->pathWhile.thenPath);
+			break;
+
+		default:
+			break;
+	}
+}
+
+//literal cache deduplication
+static unsigned int hashCompilerLiteral(Toy_Literal literal) {
+	switch(literal.type) {
+		case TOY_LITERAL_FLOAT:
+			//0.0 and -0.0 are equal, so they need the same hash
+			return TOY_AS_FLOAT(literal) == 0 ? 0 : (unsigned int)Toy_hashLiteral(literal);
+
+		case TOY_LITERAL_TYPE: {
+			unsigned int hash = (unsigned int)TOY_AS_TYPE(literal).typeOf * 31 + (TOY_AS_TYPE(literal).constant ? 1 : 0);
+
+			if (TOY_AS_TYPE(literal).typeOf == TOY_LITERAL_ARRAY || TOY_AS_TYPE(literal).typeOf == TOY_LITERAL_DICTIONARY) {
+				for (int i = 0; i < TOY_AS_TYPE(literal).count; i++) {
+					hash = hash * 31 + hashCompilerLiteral(((Toy_Literal*)(TOY_AS_TYPE(literal).subtypes))[i]);
+				}
+			}
+
+			return hash;
+		}
+
+		//these are all stored as arrays, and compared in order
+		case TOY_LITERAL_ARRAY:
+		case TOY_LITERAL_ARRAY_INTERMEDIATE:
+		case TOY_LITERAL_DICTIONARY_INTERMEDIATE:
+		case TOY_LITERAL_TYPE_INTERMEDIATE: {
+			unsigned int hash = (unsigned int)literal.type;
+
+			for (int i = 0; i < TOY_AS_ARRAY(literal)->count; i++) {
+				hash = hash * 31 + hashCompilerLiteral(TOY_AS_ARRAY(literal)->literals[i]);
+			}
+
+			return hash;
+		}
+
+		//never equal to anything, but still cached
+		case TOY_LITERAL_INDEX_BLANK:
+			return (unsigned int)literal.type;
+
+		default:
+			return (unsigned int)Toy_hashLiteral(literal);
+	}
+}
+
+//the string hashes leave the low bits clumped together, and only the low bits pick a bucket
+static unsigned int mixCompilerHash(unsigned int hash) {
+	hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+	hash = ((hash >> 16) ^ hash) * 0x45d9f3b;
+	return (hash >> 16) ^ hash;
+}
+
+static bool isIndexableCompilerLiteral(Toy_Literal literal) {
+	//functions are never equal, so there's no point indexing them
+	switch(literal.type) {
+		case TOY_LITERAL_FUNCTION:
+		case TOY_LITERAL_FUNCTION_NATIVE:
+		case TOY_LITERAL_FUNCTION_HOOK:
+		case TOY_LITERAL_FUNCTION_INTERMEDIATE:
+			return false;
+
+		default:
+			return true;
+	}
+}
+
+//returns the entry for this literal, or the empty entry where it belongs
+static Toy_private_compiler_literal_entry* probeCompilerLiteral(Toy_Compiler* compiler, Toy_Literal literal, unsigned int hash) {
+	unsigned int mask = (unsigned int)compiler->literalIndexCapacity - 1;
+
+	for (unsigned int i = hash & mask; ; i = (i + 1) & mask) {
+		Toy_private_compiler_literal_entry* entry = &compiler->literalIndex[i];
+
+		if (entry->index < 0) {
+			return entry;
+		}
+
+		Toy_Literal existing = compiler->literalCache.literals[entry->index];
+		if (entry->hash == hash && existing.type == literal.type && Toy_literalsAreEqual(existing, literal)) {
+			return entry;
+		}
+	}
+}
+
+static void growCompilerLiteralIndex(Toy_Compiler* compiler) {
+	int oldCapacity = compiler->literalIndexCapacity;
+	Toy_private_compiler_literal_entry* oldIndex = compiler->literalIndex;
+
+	compiler->literalIndexCapacity = oldCapacity < 64 ? 64 : oldCapacity * 2; //always a power of 2
+	compiler->literalIndex = TOY_ALLOCATE(Toy_private_compiler_literal_entry, compiler->literalIndexCapacity);
+
+	for (int i = 0; i < compiler->literalIndexCapacity; i++) {
+		compiler->literalIndex[i].index = -1;
+	}
+
+	//the cached hashes are reused, since the literals haven't changed
+	unsigned int mask = (unsigned int)compiler->literalIndexCapacity - 1;
+	for (int i = 0; i < oldCapacity; i++) {
+		if (oldIndex[i].index < 0) {
+			continue;
+		}
+
+		unsigned int slot = oldIndex[i].hash & mask;
+		while (compiler->literalIndex[slot].index >= 0) {
+			slot = (slot + 1) & mask;
+		}
+		compiler->literalIndex[slot] = oldIndex[i];
+	}
+
+	TOY_FREE_ARRAY(Toy_private_compiler_literal_entry, oldIndex, oldCapacity);
+}
+
+//returns -1 if this literal isn't in the cache, otherwise the index of its first occurance
+static int findCompilerLiteral(Toy_Compiler* compiler, Toy_Literal literal) {
+	if (compiler->literalIndexCount == 0 || !isIndexableCompilerLiteral(literal)) {
+		return -1;
+	}
+
+	return probeCompilerLiteral(compiler, literal, mixCompilerHash(hashCompilerLiteral(literal)))->index;
+}
+
+//push the literal to the cache, even if it's already there
+static int pushCompilerLiteral(Toy_Compiler* compiler, Toy_Literal literal) {
+	int index = Toy_pushLiteralArray(&compiler->literalCache, literal);
+
+	if (!isIndexableCompilerLiteral(literal)) {
+		return index;
+	}
+
+	//keep the load factor below 3/4
+	if ((compiler->literalIndexCount + 1) * 4 > compiler->literalIndexCapacity * 3) {
+		growCompilerLiteralIndex(compiler);
+	}
+
+	//only the first occurance is indexed, matching what a scan would find
+	unsigned int hash = mixCompilerHash(hashCompilerLiteral(literal));
+	Toy_private_compiler_literal_entry* entry = probeCompilerLiteral(compiler, literal, hash);
+
+	if (entry->index < 0) {
+		entry->hash = hash;
+		entry->index = index;
+		compiler->literalIndexCount++;
+	}
+
+	return index;
+}
+
+//push the literal to the cache, only if it isn't already there
+static int addCompilerLiteral(Toy_Compiler* compiler, Toy_Literal literal) {
+	int index = findCompilerLiteral(compiler, literal);
+
+	if (index < 0) {
+		index = pushCompilerLiteral(compiler, literal);
+	}
+
+	return index;
+}
+
+static void growCompilerBytecode(Toy_Compiler* compiler, int amount) {
+	while (compiler->count + amount > compiler->capacity) {
+		int oldCapacity = compiler->capacity;
+
+		compiler->capacity = TOY_GROW_CAPACITY_FAST(oldCapacity);
+		compiler->bytecode = TOY_GROW_ARRAY(unsigned char, compiler->bytecode, oldCapacity, compiler->capacity);
+	}
+}
+
+//literal indexes that don't fit into 16 bits are marked as wide, and followed by all 32 bits
+static void writeCompilerIndex(Toy_Compiler* compiler, int index) {
+	growCompilerBytecode(compiler, sizeof(unsigned short) + sizeof(int));
+
+	unsigned short shortIndex = index < TOY_OPERAND_WIDE ? (unsigned short)index : TOY_OPERAND_WIDE;
+	memcpy(compiler->bytecode + compiler->count, &shortIndex, sizeof(unsigned short)); //2 bytes
+	compiler->count += sizeof(unsigned short);
+
+	if (shortIndex == TOY_OPERAND_WIDE) {
+		memcpy(compiler->bytecode + compiler->count, &index, sizeof(int)); //4 bytes
+		compiler->count += sizeof(int);
+	}
+}
+
+//write a jump opcode, leaving space for the target, and return where the target goes
+static int writeCompilerJump(Toy_Compiler* compiler, Toy_Opcode opcode) {
+	if (compiler->jumpCount + 1 > compiler->jumpCapacity) {
+		int oldCapacity = compiler->jumpCapacity;
+
+		compiler->jumpCapacity = TOY_GROW_CAPACITY(oldCapacity);
+		compiler->jumps = TOY_GROW_ARRAY(Toy_private_compiler_jump, compiler->jumps, oldCapacity, compiler->jumpCapacity);
+	}
+
+	growCompilerBytecode(compiler, 1 + sizeof(unsigned short));
+	compiler->bytecode[compiler->count++] = (unsigned char)opcode; //1 byte
+
+	Toy_private_compiler_jump* jump = &compiler->jumps[compiler->jumpCount++];
+	jump->site = compiler->count;
+	jump->target = 0;
+
+	compiler->count += sizeof(unsigned short); //2 bytes
+	return jump->site;
+}
+
+static Toy_private_compiler_jump* findCompilerJump(Toy_Compiler* compiler, int site) {
+	//the jumps are sorted by site
+	int low = 0;
+	int high = compiler->jumpCount - 1;
+
+	while (low <= high) {
+		int mid = low + (high - low) / 2;
+
+		if (compiler->jumps[mid].site < site) {
+			low = mid + 1;
+		}
+		else if (compiler->jumps[mid].site > site) {
+			high = mid - 1;
+		}
+		else {
+			return &compiler->jumps[mid];
+		}
+	}
+
+	return NULL;
+}
+
+static void patchCompilerJump(Toy_Compiler* compiler, int site, int target) {
+	Toy_private_compiler_jump* jump = findCompilerJump(compiler, site);
+
+	if (jump != NULL) {
+		jump->target = target;
+	}
+
+	//this is only kept if the jumps don't need widening
+	unsigned short shortTarget = (unsigned short)target;
+	memcpy(compiler->bytecode + site, &shortTarget, sizeof(unsigned short)); //2 bytes
+}
+
 void Toy_initCompiler(Toy_Compiler* compiler) {
 	Toy_initLiteralArray(&compiler->literalCache);
+	compiler->literalIndex = NULL;
+	compiler->literalIndexCapacity = 0;
+	compiler->literalIndexCount = 0;
 	compiler->bytecode = NULL;
 	compiler->capacity = 0;
 	compiler->count = 0;
+	compiler->codeStart = 0;
 	compiler->panic = false;
+
+	compiler->jumps = NULL;
+	compiler->jumpCapacity = 0;
+	compiler->jumpCount = 0;
+
+	compiler->scopes = NULL;
+	compiler->scopeCapacity = 0;
+	compiler->scopeCount = 0;
+	compiler->breakScopeCount = 0;
+	compiler->continueScopeCount = 0;
+
+	//the global scope, which is never slotted
+	pushCompilerScope(compiler, false);
 }
 
 //separated out, so it can be recursive
-static int writeLiteralTypeToCache(Toy_LiteralArray* literalCache, Toy_Literal literal) {
+static int writeLiteralTypeToCache(Toy_Compiler* compiler, Toy_Literal literal) {
 	bool shouldFree = false;
 
 	//if it's a compound type, recurse and store the results
@@ -34,7 +400,7 @@ static int writeLiteralTypeToCache(Toy_LiteralArray* literalCache, Toy_Literal l
 
 		for (int i = 0; i < TOY_AS_TYPE(literal).count; i++) {
 			//write the values to the cache, and the indexes to the store
-			int subIndex = writeLiteralTypeToCache(literalCache, ((Toy_Literal*)(TOY_AS_TYPE(literal).subtypes))[i]);
+			int subIndex = writeLiteralTypeToCache(compiler, ((Toy_Literal*)(TOY_AS_TYPE(literal).subtypes))[i]);
 
 			Toy_Literal lit = TOY_TO_INTEGER_LITERAL(subIndex);
 			Toy_pushLiteralArray(store, lit);
@@ -48,10 +414,7 @@ static int writeLiteralTypeToCache(Toy_LiteralArray* literalCache, Toy_Literal l
 	}
 
 	//optimisation: check if exactly this literal array exists
-	int index = Toy_private_findLiteralIndex(literalCache, literal);
-	if (index < 0) {
-		index = Toy_pushLiteralArray(literalCache, literal);
-	}
+	int index = addCompilerLiteral(compiler, literal);
 
 	if (shouldFree) {
 		Toy_freeLiteral(literal);
@@ -74,10 +437,7 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 			switch(node->compound.nodes[i].pair.left->type) {
 				case TOY_AST_NODE_LITERAL: {
 					//keys are literals
-					int key = Toy_private_findLiteralIndex(&compiler->literalCache, node->compound.nodes[i].pair.left->atomic.literal);
-					if (key < 0) {
-						key = Toy_pushLiteralArray(&compiler->literalCache, node->compound.nodes[i].pair.left->atomic.literal);
-					}
+					int key = addCompilerLiteral(compiler, node->compound.nodes[i].pair.left->atomic.literal);
 
 					Toy_Literal literal =  TOY_TO_INTEGER_LITERAL(key);
 					Toy_pushLiteralArray(store, literal);
@@ -103,10 +463,7 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 			switch(node->compound.nodes[i].pair.right->type) {
 				case TOY_AST_NODE_LITERAL: {
 					//values are literals
-					int val = Toy_private_findLiteralIndex(&compiler->literalCache, node->compound.nodes[i].pair.right->atomic.literal);
-					if (val < 0) {
-						val = Toy_pushLiteralArray(&compiler->literalCache, node->compound.nodes[i].pair.right->atomic.literal);
-					}
+					int val = addCompilerLiteral(compiler, node->compound.nodes[i].pair.right->atomic.literal);
 
 					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
 					Toy_pushLiteralArray(store, literal);
@@ -132,7 +489,7 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 		//push the store to the cache, with instructions about how pack it
 		Toy_Literal literal = TOY_TO_DICTIONARY_LITERAL((Toy_LiteralDictionary*)store); //cast from array to dict, because it's intermediate
 		literal.type = TOY_LITERAL_DICTIONARY_INTERMEDIATE; //god damn it - nested in a dictionary
-		index = Toy_pushLiteralArray(&compiler->literalCache, literal);
+		index = pushCompilerLiteral(compiler, literal);
 		Toy_freeLiteral(literal);
 	}
 
@@ -142,10 +499,7 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 			switch(node->compound.nodes[i].type) {
 				case TOY_AST_NODE_LITERAL: {
 					//values
-					int val = Toy_private_findLiteralIndex(&compiler->literalCache, node->compound.nodes[i].atomic.literal);
-					if (val < 0) {
-						val = Toy_pushLiteralArray(&compiler->literalCache, node->compound.nodes[i].atomic.literal);
-					}
+					int val = addCompilerLiteral(compiler, node->compound.nodes[i].atomic.literal);
 
 					Toy_Literal literal = TOY_TO_INTEGER_LITERAL(val);
 					Toy_pushLiteralArray(store, literal);
@@ -171,7 +525,7 @@ static int writeNodeCompoundToCache(Toy_Compiler* compiler, Toy_ASTNode* node) {
 		//push the store to the cache, with instructions about how pack it
 		Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
 		literal.type = TOY_LITERAL_ARRAY_INTERMEDIATE; //god damn it - nested in an array
-		index = Toy_pushLiteralArray(&compiler->literalCache, literal);
+		index = pushCompilerLiteral(compiler, literal);
 		Toy_freeLiteral(literal);
 	}
 	else {
@@ -191,8 +545,8 @@ static int writeNodeCollectionToCache(Toy_Compiler* compiler, Toy_ASTNode* node)
 		switch(node->fnCollection.nodes[i].type) {
 			case TOY_AST_NODE_VAR_DECL: {
 				//write each piece of the declaration to the cache
-				int identifierIndex = Toy_pushLiteralArray(&compiler->literalCache, node->fnCollection.nodes[i].varDecl.identifier); //store without duplication optimisation
-				int typeIndex = writeLiteralTypeToCache(&compiler->literalCache, node->fnCollection.nodes[i].varDecl.typeLiteral);
+				int identifierIndex = pushCompilerLiteral(compiler, node->fnCollection.nodes[i].varDecl.identifier); //store without duplication optimisation
+				int typeIndex = writeLiteralTypeToCache(compiler, node->fnCollection.nodes[i].varDecl.typeLiteral);
 
 				Toy_Literal identifierLiteral =  TOY_TO_INTEGER_LITERAL(identifierIndex);
 				Toy_pushLiteralArray(store, identifierLiteral);
@@ -206,7 +560,7 @@ static int writeNodeCollectionToCache(Toy_Compiler* compiler, Toy_ASTNode* node)
 
 			case TOY_AST_NODE_LITERAL: {
 				//write each piece of the declaration to the cache
-				int typeIndex = writeLiteralTypeToCache(&compiler->literalCache, node->fnCollection.nodes[i].atomic.literal);
+				int typeIndex = writeLiteralTypeToCache(compiler, node->fnCollection.nodes[i].atomic.literal);
 
 				Toy_Literal typeLiteral = TOY_TO_INTEGER_LITERAL(typeIndex);
 				Toy_pushLiteralArray(store, typeLiteral);
@@ -222,7 +576,7 @@ static int writeNodeCollectionToCache(Toy_Compiler* compiler, Toy_ASTNode* node)
 
 	//store the store
 	Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
-	int storeIndex = Toy_pushLiteralArray(&compiler->literalCache, literal);
+	int storeIndex = pushCompilerLiteral(compiler, literal);
 	Toy_freeLiteral(literal);
 
 	return storeIndex;
@@ -230,15 +584,15 @@ static int writeNodeCollectionToCache(Toy_Compiler* compiler, Toy_ASTNode* node)
 
 static int writeLiteralToCompiler(Toy_Compiler* compiler, Toy_Literal literal) {
 	//get the index
-	int index = Toy_private_findLiteralIndex(&compiler->literalCache, literal);
+	int index = findCompilerLiteral(compiler, literal);
 
 	if (index < 0) {
 		if (TOY_IS_TYPE(literal)) {
 			//check for the type literal as value
-			index = writeLiteralTypeToCache(&compiler->literalCache, literal);
+			index = writeLiteralTypeToCache(compiler, literal);
 		}
 		else {
-			index = Toy_pushLiteralArray(&compiler->literalCache, literal);
+			index = pushCompilerLiteral(compiler, literal);
 		}
 	}
 
@@ -246,9 +600,7 @@ static int writeLiteralToCompiler(Toy_Compiler* compiler, Toy_Literal literal) {
 	if (index >= 256) {
 		//push a "long" index
 		compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
-		memcpy(compiler->bytecode + compiler->count, &index, sizeof(unsigned short)); //2 bytes
-
-		compiler->count += sizeof(unsigned short);
+		writeCompilerIndex(compiler, index); //2 or 6 bytes
 	}
 	else {
 		//push the index
@@ -340,16 +692,122 @@ bool checkNodeInTree(Toy_ASTNode* tree, Toy_ASTNode* node) {
 	return false;
 }
 
+//give the innermost scope its slots at runtime, if it has any
+static void writeScopeSlots(Toy_Compiler* compiler) {
+	Toy_private_compiler_scope* scope = &compiler->scopes[compiler->scopeCount - 1];
+
+	if (scope->slotCount == 0) {
+		return;
+	}
+
+	//the slot names are stored as an array of identifier indexes, and again as a dictionary from each identifier to its slot
+	Toy_LiteralArray* store = TOY_ALLOCATE(Toy_LiteralArray, 1);
+	Toy_initLiteralArray(store);
+
+	Toy_LiteralArray* lookup = TOY_ALLOCATE(Toy_LiteralArray, 1);
+	Toy_initLiteralArray(lookup);
+
+	for (int i = 0; i < scope->count; i++) {
+		if (scope->locals[i].slot < 0) {
+			continue;
+		}
+
+		int identifierIndex = addCompilerLiteral(compiler, scope->locals[i].identifier);
+
+		Toy_Literal literal = TOY_TO_INTEGER_LITERAL(identifierIndex);
+		Toy_pushLiteralArray(store, literal);
+		Toy_pushLiteralArray(lookup, literal);
+		Toy_freeLiteral(literal);
+
+		Toy_Literal slot = TOY_TO_INTEGER_LITERAL(scope->locals[i].slot);
+		literal = TOY_TO_INTEGER_LITERAL(addCompilerLiteral(compiler, slot));
+		Toy_pushLiteralArray(lookup, literal);
+		Toy_freeLiteral(literal);
+	}
+
+	Toy_Literal literal = TOY_TO_ARRAY_LITERAL(store);
+	int index = addCompilerLiteral(compiler, literal);
+	Toy_freeLiteral(literal);
+
+	literal = TOY_TO_DICTIONARY_LITERAL((Toy_LiteralDictionary*)lookup); //cast from array to dict, because it's intermediate
+	literal.type = TOY_LITERAL_DICTIONARY_INTERMEDIATE;
+	int lookupIndex = pushCompilerLiteral(compiler, literal);
+	Toy_freeLiteral(literal);
+
+	compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_SLOTS; //1 byte
+	writeCompilerIndex(compiler, index); //2 or 6 bytes
+	writeCompilerIndex(compiler, lookupIndex); //2 or 6 bytes
+}
+
+//push a new scope, setting aside slots for the variables declared directly within these statements
+static void writeScopeBegin(Toy_Compiler* compiler, Toy_ASTNode* nodes, int count) {
+	compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SCOPE_BEGIN; //1 byte
+
+	pushCompilerScope(compiler, true);
+
+	for (int i = 0; i < count; i++) {
+		collectCompilerLocals(compiler, &nodes[i]);
+	}
+
+	writeScopeSlots(compiler);
+}
+
+static void writeScopeEnd(Toy_Compiler* compiler) {
+	compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SCOPE_END; //1 byte
+
+	popCompilerScope(compiler);
+}
+
+static void writeSlotOpcode(Toy_Compiler* compiler, Toy_Opcode opcode, int depth, int slot) {
+	growCompilerBytecode(compiler, 3);
+
+	compiler->bytecode[compiler->count++] = (unsigned char)opcode; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)depth; //1 byte
+	compiler->bytecode[compiler->count++] = (unsigned char)slot; //1 byte
+}
+
+//if this node is a local variable with a slot, push its value directly
+static bool writeSlotLoad(Toy_Compiler* compiler, Toy_ASTNode* node) {
+	int depth, slot;
+
+	if (node == NULL || node->type != TOY_AST_NODE_LITERAL || !TOY_IS_IDENTIFIER(node->atomic.literal) || !resolveCompilerLocal(compiler, node->atomic.literal, &depth, &slot)) {
+		return false;
+	}
+
+	writeSlotOpcode(compiler, TOY_OP_SLOT_LOAD, depth, slot);
+	return true;
+}
+
+//increments and decrements of local variables with slots
+static bool writeSlotIncrement(Toy_Compiler* compiler, Toy_Literal identifier, Toy_Opcode opcode, bool prefix) {
+	int depth, slot;
+
+	if (!resolveCompilerLocal(compiler, identifier, &depth, &slot)) {
+		return false;
+	}
+
+	//the result is left on the stack
+	if (!prefix) {
+		writeSlotOpcode(compiler, TOY_OP_SLOT_LOAD, depth, slot);
+	}
+
+	writeSlotOpcode(compiler, TOY_OP_SLOT_LOAD, depth, slot);
+	writeLiteralToCompiler(compiler, TOY_TO_INTEGER_LITERAL(1));
+	compiler->bytecode[compiler->count++] = (unsigned char)opcode; //1 byte
+	writeSlotOpcode(compiler, TOY_OP_SLOT_STORE, depth, slot);
+
+	if (prefix) {
+		writeSlotOpcode(compiler, TOY_OP_SLOT_LOAD, depth, slot);
+	}
+
+	return true;
+}
+
 //NOTE: jumpOfsets are included, because function arg and return indexes are embedded in the code body i.e. need to include their sizes in the jump
 //NOTE: rootNode should NOT include groupings and blocks
 static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode* node, void* breakAddressesPtr, void* continueAddressesPtr, int jumpOffsets, Toy_ASTNode* rootNode) {
 	//grow if the bytecode space is too small
-	if (compiler->count + 32 > compiler->capacity) {
-		int oldCapacity = compiler->capacity;
-
-		compiler->capacity = TOY_GROW_CAPACITY_FAST(oldCapacity);
-		compiler->bytecode = TOY_GROW_ARRAY(unsigned char, compiler->bytecode, oldCapacity, compiler->capacity);
-	}
+	growCompilerBytecode(compiler, 32);
 
 	//determine node type
 	switch(node->type) {
@@ -366,7 +824,8 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 		case TOY_AST_NODE_UNARY: {
 			//pass to the child node, then embed the unary command (print, negate, etc.)
-			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->unary.child, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			bool readsOperand = node->unary.opcode == TOY_OP_PRINT || node->unary.opcode == TOY_OP_NEGATE || node->unary.opcode == TOY_OP_INVERT;
+			Toy_Opcode override = (readsOperand && writeSlotLoad(compiler, node->unary.child)) ? TOY_OP_EOF : Toy_writeCompilerWithJumps(compiler, node->unary.child, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 
 			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
@@ -378,8 +837,55 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 		//all infixes come here
 		case TOY_AST_NODE_BINARY: {
+			//assigning to a local variable with a slot doesn't need the identifier on the stack
+			int depth, slot;
+			if (node->binary.opcode >= TOY_OP_VAR_ASSIGN && node->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN && node->binary.left->type == TOY_AST_NODE_LITERAL && TOY_IS_IDENTIFIER(node->binary.left->atomic.literal) && resolveCompilerLocal(compiler, node->binary.left->atomic.literal, &depth, &slot)) {
+				if (node->binary.opcode != TOY_OP_VAR_ASSIGN) {
+					writeSlotOpcode(compiler, TOY_OP_SLOT_LOAD, depth, slot);
+				}
+
+				if (!writeSlotLoad(compiler, node->binary.right)) {
+					Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+					if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
+						compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
+					}
+				}
+
+				//compound assignments become plain arithmetic
+				switch(node->binary.opcode) {
+					case TOY_OP_VAR_ADDITION_ASSIGN:
+						compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_ADDITION; //1 byte
+						break;
+
+					case TOY_OP_VAR_SUBTRACTION_ASSIGN:
+						compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SUBTRACTION; //1 byte
+						break;
+
+					case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
+						compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_MULTIPLICATION; //1 byte
+						break;
+
+					case TOY_OP_VAR_DIVISION_ASSIGN:
+						compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_DIVISION; //1 byte
+						break;
+
+					case TOY_OP_VAR_MODULO_ASSIGN:
+						compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_MODULO; //1 byte
+						break;
+
+					default:
+						break;
+				}
+
+				writeSlotOpcode(compiler, TOY_OP_SLOT_STORE, depth, slot);
+				return TOY_OP_EOF;
+			}
+
+			//operands that are only read can have their values pushed directly
+			bool readsOperands = (node->binary.opcode >= TOY_OP_ADDITION && node->binary.opcode <= TOY_OP_MODULO) || (node->binary.opcode >= TOY_OP_COMPARE_EQUAL && node->binary.opcode <= TOY_OP_COMPARE_GREATER_EQUAL) || node->binary.opcode == TOY_OP_ASSERT;
+
 			//pass to the child nodes, then embed the binary command (math, etc.)
-			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->binary.left, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			Toy_Opcode override = (readsOperands && writeSlotLoad(compiler, node->binary.left)) ? TOY_OP_EOF : Toy_writeCompilerWithJumps(compiler, node->binary.left, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 
 			//special case for when indexing and assigning
 			if (override != TOY_OP_EOF && node->binary.opcode >= TOY_OP_VAR_ASSIGN && node->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN) {
@@ -401,7 +907,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//return this if...
-			Toy_Opcode ret = Toy_writeCompilerWithJumps(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			Toy_Opcode ret = (readsOperands && node->binary.opcode != TOY_OP_ASSERT && writeSlotLoad(compiler, node->binary.right)) ? TOY_OP_EOF : Toy_writeCompilerWithJumps(compiler, node->binary.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 
 			//range-based check for assignment type; make sure the index is on the left of the assignment symbol
 			if (node->binary.opcode == TOY_OP_INDEX && rootNode->type == TOY_AST_NODE_BINARY && (rootNode->binary.opcode >= TOY_OP_VAR_ASSIGN && rootNode->binary.opcode <= TOY_OP_VAR_MODULO_ASSIGN) && !checkNodeInTree(rootNode->binary.right, node)) {
@@ -460,9 +966,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//cache the point to insert the jump distance at
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			int jumpToElse = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToElse = writeCompilerJump(compiler, TOY_OP_IF_FALSE_JUMP); //3 bytes
 
 			//write the then path
 			override = Toy_writeCompilerWithJumps(compiler, node->pathIf.thenPath, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -470,16 +974,11 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
-			int jumpToEnd = 0;
-
 			//insert jump to end
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-			jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToEnd = writeCompilerJump(compiler, TOY_OP_JUMP); //3 bytes
 
 			//update the jumpToElse to point here
-			unsigned short tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToElse, &tmpVal, sizeof(tmpVal)); //2 bytes
+			patchCompilerJump(compiler, jumpToElse, compiler->count + jumpOffsets);
 
 			//write the else path
 			Toy_Opcode override2 = Toy_writeCompilerWithJumps(compiler, node->pathIf.elsePath, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -488,8 +987,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//update the jumpToEnd to point here
-			tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal)); //2 bytes
+			patchCompilerJump(compiler, jumpToEnd, compiler->count + jumpOffsets);
 		}
 		break;
 
@@ -504,7 +1002,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_BLOCK: {
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SCOPE_BEGIN; //1 byte
+			writeScopeBegin(compiler, node->block.nodes, node->block.count);
 
 			for (int i = 0; i < node->block.count; i++) {
 				Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, &(node->block.nodes[i]), breakAddressesPtr, continueAddressesPtr, jumpOffsets, &(node->block.nodes[i]));
@@ -513,7 +1011,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				}
 			}
 
-			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_SCOPE_END; //1 byte
+			writeScopeEnd(compiler);
 		}
 		break;
 
@@ -529,9 +1027,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			if (index >= 256) {
 				//push a "long" index
 				compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
-				memcpy(compiler->bytecode + compiler->count, &index, sizeof(unsigned short));
-
-				compiler->count += sizeof(unsigned short);
+				writeCompilerIndex(compiler, index); //2 or 6 bytes
 			}
 			else {
 				//push the index
@@ -548,29 +1044,39 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 		case TOY_AST_NODE_VAR_DECL: {
 			//first, embed the expression (leaves it on the stack)
-			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->varDecl.expression, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
-			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
-				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
+			if (!writeSlotLoad(compiler, node->varDecl.expression)) {
+				Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->varDecl.expression, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
+					compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
+				}
 			}
 
-			//write each piece of the declaration to the bytecode
-			int identifierIndex = Toy_private_findLiteralIndex(&compiler->literalCache, node->varDecl.identifier);
-			if (identifierIndex < 0) {
-				identifierIndex = Toy_pushLiteralArray(&compiler->literalCache, node->varDecl.identifier);
+			//the variable is only visible after the expression
+			Toy_private_compiler_local* local = addCompilerLocal(compiler, node->varDecl.identifier, false);
+			local->declared = true;
+
+			//declare it in a slot, if one was set aside
+			if (local->slot >= 0) {
+				int typeIndex = writeLiteralTypeToCache(compiler, node->varDecl.typeLiteral);
+
+				compiler->bytecode[compiler->count++] = TOY_OP_SLOT_DECL; //1 byte
+				compiler->bytecode[compiler->count++] = (unsigned char)local->slot; //1 byte
+				writeCompilerIndex(compiler, typeIndex); //2 or 6 bytes
+				break;
 			}
 
-			int typeIndex = writeLiteralTypeToCache(&compiler->literalCache, node->varDecl.typeLiteral);
+			//write each piece of the declaration to the bytecode
+			int identifierIndex = addCompilerLiteral(compiler, node->varDecl.identifier);
+
+			int typeIndex = writeLiteralTypeToCache(compiler, node->varDecl.typeLiteral);
 
 			//embed the info into the bytecode
 			if (identifierIndex >= 256 || typeIndex >= 256) {
 				//push a "long" declaration
 				compiler->bytecode[compiler->count++] = TOY_OP_VAR_DECL_LONG; //1 byte
 
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)identifierIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)typeIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
+				writeCompilerIndex(compiler, identifierIndex); //2 or 6 bytes
+				writeCompilerIndex(compiler, typeIndex); //2 or 6 bytes
 			}
 			else {
 				//push a declaration
@@ -587,10 +1093,28 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			Toy_initCompiler(fnCompiler);
 			Toy_writeCompiler(fnCompiler, node->fnDecl.arguments); //can be empty, but not NULL
 			Toy_writeCompiler(fnCompiler, node->fnDecl.returns); //can be empty, but not NULL
+			fnCompiler->codeStart = fnCompiler->count;
+
+			//the function's scope has slots, starting with the parameters
+			fnCompiler->scopes[0].hasSlots = true;
+
+			for (int i = 0; i < node->fnDecl.arguments->fnCollection.count; i++) {
+				if (node->fnDecl.arguments->fnCollection.nodes[i].type != TOY_AST_NODE_VAR_DECL) {
+					continue;
+				}
+
+				addCompilerLocal(fnCompiler, node->fnDecl.arguments->fnCollection.nodes[i].varDecl.identifier, true)->declared = true;
+			}
+
+			for (int i = 0; i < node->fnDecl.block->block.count; i++) {
+				collectCompilerLocals(fnCompiler, &(node->fnDecl.block->block.nodes[i]));
+			}
+
+			writeScopeSlots(fnCompiler);
 
 			//BUGFIX: copied from TOY_AST_NODE_BLOCK, omitting the SCOPE_BEGIN and SCOPE_END opcodes (might squeeze a few bytes out of the interpreter's scopes by declaring one less)
 			for (int i = 0; i < node->fnDecl.block->block.count; i++) {
-				Toy_Opcode override = Toy_writeCompilerWithJumps(fnCompiler, &(node->fnDecl.block->block.nodes[i]), NULL, NULL, -4, &(node->fnDecl.block->block.nodes[i]));
+				Toy_Opcode override = Toy_writeCompilerWithJumps(fnCompiler, &(node->fnDecl.block->block.nodes[i]), NULL, NULL, -fnCompiler->codeStart, &(node->fnDecl.block->block.nodes[i]));
 				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 					fnCompiler->bytecode[fnCompiler->count++] = (unsigned char)override; //1 byte
 				}
@@ -601,28 +1125,25 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				compiler->panic = true;
 			}
 
+			//functions are always declared by name
+			declareCompilerLocal(compiler, node->fnDecl.identifier);
+
 			//create the function in the literal cache (by storing the compiler object)
 			Toy_Literal fnLiteral = ((Toy_Literal){ .as = { .generic = fnCompiler }, .type = TOY_LITERAL_FUNCTION_INTERMEDIATE});
 
 			//push the name
-			int identifierIndex = Toy_private_findLiteralIndex(&compiler->literalCache, node->fnDecl.identifier);
-			if (identifierIndex < 0) {
-				identifierIndex = Toy_pushLiteralArray(&compiler->literalCache, node->fnDecl.identifier);
-			}
+			int identifierIndex = addCompilerLiteral(compiler, node->fnDecl.identifier);
 
 			//push to function (functions are never equal)
-			int fnIndex = Toy_pushLiteralArray(&compiler->literalCache, fnLiteral);
+			int fnIndex = pushCompilerLiteral(compiler, fnLiteral);
 
 			//embed the info into the bytecode
 			if (identifierIndex >= 256 || fnIndex >= 256) {
 				//push a "long" declaration
 				compiler->bytecode[compiler->count++] = TOY_OP_FN_DECL_LONG; //1 byte
 
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)identifierIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
-
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)fnIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
+				writeCompilerIndex(compiler, identifierIndex); //2 or 6 bytes
+				writeCompilerIndex(compiler, fnIndex); //2 or 6 bytes
 			}
 			else {
 				//push a declaration
@@ -635,15 +1156,14 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 		case TOY_AST_NODE_FN_COLLECTION: {
 			//embed these in the bytecode...
-			unsigned short index = (unsigned short)writeNodeCollectionToCache(compiler, node);
-			
-			if (index == (unsigned short)-1) {
+			int index = writeNodeCollectionToCache(compiler, node);
+
+			if (index < 0) {
 				compiler->panic = true;
 				return TOY_OP_EOF;
 			}
 
-			memcpy(compiler->bytecode + compiler->count, &index, sizeof(index));
-			compiler->count += sizeof(unsigned short);
+			writeCompilerIndex(compiler, index); //2 or 6 bytes
 		}
 		break;
 
@@ -661,18 +1181,14 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				}
 
 				//write each argument to the bytecode
-				int argumentsIndex = Toy_private_findLiteralIndex(&compiler->literalCache, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
-				if (argumentsIndex < 0) {
-					argumentsIndex = Toy_pushLiteralArray(&compiler->literalCache, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
-				}
+				int argumentsIndex = addCompilerLiteral(compiler, node->fnCall.arguments->fnCollection.nodes[i].atomic.literal);
 
 				//push the node opcode to the bytecode
 				if (argumentsIndex >= 256) {
 					//push a "long" index
 					compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
 
-					*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)argumentsIndex; //2 bytes
-					compiler->count += sizeof(unsigned short);
+					writeCompilerIndex(compiler, argumentsIndex); //2 or 6 bytes
 				}
 				else {
 					//push the index
@@ -683,18 +1199,14 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 			//push the argument COUNT to the top of the stack
 			Toy_Literal argumentsCountLiteral =  TOY_TO_INTEGER_LITERAL(node->fnCall.argumentCount); //argumentCount is set elsewhere to support dot operator
-			int argumentsCountIndex = Toy_private_findLiteralIndex(&compiler->literalCache, argumentsCountLiteral);
-			if (argumentsCountIndex < 0) {
-				argumentsCountIndex = Toy_pushLiteralArray(&compiler->literalCache, argumentsCountLiteral);
-			}
+			int argumentsCountIndex = addCompilerLiteral(compiler, argumentsCountLiteral);
 			Toy_freeLiteral(argumentsCountLiteral);
 
 			if (argumentsCountIndex >= 256) {
 				//push a "long" index
 				compiler->bytecode[compiler->count++] = TOY_OP_LITERAL_LONG; //1 byte
 
-				*((unsigned short*)(compiler->bytecode + compiler->count)) = (unsigned short)argumentsCountIndex; //2 bytes
-				compiler->count += sizeof(unsigned short);
+				writeCompilerIndex(compiler, argumentsCountIndex); //2 or 6 bytes
 			}
 			else {
 				//push the index
@@ -709,15 +1221,13 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 		case TOY_AST_NODE_IF: {
 			//process the condition
-			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->pathIf.condition, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
+			Toy_Opcode override = writeSlotLoad(compiler, node->pathIf.condition) ? TOY_OP_EOF : Toy_writeCompilerWithJumps(compiler, node->pathIf.condition, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
 			//cache the point to insert the jump distance at
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			int jumpToElse = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToElse = writeCompilerJump(compiler, TOY_OP_IF_FALSE_JUMP); //3 bytes
 
 			//write the then path
 			override = Toy_writeCompilerWithJumps(compiler, node->pathIf.thenPath, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -729,14 +1239,11 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 			if (node->pathIf.elsePath) {
 				//insert jump to end
-				compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-				jumpToEnd = compiler->count;
-				compiler->count += sizeof(unsigned short); //2 bytes
+				jumpToEnd = writeCompilerJump(compiler, TOY_OP_JUMP); //3 bytes
 			}
 
 			//update the jumpToElse to point here
-			unsigned short tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToElse, &tmpVal, sizeof(tmpVal)); //2 bytes
+			patchCompilerJump(compiler, jumpToElse, compiler->count + jumpOffsets);
 
 			if (node->pathIf.elsePath) {
 				//if there's an else path, write it and 
@@ -746,8 +1253,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				}
 
 				//update the jumpToEnd to point here
-				tmpVal = compiler->count + jumpOffsets;
-				memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal)); //2 bytes
+				patchCompilerJump(compiler, jumpToEnd, compiler->count + jumpOffsets);
 			}
 		}
 		break;
@@ -760,19 +1266,23 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			Toy_initLiteralArray(&breakAddresses);
 			Toy_initLiteralArray(&continueAddresses);
 
+			//breaks and continues leave any scopes opened within the loop
+			int breakScopeCount = compiler->breakScopeCount;
+			int continueScopeCount = compiler->continueScopeCount;
+			compiler->breakScopeCount = compiler->scopeCount;
+			compiler->continueScopeCount = compiler->scopeCount;
+
 			//cache the jump point
-			unsigned short jumpToStart = compiler->count;
+			int jumpToStart = compiler->count;
 
 			//process the condition
-			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->pathWhile.condition, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
+			Toy_Opcode override = writeSlotLoad(compiler, node->pathWhile.condition) ? TOY_OP_EOF : Toy_writeCompilerWithJumps(compiler, node->pathWhile.condition, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
 			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
 			//if false, jump to end
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			unsigned short jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToEnd = writeCompilerJump(compiler, TOY_OP_IF_FALSE_JUMP); //3 bytes
 
 			//write the body
 			override = Toy_writeCompilerWithJumps(compiler, node->pathWhile.thenPath, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
@@ -781,31 +1291,28 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//jump to condition
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-			unsigned short tmpVal = jumpToStart + jumpOffsets;
-			memcpy(compiler->bytecode + compiler->count, &tmpVal, sizeof(tmpVal));
-			compiler->count += sizeof(unsigned short); //2 bytes
+			patchCompilerJump(compiler, writeCompilerJump(compiler, TOY_OP_JUMP), jumpToStart + jumpOffsets); //3 bytes
 
 			//jump from condition
-			tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal));
+			patchCompilerJump(compiler, jumpToEnd, compiler->count + jumpOffsets);
 
 			//set the breaks and continues
 			for (int i = 0; i < breakAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(breakAddresses.literals[i]);
-				tmpVal = compiler->count + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				patchCompilerJump(compiler, point, compiler->count + jumpOffsets);
 			}
 
 			for (int i = 0; i < continueAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(continueAddresses.literals[i]);
-				tmpVal = jumpToStart + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				patchCompilerJump(compiler, point, jumpToStart + jumpOffsets);
 			}
 
 			//clear the stack after use
 			compiler->bytecode[compiler->count++] = TOY_OP_POP_STACK; //1 byte
 
+			compiler->breakScopeCount = breakScopeCount;
+			compiler->continueScopeCount = continueScopeCount;
+
 			//cleanup
 			Toy_freeLiteralArray(&breakAddresses);
 			Toy_freeLiteralArray(&continueAddresses);
@@ -820,7 +1327,14 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			Toy_initLiteralArray(&breakAddresses);
 			Toy_initLiteralArray(&continueAddresses);
 
-			compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_BEGIN; //1 byte
+			//breaks leave the whole loop, while continues stay within the initial setup's scope
+			int breakScopeCount = compiler->breakScopeCount;
+			int continueScopeCount = compiler->continueScopeCount;
+			compiler->breakScopeCount = compiler->scopeCount;
+
+			writeScopeBegin(compiler, node->pathFor.preClause, 1);
+
+			compiler->continueScopeCount = compiler->scopeCount;
 
 			//initial setup
 			Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->pathFor.preClause, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
@@ -829,21 +1343,19 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//conditional
-			unsigned short jumpToStart = compiler->count;
-			override = Toy_writeCompilerWithJumps(compiler, node->pathFor.condition, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
+			int jumpToStart = compiler->count;
+			override = writeSlotLoad(compiler, node->pathFor.condition) ? TOY_OP_EOF : Toy_writeCompilerWithJumps(compiler, node->pathFor.condition, &breakAddresses, &continueAddresses, jumpOffsets, rootNode);
 			if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
 			//if false jump to end
-			compiler->bytecode[compiler->count++] = TOY_OP_IF_FALSE_JUMP; //1 byte
-			unsigned short jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToEnd = writeCompilerJump(compiler, TOY_OP_IF_FALSE_JUMP); //3 bytes
 
 			//write the body
 			bool closeScope = false;
 			if (node->pathFor.thenPath->type != TOY_AST_NODE_BLOCK) {
-				compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_BEGIN; //1 byte
+				writeScopeBegin(compiler, node->pathFor.thenPath, 1);
 				closeScope = true;
 			}
 
@@ -853,7 +1365,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			if (closeScope) {
-				compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_END; //1 byte
+				writeScopeEnd(compiler);
 			}
 
 			//for-breaks actually jump to the bottom
@@ -868,27 +1380,24 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			//BUGFIX: clear the stack after each loop
 			compiler->bytecode[compiler->count++] = TOY_OP_POP_STACK; //1 byte
 
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
-			unsigned short tmpVal = jumpToStart + jumpOffsets;
-			memcpy(compiler->bytecode + compiler->count, &tmpVal, sizeof(tmpVal));
-			compiler->count += sizeof(unsigned short); //2 bytes
+			patchCompilerJump(compiler, writeCompilerJump(compiler, TOY_OP_JUMP), jumpToStart + jumpOffsets); //3 bytes
+
+			patchCompilerJump(compiler, jumpToEnd, compiler->count + jumpOffsets);
 
-			tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal));
+			writeScopeEnd(compiler);
 
-			compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_END; //1 byte
+			compiler->breakScopeCount = breakScopeCount;
+			compiler->continueScopeCount = continueScopeCount;
 
 			//set the breaks and continues
 			for (int i = 0; i < breakAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(breakAddresses.literals[i]);
-				tmpVal = compiler->count + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				patchCompilerJump(compiler, point, compiler->count + jumpOffsets);
 			}
 
 			for (int i = 0; i < continueAddresses.count; i++) {
 				int point = TOY_AS_INTEGER(continueAddresses.literals[i]);
-				tmpVal = jumpToIncrement + jumpOffsets;
-				memcpy(compiler->bytecode + point, &tmpVal, sizeof(tmpVal));
+				patchCompilerJump(compiler, point, jumpToIncrement + jumpOffsets);
 			}
 
 			//cleanup
@@ -903,15 +1412,19 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				break;
 			}
 
+			//leave the scopes opened within the loop
+			growCompilerBytecode(compiler, compiler->scopeCount - compiler->breakScopeCount + 3);
+			for (int i = compiler->breakScopeCount; i < compiler->scopeCount; i++) {
+				compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_END; //1 byte
+			}
+
 			//insert into bytecode
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
+			int point = writeCompilerJump(compiler, TOY_OP_JUMP); //3 bytes
 
 			//push to the breakAddresses array
-			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(compiler->count);
+			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(point);
 			Toy_pushLiteralArray((Toy_LiteralArray*)breakAddressesPtr, literal);
 			Toy_freeLiteral(literal);
-
-			compiler->count += sizeof(unsigned short); //2 bytes
 		}
 		break;
 
@@ -921,15 +1434,19 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				break;
 			}
 
+			//leave the scopes opened within the loop
+			growCompilerBytecode(compiler, compiler->scopeCount - compiler->continueScopeCount + 3);
+			for (int i = compiler->continueScopeCount; i < compiler->scopeCount; i++) {
+				compiler->bytecode[compiler->count++] = TOY_OP_SCOPE_END; //1 byte
+			}
+
 			//insert into bytecode
-			compiler->bytecode[compiler->count++] = TOY_OP_JUMP; //1 byte
+			int point = writeCompilerJump(compiler, TOY_OP_JUMP); //3 bytes
 
 			//push to the continueAddresses array
-			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(compiler->count);
+			Toy_Literal literal = TOY_TO_INTEGER_LITERAL(point);
 			Toy_pushLiteralArray((Toy_LiteralArray*)continueAddressesPtr, literal);
 			Toy_freeLiteral(literal);
-
-			compiler->count += sizeof(unsigned short); //2 bytes
 		}
 		break;
 
@@ -941,9 +1458,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//insert the AND opcode to signal a possible jump
-			compiler->bytecode[compiler->count++] = TOY_OP_AND; //1 byte
-			int jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			int jumpToEnd = writeCompilerJump(compiler, TOY_OP_AND); //3 bytes
 
 			//process the rhs
 			override = Toy_writeCompilerWithJumps(compiler, node->pathAnd.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -952,8 +1467,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//set the spot to jump to, to proceed
-			unsigned short tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal));
+			patchCompilerJump(compiler, jumpToEnd, compiler->count + jumpOffsets);
 		}
 		break;
 
@@ -964,10 +1478,8 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 				compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
 			}
 
-			//insert the AND opcode to signal a possible jump
-			compiler->bytecode[compiler->count++] = TOY_OP_OR; //1 byte
-			int jumpToEnd = compiler->count;
-			compiler->count += sizeof(unsigned short); //2 bytes
+			//insert the OR opcode to signal a possible jump
+			int jumpToEnd = writeCompilerJump(compiler, TOY_OP_OR); //3 bytes
 
 			//process the rhs
 			override = Toy_writeCompilerWithJumps(compiler, node->pathOr.right, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
@@ -976,14 +1488,17 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			}
 
 			//set the spot to jump to, to proceed
-			unsigned short tmpVal = compiler->count + jumpOffsets;
-			memcpy(compiler->bytecode + jumpToEnd, &tmpVal, sizeof(tmpVal));
+			patchCompilerJump(compiler, jumpToEnd, compiler->count + jumpOffsets);
 		}
 		break;
 
 		case TOY_AST_NODE_FN_RETURN: {
 			//read each returned literal onto the stack, and return the number of values to return
 			for (int i = 0; i < node->returns.returns->fnCollection.count; i++) {
+				if (writeSlotLoad(compiler, &node->returns.returns->fnCollection.nodes[i])) {
+					continue;
+				}
+
 				Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, &node->returns.returns->fnCollection.nodes[i], breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 					compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
@@ -999,6 +1514,10 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_PREFIX_INCREMENT: {
+			if (writeSlotIncrement(compiler, node->prefixIncrement.identifier, TOY_OP_ADDITION, true)) {
+				break;
+			}
+
 			//push the literal to the stack (twice: add + assign)
 			writeLiteralToCompiler(compiler, node->prefixIncrement.identifier);
 			writeLiteralToCompiler(compiler, node->prefixIncrement.identifier);
@@ -1020,6 +1539,10 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_PREFIX_DECREMENT: {
+			if (writeSlotIncrement(compiler, node->prefixDecrement.identifier, TOY_OP_SUBTRACTION, true)) {
+				break;
+			}
+
 			//push the literal to the stack (twice: add + assign)
 			writeLiteralToCompiler(compiler, node->prefixDecrement.identifier);
 			writeLiteralToCompiler(compiler, node->prefixDecrement.identifier);
@@ -1041,6 +1564,10 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_POSTFIX_INCREMENT: {
+			if (writeSlotIncrement(compiler, node->postfixIncrement.identifier, TOY_OP_ADDITION, false)) {
+				break;
+			}
+
 			//push the identifier's VALUE to the stack
 			writeLiteralToCompiler(compiler, node->postfixIncrement.identifier);
 			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_LITERAL_RAW; //1 byte
@@ -1062,6 +1589,10 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 		break;
 
 		case TOY_AST_NODE_POSTFIX_DECREMENT: {
+			if (writeSlotIncrement(compiler, node->postfixDecrement.identifier, TOY_OP_SUBTRACTION, false)) {
+				break;
+			}
+
 			//push the identifier's VALUE to the stack
 			writeLiteralToCompiler(compiler, node->postfixDecrement.identifier);
 			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_LITERAL_RAW; //1 byte
@@ -1089,6 +1620,9 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 
 			//push the import opcode
 			compiler->bytecode[compiler->count++] = (unsigned char)TOY_OP_IMPORT; //1 byte
+
+			//imports can declare anything, so stop resolving variables through this scope
+			compiler->scopes[compiler->scopeCount - 1].opaque = true;
 		}
 		break;
 
@@ -1099,7 +1633,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			if (!node->index.first) {
 				writeLiteralToCompiler(compiler, TOY_TO_NULL_LITERAL);
 			}
-			else {
+			else if (!writeSlotLoad(compiler, node->index.first)) {
 				Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->index.first, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 					compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
@@ -1110,7 +1644,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			if (!node->index.second) {
 				writeLiteralToCompiler(compiler, TOY_TO_NULL_LITERAL);
 			}
-			else {
+			else if (!writeSlotLoad(compiler, node->index.second)) {
 				Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->index.second, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 					compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
@@ -1121,7 +1655,7 @@ static Toy_Opcode Toy_writeCompilerWithJumps(Toy_Compiler* compiler, Toy_ASTNode
 			if (!node->index.third) {
 				writeLiteralToCompiler(compiler, TOY_TO_NULL_LITERAL);
 			}
-			else {
+			else if (!writeSlotLoad(compiler, node->index.third)) {
 				Toy_Opcode override = Toy_writeCompilerWithJumps(compiler, node->index.third, breakAddressesPtr, continueAddressesPtr, jumpOffsets, rootNode);
 				if (override != TOY_OP_EOF) {//compensate for indexing & dot notation being screwy
 					compiler->bytecode[compiler->count++] = (unsigned char)override; //1 byte
@@ -1153,13 +1687,350 @@ void Toy_writeCompiler(Toy_Compiler* compiler, Toy_ASTNode* node) {
 	//TODO: could free up AST Nodes
 }
 
+//the optimizer works on the written code, before the jumps are widened
+static int readCompilerIndexLength(const unsigned char* code) {
+	unsigned short index;
+	memcpy(&index, code, sizeof(unsigned short));
+
+	return index != TOY_OPERAND_WIDE ? (int)sizeof(unsigned short) : (int)(sizeof(unsigned short) + sizeof(int));
+}
+
+static int readCompilerInstructionLength(const unsigned char* code) {
+	switch(code[0]) {
+		case TOY_OP_LITERAL:
+		case TOY_OP_INDEX_ASSIGN: //followed by the assignment opcode
+			return 2;
+
+		case TOY_OP_VAR_DECL:
+		case TOY_OP_FN_DECL:
+		case TOY_OP_SLOT_LOAD:
+		case TOY_OP_SLOT_STORE:
+		case TOY_OP_SLOT_INCREMENT:
+		case TOY_OP_SLOT_DECREMENT:
+		case TOY_OP_FN_RETURN: //followed by the number of returned values
+			return 3;
+
+		case TOY_OP_AND:
+		case TOY_OP_OR:
+		case TOY_OP_JUMP:
+		case TOY_OP_IF_FALSE_JUMP:
+		case TOY_OP_IF_TRUE_JUMP:
+			return 1 + sizeof(unsigned short);
+
+		case TOY_OP_LITERAL_LONG:
+			return 1 + readCompilerIndexLength(code + 1);
+
+		case TOY_OP_VAR_DECL_LONG:
+		case TOY_OP_FN_DECL_LONG:
+		case TOY_OP_SCOPE_SLOTS: {
+			int first = readCompilerIndexLength(code + 1);
+			return 1 + first + readCompilerIndexLength(code + 1 + first);
+		}
+
+		case TOY_OP_SLOT_DECL:
+			return 2 + readCompilerIndexLength(code + 2);
+
+		default:
+			return 1;
+	}
+}
+
+static bool isCompilerLiteralOne(Toy_Compiler* compiler, const unsigned char* code) {
+	return code[0] == TOY_OP_LITERAL && TOY_IS_INTEGER(compiler->literalCache.literals[code[1]]) && TOY_AS_INTEGER(compiler->literalCache.literals[code[1]]) == 1;
+}
+
+static void optimizeCompilerCode(Toy_Compiler* compiler) {
+	//jump targets and instructions are relative to the start of the code
+	unsigned char* code = compiler->bytecode + compiler->codeStart;
+	int length = compiler->count - compiler->codeStart;
+
+	if (length <= 0) {
+		return;
+	}
+
+	int* starts = TOY_ALLOCATE(int, length + 1); //where each instruction begins
+	int* instructions = TOY_ALLOCATE(int, length + 1); //which instruction begins at each offset, or -1
+	bool* targeted = TOY_ALLOCATE(bool, length + 1);
+	int count = 0;
+
+	for (int i = 0; i <= length; i++) {
+		instructions[i] = -1;
+		targeted[i] = false;
+	}
+
+	for (int i = 0; i < length; i += readCompilerInstructionLength(code + i)) {
+		instructions[i] = count;
+		starts[count++] = i;
+	}
+
+	starts[count] = length;
+	instructions[length] = count;
+
+	bool* removed = TOY_ALLOCATE(bool, count + 1);
+	for (int i = 0; i <= count; i++) {
+		removed[i] = false;
+	}
+
+	//leave the code alone if it can't be followed
+	bool valid = starts[count - 1] + readCompilerInstructionLength(code + starts[count - 1]) == length;
+
+	for (int j = 0; valid && j < compiler->jumpCount; j++) {
+		int site = compiler->jumps[j].site - compiler->codeStart;
+		int target = compiler->jumps[j].target;
+
+		valid = site >= 1 && site < length && instructions[site - 1] >= 0 && target >= 0 && target <= length && instructions[target] >= 0;
+	}
+
+	if (!valid) {
+		TOY_FREE_ARRAY(bool, removed, count + 1);
+		TOY_FREE_ARRAY(bool, targeted, length + 1);
+		TOY_FREE_ARRAY(int, instructions, length + 1);
+		TOY_FREE_ARRAY(int, starts, length + 1);
+		return;
+	}
+
+	//jumps to unconditional jumps can go straight to the end of the chain
+	for (int j = 0; j < compiler->jumpCount; j++) {
+		Toy_private_compiler_jump* jump = &compiler->jumps[j];
+
+		for (int hops = 0; hops < compiler->jumpCount && jump->target < length && code[jump->target] == TOY_OP_JUMP; hops++) {
+			Toy_private_compiler_jump* next = findCompilerJump(compiler, jump->target + 1 + compiler->codeStart);
+
+			if (next == NULL || next == jump) {
+				break;
+			}
+
+			jump->target = next->target;
+		}
+
+		targeted[jump->target] = true;
+	}
+
+	//fuse sequences into superinstructions, as long as nothing jumps into the middle of them
+	for (int k = 0; k + 1 < count; k++) {
+		unsigned char* op = code + starts[k];
+
+		if (op[0] == TOY_OP_INVERT && code[starts[k + 1]] == TOY_OP_IF_FALSE_JUMP && !targeted[starts[k + 1]]) {
+			code[starts[k + 1]] = TOY_OP_IF_TRUE_JUMP;
+			removed[k] = true;
+			continue;
+		}
+
+		if (op[0] == TOY_OP_SLOT_LOAD && k + 3 < count && isCompilerLiteralOne(compiler, code + starts[k + 1]) &&
+			(code[starts[k + 2]] == TOY_OP_ADDITION || code[starts[k + 2]] == TOY_OP_SUBTRACTION) &&
+			code[starts[k + 3]] == TOY_OP_SLOT_STORE && memcmp(op + 1, code + starts[k + 3] + 1, 2) == 0 &&
+			!targeted[starts[k + 1]] && !targeted[starts[k + 2]] && !targeted[starts[k + 3]])
+		{
+			op[0] = code[starts[k + 2]] == TOY_OP_ADDITION ? TOY_OP_SLOT_INCREMENT : TOY_OP_SLOT_DECREMENT;
+			removed[k + 1] = removed[k + 2] = removed[k + 3] = true;
+			k += 3;
+		}
+	}
+
+	//remove instructions that do nothing, or whose results are immediately discarded
+	int* groupings = TOY_ALLOCATE(int, count); //unmatched GROUPING_BEGIN instructions
+	int groupingCount = 0;
+
+	for (int k = 0; k < count; k++) {
+		if (removed[k]) {
+			continue;
+		}
+
+		//removed instructions are skipped over, so look past them
+		int next = k + 1;
+		while (next < count && removed[next]) {
+			next++;
+		}
+
+		int after = next + 1;
+		while (after < count && removed[after]) {
+			after++;
+		}
+
+		int previous = k - 1;
+		while (previous >= 0 && removed[previous]) {
+			previous--;
+		}
+
+		unsigned char* op = code + starts[k];
+		int nextOp = next < count ? code[starts[next]] : -1;
+		int afterOp = after < count ? code[starts[after]] : -1;
+		int previousOp = previous >= 0 ? code[starts[previous]] : -1;
+
+		switch(op[0]) {
+			case TOY_OP_PASS:
+				removed[k] = true;
+				break;
+
+			//POP_STACK discards everything, so pushing anything just before it is pointless
+			case TOY_OP_LITERAL:
+			case TOY_OP_LITERAL_LONG:
+			case TOY_OP_POP_STACK:
+				removed[k] = nextOp == TOY_OP_POP_STACK;
+				break;
+
+			//the values of "i++;" and "++i;" are discarded - these loads can only fail if the increment does too
+			case TOY_OP_SLOT_LOAD:
+				if ((nextOp == TOY_OP_SLOT_INCREMENT || nextOp == TOY_OP_SLOT_DECREMENT) && afterOp == TOY_OP_POP_STACK) {
+					removed[k] = memcmp(op + 1, code + starts[next] + 1, 2) == 0;
+				}
+				else if ((previousOp == TOY_OP_SLOT_INCREMENT || previousOp == TOY_OP_SLOT_DECREMENT || previousOp == TOY_OP_SLOT_STORE) && nextOp == TOY_OP_POP_STACK) {
+					//only if it always follows the increment
+					bool entered = false;
+					for (int i = previous + 1; i <= k; i++) {
+						entered = entered || targeted[starts[i]];
+					}
+
+					removed[k] = !entered && memcmp(op + 1, code + starts[previous] + 1, 2) == 0;
+				}
+				break;
+
+			//groupings run in a nested loop, which only makes a difference to index assignments
+			case TOY_OP_GROUPING_BEGIN:
+				groupings[groupingCount++] = k;
+				break;
+
+			case TOY_OP_GROUPING_END: {
+				if (groupingCount == 0) {
+					break;
+				}
+
+				int begin = groupings[--groupingCount];
+				bool flatten = true;
+
+				for (int i = begin + 1; i < k && flatten; i++) {
+					flatten = code[starts[i]] != TOY_OP_INDEX_ASSIGN && code[starts[i]] != TOY_OP_INDEX_ASSIGN_INTERMEDIATE;
+				}
+
+				removed[begin] = removed[k] = flatten;
+			}
+			break;
+		}
+	}
+
+	TOY_FREE_ARRAY(int, groupings, count);
+
+	//jumps to the next remaining instruction can go, starting from the end so chains of them go too
+	for (int k = count - 1; k >= 0; k--) {
+		if (removed[k] || code[starts[k]] != TOY_OP_JUMP) {
+			continue;
+		}
+
+		Toy_private_compiler_jump* jump = findCompilerJump(compiler, starts[k] + 1 + compiler->codeStart);
+		int target = instructions[jump->target];
+		bool skippable = target > k;
+
+		for (int i = k + 1; i < target && skippable; i++) {
+			skippable = removed[i];
+		}
+
+		removed[k] = skippable;
+	}
+
+	//close the gaps - anything that pointed at a removed instruction now points at the next one
+	int* positions = instructions; //reused, now only read at instruction starts
+	int position = 0;
+
+	for (int k = 0; k < count; k++) {
+		int start = starts[k];
+		int size = starts[k + 1] - start;
+
+		positions[start] = position;
+
+		if (!removed[k]) {
+			memmove(code + position, code + start, size);
+			position += size;
+		}
+	}
+
+	positions[length] = position;
+
+	//the jumps were sorted by site, and still are
+	int jumpCount = 0;
+
+	for (int j = 0; j < compiler->jumpCount; j++) {
+		Toy_private_compiler_jump jump = compiler->jumps[j];
+		int site = jump.site - compiler->codeStart;
+
+		//find the instruction this jump belongs to, by the start of its opcode
+		int k = 0;
+		for (int low = 0, high = count - 1; low <= high; ) {
+			int mid = low + (high - low) / 2;
+
+			if (starts[mid] < site - 1) {
+				low = mid + 1;
+			}
+			else if (starts[mid] > site - 1) {
+				high = mid - 1;
+			}
+			else {
+				k = mid;
+				break;
+			}
+		}
+
+		if (removed[k]) {
+			continue;
+		}
+
+		jump.site = positions[site - 1] + 1 + compiler->codeStart;
+		jump.target = positions[jump.target];
+		compiler->jumps[jumpCount++] = jump;
+
+		unsigned short shortTarget = (unsigned short)jump.target;
+		memcpy(compiler->bytecode + jump.site, &shortTarget, sizeof(unsigned short)); //2 bytes
+	}
+
+	compiler->jumpCount = jumpCount;
+	compiler->count = compiler->codeStart + position;
+
+	TOY_FREE_ARRAY(bool, removed, count + 1);
+	TOY_FREE_ARRAY(bool, targeted, length + 1);
+	TOY_FREE_ARRAY(int, instructions, length + 1);
+	TOY_FREE_ARRAY(int, starts, length + 1);
+}
+
+void Toy_optimizeCompiler(Toy_Compiler* compiler) {
+	if (compiler->panic) {
+		return;
+	}
+
+	//functions are written by their own compilers, which wait in the literal cache until collation
+	for (int i = 0; i < compiler->literalCache.count; i++) {
+		if (compiler->literalCache.literals[i].type == TOY_LITERAL_FUNCTION_INTERMEDIATE) {
+			Toy_optimizeCompiler((Toy_Compiler*)compiler->literalCache.literals[i].as.generic);
+		}
+	}
+
+	optimizeCompilerCode(compiler);
+}
+
 void Toy_freeCompiler(Toy_Compiler* compiler) {
+	while (compiler->scopeCount > 0) {
+		popCompilerScope(compiler);
+	}
+	TOY_FREE_ARRAY(Toy_private_compiler_scope, compiler->scopes, compiler->scopeCapacity);
+	compiler->scopes = NULL;
+	compiler->scopeCapacity = 0;
+	compiler->breakScopeCount = 0;
+	compiler->continueScopeCount = 0;
+
 	Toy_freeLiteralArray(&compiler->literalCache);
+	TOY_FREE_ARRAY(Toy_private_compiler_literal_entry, compiler->literalIndex, compiler->literalIndexCapacity);
+	compiler->literalIndex = NULL;
+	compiler->literalIndexCapacity = 0;
+	compiler->literalIndexCount = 0;
 	TOY_FREE_ARRAY(unsigned char, compiler->bytecode, compiler->capacity);
 	compiler->bytecode = NULL;
 	compiler->capacity = 0;
 	compiler->count = 0;
+	compiler->codeStart = 0;
 	compiler->panic = false;
+
+	TOY_FREE_ARRAY(Toy_private_compiler_jump, compiler->jumps, compiler->jumpCapacity);
+	compiler->jumps = NULL;
+	compiler->jumpCapacity = 0;
+	compiler->jumpCount = 0;
 }
 
 static void emitByte(unsigned char** collationPtr, int* capacityPtr, int* countPtr, unsigned char byte) {
@@ -1194,6 +2065,17 @@ static void emitInt(unsigned char** collationPtr, int* capacityPtr, int* countPt
 	emitByte(collationPtr, capacityPtr, countPtr, *ptr);
 }
 
+//indexes, counts and sizes that don't fit into 16 bits are marked as wide, and followed by all 32 bits
+static void emitIndex(unsigned char** collationPtr, int* capacityPtr, int* countPtr, int index) {
+	if (index < TOY_OPERAND_WIDE) {
+		Toy_emitShort(collationPtr, capacityPtr, countPtr, (unsigned short)index);
+	}
+	else {
+		Toy_emitShort(collationPtr, capacityPtr, countPtr, TOY_OPERAND_WIDE);
+		emitInt(collationPtr, capacityPtr, countPtr, index);
+	}
+}
+
 static void emitFloat(unsigned char** collationPtr, int* capacityPtr, int* countPtr, float bytes) {
 	char* ptr = (char*)&bytes;
 
@@ -1206,6 +2088,48 @@ static void emitFloat(unsigned char** collationPtr, int* capacityPtr, int* count
 	emitByte(collationPtr, capacityPtr, countPtr, *ptr);
 }
 
+//widening each jump before the target moves it along by 4 bytes
+static int widenCompilerJumpTarget(Toy_Compiler* compiler, int target) {
+	int site = target + compiler->codeStart;
+
+	//count the jumps before the target (the jumps are sorted by site)
+	int low = 0;
+	int high = compiler->jumpCount;
+
+	while (low < high) {
+		int mid = low + (high - low) / 2;
+
+		if (compiler->jumps[mid].site < site) {
+			low = mid + 1;
+		}
+		else {
+			high = mid;
+		}
+	}
+
+	return target + low * (int)sizeof(int);
+}
+
+static void emitCompilerCode(Toy_Compiler* compiler, unsigned char** collationPtr, int* capacityPtr, int* countPtr) {
+	//the jumps only need widening if the code is too long for 16-bit targets
+	bool wide = compiler->count - compiler->codeStart >= TOY_OPERAND_WIDE;
+	int jump = 0;
+
+	for (int i = 0; i < compiler->count; i++) {
+		if (wide && jump < compiler->jumpCount && compiler->jumps[jump].site == i) {
+			//always 6 bytes in place of 2, even when the widened target would fit, so the other targets stay correct
+			Toy_emitShort(collationPtr, capacityPtr, countPtr, TOY_OPERAND_WIDE);
+			emitInt(collationPtr, capacityPtr, countPtr, widenCompilerJumpTarget(compiler, compiler->jumps[jump].target));
+
+			i += sizeof(unsigned short) - 1;
+			jump++;
+			continue;
+		}
+
+		emitByte(collationPtr, capacityPtr, countPtr, compiler->bytecode[i]);
+	}
+}
+
 //return the result
 static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* size, bool embedHeader) {
 	if (compiler->panic) {
@@ -1243,8 +2167,8 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 		emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate header
 	}
 
-	//embed the data section (first short is the number of literals)
-	Toy_emitShort(&collation, &capacity, &count, compiler->literalCache.count);
+	//embed the data section (first index is the number of literals)
+	emitIndex(&collation, &capacity, &count, compiler->literalCache.count);
 
 	//emit each literal by type
 	for (int i = 0; i < compiler->literalCache.count; i++) {
@@ -1291,12 +2215,12 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]);
 
-				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count);
+				//length of the array, as an index
+				emitIndex(&collation, &capacity, &count, ptr->count);
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i])); //the indexes of the values
 				}
 			}
 			break;
@@ -1306,12 +2230,12 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]);
 
-				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count);
+				//length of the array, as an index
+				emitIndex(&collation, &capacity, &count, ptr->count);
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i])); //the indexes of the values
 				}
 			}
 			break;
@@ -1321,12 +2245,12 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]); //used an array for storage above
 
-				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count); //count is the array size, NOT the dictionary size
+				//length of the array, as an index
+				emitIndex(&collation, &capacity, &count, ptr->count); //count is the array size, NOT the dictionary size
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i])); //the indexes of the values
 				}
 			}
 			break;
@@ -1336,12 +2260,12 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 
 				Toy_LiteralArray* ptr = TOY_AS_ARRAY(compiler->literalCache.literals[i]); //used an array for storage above
 
-				//length of the array, as a short
-				Toy_emitShort(&collation, &capacity, &count, ptr->count); //count is the array size, NOT the dictionary size
+				//length of the array, as an index
+				emitIndex(&collation, &capacity, &count, ptr->count); //count is the array size, NOT the dictionary size
 
 				//each element of the array
 				for (int i = 0; i < ptr->count; i++) {
-					Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the values
+					emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i])); //the indexes of the values
 				}
 			}
 			break;
@@ -1356,7 +2280,7 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				unsigned char* bytes = collateCompilerHeaderOpt((Toy_Compiler*)fnCompiler, &size, false);
 
 				//emit how long this section is, +1 for ending mark
-				Toy_emitShort(&fnCollation, &fnCapacity, &fnCount, (unsigned short)size + 1);
+				emitIndex(&fnCollation, &fnCapacity, &fnCount, (int)size + 1);
 
 				//write the fn to the fn collation
 				for (size_t i = 0; i < size; i++) {
@@ -1367,10 +2291,10 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 
 				//embed the reference to the function implementation into the current collation (to be extracted later)
 				emitByte(&collation, &capacity, &count, TOY_LITERAL_FUNCTION);
-				Toy_emitShort(&collation, &capacity, &count, (unsigned short)(fnIndex++));
+				emitIndex(&collation, &capacity, &count, fnIndex++);
 
 				Toy_freeCompiler((Toy_Compiler*)fnCompiler);
-				TOY_FREE(compiler, fnCompiler);
+				TOY_FREE(Toy_Compiler, fnCompiler);
 				TOY_FREE_ARRAY(unsigned char, bytes, size);
 			}
 			break;
@@ -1416,7 +2340,7 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 				if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_ARRAY || TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_DICTIONARY) {
 					//the type will represent how many to expect in the array
 					for (int i = 1; i < ptr->count; i++) {
-						Toy_emitShort(&collation, &capacity, &count, (unsigned short)TOY_AS_INTEGER(ptr->literals[i])); //shorts representing the indexes of the types
+						emitIndex(&collation, &capacity, &count, TOY_AS_INTEGER(ptr->literals[i])); //the indexes of the types
 					}
 				}
 
@@ -1438,8 +2362,8 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 	emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate data
 
 	//embed the function section (beginning with function count, size)
-	Toy_emitShort(&collation, &capacity, &count, fnIndex);
-	Toy_emitShort(&collation, &capacity, &count, fnCount);
+	emitIndex(&collation, &capacity, &count, fnIndex);
+	emitIndex(&collation, &capacity, &count, fnCount);
 
 	for (int i = 0; i < fnCount; i++) {
 		emitByte(&collation, &capacity, &count, fnCollation[i]);
@@ -1450,9 +2374,7 @@ static unsigned char* collateCompilerHeaderOpt(Toy_Compiler* compiler, size_t* s
 	TOY_FREE_ARRAY(unsigned char, fnCollation, fnCapacity); //clear the function stuff
 
 	//code section
-	for (int i = 0; i < compiler->count; i++) {
-		emitByte(&collation, &capacity, &count, compiler->bytecode[i]);
-	}
+	emitCompilerCode(compiler, &collation, &capacity, &count);
 
 	emitByte(&collation, &capacity, &count, TOY_OP_SECTION_END); //terminate code
 
@@ -15,12 +15,56 @@ During the collation step, everything from the core program’s execution instru
 #include "toy_ast_node.h"
 #include "toy_literal_array.h"
 
+//local variables are resolved to numbered slots where possible, so the interpreter can skip the name lookups
+typedef struct Toy_private_compiler_local {
+	Toy_Literal identifier;
+	int slot; //-1 if this can only be found by name
+	bool declared; //only uses after the declaration can be resolved
+} Toy_private_compiler_local;
+
+typedef struct Toy_private_compiler_scope {
+	Toy_private_compiler_local* locals;
+	int capacity;
+	int count;
+	int slotCount;
+	bool hasSlots; //false for the global scope
+	bool opaque; //imports can declare anything, so nothing past this can be resolved
+} Toy_private_compiler_scope;
+
+//hashes into the literal cache, so duplicate literals can be found without scanning it
+typedef struct Toy_private_compiler_literal_entry {
+	unsigned int hash;
+	int index; //-1 if this entry is empty
+} Toy_private_compiler_literal_entry;
+
+//jumps are written with 16-bit targets, and widened during collation if the code is too long for them
+typedef struct Toy_private_compiler_jump {
+	int site; //where the target is written
+	int target;
+} Toy_private_compiler_jump;
+
 typedef struct Toy_Compiler {
 	Toy_LiteralArray literalCache;
+	Toy_private_compiler_literal_entry* literalIndex;
+	int literalIndexCapacity;
+	int literalIndexCount;
 	unsigned char* bytecode;
 	int capacity;
 	int count;
+	int codeStart; //jump targets are relative to this (functions begin with their parameter and return indexes)
 	bool panic;
+
+	//every jump, in the order they were written
+	Toy_private_compiler_jump* jumps;
+	int jumpCapacity;
+	int jumpCount;
+
+	//mirrors the interpreter's scopes
+	Toy_private_compiler_scope* scopes;
+	int scopeCapacity;
+	int scopeCount;
+	int breakScopeCount; //how many scopes a break or continue jumps out to
+	int continueScopeCount;
 } Toy_Compiler;
 
 /*!
@@ -43,6 +87,15 @@ This function writes the given `node` argument to the compiler. During the writi
 !*/
 TOY_API void Toy_writeCompiler(Toy_Compiler* compiler, Toy_ASTNode* node);
 
+/*!
+### void Toy_optimizeCompiler(Toy_Compiler* compiler)
+
+This function runs an optional optimization pass over everything written to the compiler, including any functions. It should be called after the last call to `Toy_writeCompiler()`, and before `Toy_collateCompiler()`.
+
+The pass removes instructions that have no effect (such as `TOY_OP_PASS`, most grouping pairs, and values pushed just before `TOY_OP_POP_STACK`), sends jumps straight to the end of any chain of jumps, and fuses some common sequences into single instructions, such as `TOY_OP_IF_TRUE_JUMP` and `TOY_OP_SLOT_INCREMENT`.
+!*/
+TOY_API void Toy_optimizeCompiler(Toy_Compiler* compiler);
+
 /*!
 ### unsigned char* Toy_collateCompiler(Toy_Compiler* compiler, size_t* size)
 
@@ -0,0 +1,59 @@
+#include "toy_context.h"
+
+#include <stddef.h>
+
+extern void* Toy_private_defaultMemoryAllocator(void* pointer, size_t oldSize, size_t newSize);
+extern void Toy_private_releaseInternTable();
+
+//shared by every thread that hasn't set a context of its own
+static Toy_Context defaultContext = {
+	.allocator = Toy_private_defaultMemoryAllocator,
+	.refStringAllocator = Toy_private_defaultMemoryAllocator,
+	.refFunctionAllocator = Toy_private_defaultMemoryAllocator,
+	.region = NULL,
+	.internTable = NULL,
+	.internCapacity = 0,
+	.internCount = 0,
+	.internStats = {0, 0, 0, 0},
+	.internLock = ATOMIC_FLAG_INIT,
+};
+
+//the initial-exec model is much faster than a call to __tls_get_addr() on every allocation
+#if defined(__GNUC__) && !defined(_WIN32)
+static _Thread_local Toy_Context* currentContext __attribute__((tls_model("initial-exec"))) = NULL;
+#else
+static _Thread_local Toy_Context* currentContext = NULL;
+#endif
+
+void Toy_initContext(Toy_Context* context) {
+	context->allocator = Toy_private_defaultMemoryAllocator;
+	context->refStringAllocator = Toy_private_defaultMemoryAllocator;
+	context->refFunctionAllocator = Toy_private_defaultMemoryAllocator;
+	context->region = NULL;
+
+	context->internTable = NULL;
+	context->internCapacity = 0;
+	context->internCount = 0;
+	context->internStats = (Toy_RefStringInternStats){0, 0, 0, 0};
+	atomic_flag_clear(&context->internLock);
+}
+
+void Toy_freeContext(Toy_Context* context) {
+	//the region and the table are released by their own modules, from within the context
+	Toy_Context* previous = Toy_setContext(context);
+
+	Toy_private_releaseInternTable();
+	Toy_endMemoryRegion();
+
+	Toy_setContext(previous == context ? NULL : previous);
+}
+
+Toy_Context* Toy_setContext(Toy_Context* context) {
+	Toy_Context* previous = Toy_getContext();
+	currentContext = context;
+	return previous;
+}
+
+Toy_Context* Toy_getContext() {
+	return currentContext != NULL ? currentContext : &defaultContext;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+/*!
+# toy_context.h
+
+This header defines the structure `Toy_Context`, which holds the runtime state that would otherwise be shared by the whole process - the memory allocators, the active memory region (if any), and the intern table of refstrings.
+
+Each thread has a current context, which is where allocations and interning go. A thread starts out using the process' default context, which is shared by every thread that hasn't set one of its own. To run one interpreter per worker thread, give each worker its own context:
+
+```c
+#include "toy_context.h"
+
+void* worker(void* arg) {
+	Toy_Context context;
+	Toy_initContext(&context);
+	Toy_setContext(&context);
+
+	//compile and run scripts as normal here
+
+	Toy_setContext(NULL);
+	Toy_freeContext(&context);
+	return NULL;
+}
+```
+
+Literals may be passed between threads, as the reference counters of refstrings, reffunctions, arrays and dictionaries are atomic - but only between contexts which use the same allocator, and never out of a memory region. Functions carry the scope they were declared in, so they should stay on the thread that created them.
+
+`Toy_commandLine` and the drive system are read-only once set up, so they should be configured before any worker threads start.
+!*/
+
+#include "toy_common.h"
+#include "toy_memory.h"
+#include "toy_refstring.h"
+#include "toy_reffunction.h"
+
+#include <stdatomic.h>
+
+//forward declare, the memory region is private to toy_memory.c
+struct Toy_private_memory_region;
+
+//the Context structure
+typedef struct Toy_Context {
+	//memory
+	Toy_MemoryAllocatorFn allocator;
+	Toy_RefStringAllocatorFn refStringAllocator;
+	Toy_RefFunctionAllocatorFn refFunctionAllocator;
+	struct Toy_private_memory_region* region; //NULL unless a memory region is active
+
+	//the intern table, using linear probing - it only ever holds weak references
+	Toy_RefString** internTable;
+	int internCapacity; //always a power of two
+	int internCount;
+	Toy_RefStringInternStats internStats;
+	atomic_flag internLock; //interned refstrings can be released by other threads
+} Toy_Context;
+
+/*!
+## Defined Functions
+!*/
+
+/*!
+### void Toy_initContext(Toy_Context* context)
+
+This function initializes `context`, with the default memory allocator and an empty intern table.
+!*/
+TOY_API void Toy_initContext(Toy_Context* context);
+
+/*!
+### void Toy_freeContext(Toy_Context* context)
+
+This function ends any memory region active within `context`, and frees its intern table. Anything allocated within the context should be freed first, and it must not be the current context of any thread.
+!*/
+TOY_API void Toy_freeContext(Toy_Context* context);
+
+/*!
+### Toy_Context* Toy_setContext(Toy_Context* context)
+
+This function makes `context` the current context of the calling thread, and returns the previous one. Passing `NULL` returns the thread to the process' default context.
+!*/
+TOY_API Toy_Context* Toy_setContext(Toy_Context* context);
+
+/*!
+### Toy_Context* Toy_getContext()
+
+This function returns the current context of the calling thread.
+!*/
+TOY_API Toy_Context* Toy_getContext();
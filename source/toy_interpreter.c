@@ -11,6 +11,24 @@
 #include <stdio.h>
 #include <string.h>
 
+//the number of identifiers whose location is remembered - each is cached by its hash
+#define LOOKUP_CACHE_SIZE 64
+
+static Toy_private_scope_cache* allocateLookupCache() {
+	Toy_private_scope_cache* cache = TOY_ALLOCATE(Toy_private_scope_cache, LOOKUP_CACHE_SIZE);
+
+	for (int i = 0; i < LOOKUP_CACHE_SIZE; i++) {
+		cache[i].name = TOY_TO_NULL_LITERAL;
+	}
+
+	Toy_private_freeScopeCache(cache, LOOKUP_CACHE_SIZE);
+	return cache;
+}
+
+static Toy_private_scope_cache* lookupCacheOf(Toy_Interpreter* interpreter, Toy_Literal identifier) {
+	return &interpreter->lookupCache[(unsigned int)TOY_HASH_I(identifier) % LOOKUP_CACHE_SIZE];
+}
+
 //printing utilities
 static void printWrapper(const char* output) {
 	//allow for disabling of newlines in the repl
@@ -105,17 +123,49 @@ bool Toy_injectNativeHook(Toy_Interpreter* interpreter, const char* name, Toy_Ho
 bool Toy_parseIdentifierToValue(Toy_Interpreter* interpreter, Toy_Literal* literalPtr) {
 	//this converts identifiers to values
 	if (TOY_IS_IDENTIFIER(*literalPtr)) {
-		if (!Toy_getScopeVariable(interpreter->scope, *literalPtr, literalPtr)) {
+		Toy_private_scope_slot* slot = Toy_private_findScopeVariable(interpreter->scope, *literalPtr, lookupCacheOf(interpreter, *literalPtr));
+
+		if (slot == NULL) {
 			interpreter->errorOutput("Undeclared variable ");
 			Toy_printLiteralCustom(*literalPtr, interpreter->errorOutput);
 			interpreter->errorOutput("\n");
 			return false;
 		}
+
+		*literalPtr = Toy_copyLiteral(slot->value);
 	}
 
 	return true;
 }
 
+//the storage behind a compound changes whenever its contents are modified
+static void* compoundStorage(Toy_Literal literal) {
+	if (TOY_IS_ARRAY(literal)) {
+		return TOY_AS_ARRAY(literal)->literals;
+	}
+
+	if (TOY_IS_DICTIONARY(literal)) {
+		return TOY_AS_DICTIONARY(literal)->entries;
+	}
+
+	return NULL;
+}
+
+void Toy_parseCompoundToValue(Toy_Interpreter* interpreter, Toy_Literal* literalPtr);
+
+static bool compoundNeedsParsing(Toy_Interpreter* interpreter, Toy_Literal literal) {
+	if (!TOY_IS_ARRAY(literal) && !TOY_IS_DICTIONARY(literal)) {
+		return false;
+	}
+
+	Toy_Literal copy = Toy_copyLiteral(literal);
+	Toy_parseCompoundToValue(interpreter, &copy);
+	bool result = compoundStorage(copy) != compoundStorage(literal);
+	Toy_freeLiteral(copy);
+
+	return result;
+}
+
 void Toy_parseCompoundToValue(Toy_Interpreter* interpreter, Toy_Literal* literalPtr) {
 	//parse out an array
 	if (TOY_IS_ARRAY(*literalPtr)) {
@@ -135,9 +185,21 @@ void Toy_parseCompoundToValue(Toy_Interpreter* interpreter, Toy_Literal* literal
 				Toy_freeLiteral(entry);
 			}
 
-			//recurse on sub-compounds
+			//recurse on sub-compounds (these may be shared, so work on a copy)
 			if (TOY_IS_ARRAY(TOY_AS_ARRAY(*literalPtr)->literals[i]) || TOY_IS_DICTIONARY(TOY_AS_ARRAY(*literalPtr)->literals[i])) {
-				Toy_parseCompoundToValue(interpreter, &TOY_AS_ARRAY(*literalPtr)->literals[i]);
+				Toy_Literal index = TOY_TO_INTEGER_LITERAL(i);
+				Toy_Literal entry = Toy_getLiteralArray(TOY_AS_ARRAY(*literalPtr), index);
+
+				void* storage = compoundStorage(entry);
+				Toy_parseCompoundToValue(interpreter, &entry);
+
+				//only write back if something was actually changed
+				if (compoundStorage(entry) != storage) {
+					Toy_setLiteralArray(TOY_AS_ARRAY(*literalPtr), index, entry);
+				}
+
+				Toy_freeLiteral(index);
+				Toy_freeLiteral(entry);
 			}
 		}
 	}
@@ -152,13 +214,10 @@ void Toy_parseCompoundToValue(Toy_Interpreter* interpreter, Toy_Literal* literal
 				break;
 			}
 
-			//recurse on sub-compounds
-			if (TOY_IS_ARRAY(TOY_AS_DICTIONARY(*literalPtr)->entries[i].key) || TOY_IS_DICTIONARY(TOY_AS_DICTIONARY(*literalPtr)->entries[i].key)) {
-				Toy_parseCompoundToValue(interpreter, &TOY_AS_DICTIONARY(*literalPtr)->entries[i].key);
-			}
-
-			if (TOY_IS_ARRAY(TOY_AS_DICTIONARY(*literalPtr)->entries[i].value) || TOY_IS_DICTIONARY(TOY_AS_DICTIONARY(*literalPtr)->entries[i].value)) {
-				Toy_parseCompoundToValue(interpreter, &TOY_AS_DICTIONARY(*literalPtr)->entries[i].value);
+			//check sub-compounds (these may be shared, so work on a copy), and rebuild if any of them changed
+			if (compoundNeedsParsing(interpreter, TOY_AS_DICTIONARY(*literalPtr)->entries[i].key) || compoundNeedsParsing(interpreter, TOY_AS_DICTIONARY(*literalPtr)->entries[i].value)) {
+				idnFound = true;
+				break;
 			}
 		}
 
@@ -169,15 +228,6 @@ void Toy_parseCompoundToValue(Toy_Interpreter* interpreter, Toy_Literal* literal
 		Toy_LiteralDictionary* ret = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
 		Toy_initLiteralDictionary(ret);
 
-		//this basically copies the dict, so preallocate it manually
-		ret->capacity = TOY_AS_DICTIONARY(*literalPtr)->capacity;
-		ret->entries = TOY_ALLOCATE(Toy_private_dictionary_entry, ret->capacity);
-
-		for (int i = 0; i < ret->capacity; i++) {
-			ret->entries[i].key = TOY_TO_NULL_LITERAL;
-			ret->entries[i].value = TOY_TO_NULL_LITERAL;
-		}
-
 		for (int i = 0; i < TOY_AS_DICTIONARY(*literalPtr)->capacity; i++) {
 			if ( TOY_IS_NULL(TOY_AS_DICTIONARY(*literalPtr)->entries[i].key) ) {
 				continue;
@@ -256,6 +306,12 @@ static int readInt(const unsigned char* tb, int* count) {
 	return ret;
 }
 
+//indexes, counts, sizes and jump targets that don't fit into 16 bits are followed by all 32 bits
+static int readIndex(const unsigned char* tb, int* count) {
+	unsigned short ret = readShort(tb, count);
+	return ret != TOY_OPERAND_WIDE ? (int)ret : readInt(tb, count);
+}
+
 static float readFloat(const unsigned char* tb, int* count) {
 	float ret = 0;
 	memcpy(&ret, tb + *count, 4);
@@ -287,6 +343,27 @@ static void consumeShort(Toy_Interpreter* interpreter, unsigned short bytes, con
 	*count += 2;
 }
 
+//the dispatch loop can be threaded with labels-as-values, a GNU extension, by defining TOY_THREADED_DISPATCH (see the makefile)
+#if defined(TOY_THREADED_DISPATCH) && !defined(__GNUC__)
+#undef TOY_THREADED_DISPATCH
+#endif
+
+#ifdef TOY_THREADED_DISPATCH
+
+#define TOY_DISPATCH(op) label_##op:
+#define TOY_DISPATCH_DEFAULT label_unknown:
+#define TOY_DISPATCH_ENTRY(op) [op] = &&label_##op
+#define TOY_DISPATCH_GOTO() goto *(dispatchTable[opcode] != NULL ? dispatchTable[opcode] : &&label_unknown)
+#define TOY_DISPATCH_NEXT opcode = readByte(interpreter->bytecode, &interpreter->count); TOY_DISPATCH_GOTO()
+
+#else
+
+#define TOY_DISPATCH(op) case op:
+#define TOY_DISPATCH_DEFAULT default:
+#define TOY_DISPATCH_NEXT break
+
+#endif
+
 //each available statement
 static bool execAssert(Toy_Interpreter* interpreter) {
 	Toy_Literal rhs = Toy_popLiteralArray(&interpreter->stack);
@@ -343,7 +420,7 @@ static bool execPushLiteral(Toy_Interpreter* interpreter, bool lng) {
 	int index = 0;
 
 	if (lng) {
-		index = (int)readShort(interpreter->bytecode, &interpreter->count);
+		index = readIndex(interpreter->bytecode, &interpreter->count);
 	}
 	else {
 		index = (int)readByte(interpreter->bytecode, &interpreter->count);
@@ -429,6 +506,45 @@ static bool execInvert(Toy_Interpreter* interpreter) {
 	return true;
 }
 
+//a string can be appended to in place when its only other reference belongs to the variable that the result is assigned back into
+static bool isAppendTarget(Toy_Interpreter* interpreter, Toy_Opcode opcode, Toy_RefString* refString) {
+	if (Toy_countRefString(refString) != 2 || refString->interned) {
+		return false;
+	}
+
+	//the variable's identifier is left on the stack by the interjection
+	if (opcode == TOY_OP_VAR_ADDITION_ASSIGN) {
+		Toy_Literal identifier = interpreter->stack.literals[interpreter->stack.count - 1];
+
+		if (!TOY_IS_IDENTIFIER(identifier) || !Toy_isDeclaredScopeVariable(interpreter->scope, identifier)) {
+			return false;
+		}
+
+		Toy_Literal type = Toy_getScopeType(interpreter->scope, identifier);
+		bool result = TOY_IS_TYPE(type) && !TOY_AS_TYPE(type).constant;
+
+		Toy_freeLiteral(type);
+		return result;
+	}
+
+	//otherwise, the next instruction must store the result into the slot that holds this string
+	if (opcode != TOY_OP_ADDITION || interpreter->count + 2 >= interpreter->length || interpreter->bytecode[interpreter->count] != TOY_OP_SLOT_STORE) {
+		return false;
+	}
+
+	int depth = (int)interpreter->bytecode[interpreter->count + 1];
+	int slot = (int)interpreter->bytecode[interpreter->count + 2];
+
+	Toy_Literal type = Toy_getScopeSlotType(interpreter->scope, depth, slot);
+	Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+	bool result = TOY_IS_TYPE(type) && !TOY_AS_TYPE(type).constant && Toy_getScopeSlot(interpreter->scope, depth, slot, &value) && TOY_IS_STRING(value) && TOY_AS_STRING(value) == refString;
+
+	Toy_freeLiteral(type);
+	Toy_freeLiteral(value);
+	return result;
+}
+
 static bool execArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
 	Toy_Literal rhs = Toy_popLiteralArray(&interpreter->stack);
 	Toy_Literal lhs = Toy_popLiteralArray(&interpreter->stack);
@@ -445,17 +561,14 @@ static bool execArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
 
 	//special case for string concatenation ONLY
 	if (TOY_IS_STRING(lhs) && TOY_IS_STRING(rhs) && (opcode == TOY_OP_ADDITION || opcode == TOY_OP_VAR_ADDITION_ASSIGN)) {
-		//check for overflow
-		int totalLength = TOY_AS_STRING(lhs)->length + TOY_AS_STRING(rhs)->length;
-		if (totalLength > TOY_MAX_STRING_LENGTH) {
-			interpreter->errorOutput("Can't concatenate these strings, result is too long (error found in interpreter)\n");
-			return false;
+		//concat the strings, growing the lhs in place where no one else can see it
+		Toy_Literal literal = TOY_TO_NULL_LITERAL;
+		if (isAppendTarget(interpreter, opcode, TOY_AS_STRING(lhs))) {
+			literal = TOY_TO_STRING_LITERAL(Toy_appendRefString(TOY_AS_STRING(lhs), TOY_AS_STRING(rhs)));
+		}
+		else {
+			literal = TOY_TO_STRING_LITERAL(Toy_concatRefString(TOY_AS_STRING(lhs), TOY_AS_STRING(rhs)));
 		}
-
-		//concat the strings
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, TOY_MAX_STRING_LENGTH, "%s%s", Toy_toCString(TOY_AS_STRING(lhs)), Toy_toCString(TOY_AS_STRING(rhs)));
-		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, totalLength));
 		Toy_pushLiteralArray(&interpreter->stack, literal);
 
 		//cleanup
@@ -568,23 +681,8 @@ static bool execArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
 	return false;
 }
 
-static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
-	//read the index in the cache
-	int identifierIndex = 0;
-	int typeIndex = 0;
-
-	if (lng) {
-		identifierIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-		typeIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-	}
-	else {
-		identifierIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
-		typeIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
-	}
-
-	Toy_Literal identifier = Toy_copyLiteral(interpreter->literalCache.literals[identifierIndex]);
-	Toy_Literal type = Toy_copyLiteral(interpreter->literalCache.literals[typeIndex]);
-
+//declares by name, unless the compiler has set aside a slot (-1 for none)
+static bool declareVariable(Toy_Interpreter* interpreter, Toy_Literal identifier, Toy_Literal type, int slot) {
 	Toy_Literal typeIdn = type;
 	if (TOY_IS_IDENTIFIER(type) && Toy_parseIdentifierToValue(interpreter, &type)) {
 		Toy_freeLiteral(typeIdn);
@@ -593,7 +691,7 @@ static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
 	//BUGFIX: because identifiers are getting embedded in type definitions
 	parseTypeToValue(interpreter, &type);
 
-	if (!Toy_declareScopeVariable(interpreter->scope, identifier, type)) {
+	if (slot >= 0 ? !Toy_declareScopeSlot(interpreter->scope, slot, type) : !Toy_declareScopeVariable(interpreter->scope, identifier, type)) {
 		interpreter->errorOutput("Can't redefine the variable \"");
 		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
 		interpreter->errorOutput("\"\n");
@@ -622,7 +720,7 @@ static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
 		val = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(val));
 	}
 
-	if (!TOY_IS_NULL(val) && !Toy_setScopeVariable(interpreter->scope, identifier, val, false)) {
+	if (!TOY_IS_NULL(val) && (slot >= 0 ? !Toy_setScopeSlot(interpreter->scope, 0, slot, val, false) : !Toy_setScopeVariable(interpreter->scope, identifier, val, false))) {
 		interpreter->errorOutput("Incorrect type assigned to variable \"");
 		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
 		interpreter->errorOutput("\"\n");
@@ -641,14 +739,79 @@ static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
 	return true;
 }
 
+static bool execVarDecl(Toy_Interpreter* interpreter, bool lng) {
+	//read the index in the cache
+	int identifierIndex = 0;
+	int typeIndex = 0;
+
+	if (lng) {
+		identifierIndex = readIndex(interpreter->bytecode, &interpreter->count);
+		typeIndex = readIndex(interpreter->bytecode, &interpreter->count);
+	}
+	else {
+		identifierIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
+		typeIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
+	}
+
+	Toy_Literal identifier = Toy_copyLiteral(interpreter->literalCache.literals[identifierIndex]);
+	Toy_Literal type = Toy_copyLiteral(interpreter->literalCache.literals[typeIndex]);
+
+	return declareVariable(interpreter, identifier, type, -1);
+}
+
+static bool execScopeSlots(Toy_Interpreter* interpreter) {
+	int namesIndex = readIndex(interpreter->bytecode, &interpreter->count);
+	int lookupIndex = readIndex(interpreter->bytecode, &interpreter->count);
+
+	Toy_setScopeSlots(interpreter->scope, TOY_AS_ARRAY(interpreter->literalCache.literals[namesIndex]), TOY_AS_DICTIONARY(interpreter->literalCache.literals[lookupIndex]));
+
+	return true;
+}
+
+static bool execSlotDecl(Toy_Interpreter* interpreter) {
+	int slot = (int)readByte(interpreter->bytecode, &interpreter->count);
+	int typeIndex = readIndex(interpreter->bytecode, &interpreter->count);
+
+	Toy_Literal identifier = Toy_getScopeSlotName(interpreter->scope, 0, slot);
+	Toy_Literal type = Toy_copyLiteral(interpreter->literalCache.literals[typeIndex]);
+
+	return declareVariable(interpreter, identifier, type, slot);
+}
+
+static bool loadSlot(Toy_Interpreter* interpreter, int depth, int slot) {
+	Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+	//if the slot hasn't been declared, fall back to searching by name
+	if (!Toy_getScopeSlot(interpreter->scope, depth, slot, &value)) {
+		value = Toy_getScopeSlotName(interpreter->scope, depth, slot);
+
+		if (!TOY_IS_IDENTIFIER(value) || !Toy_parseIdentifierToValue(interpreter, &value)) {
+			Toy_freeLiteral(value);
+			return false;
+		}
+	}
+
+	Toy_pushLiteralArray(&interpreter->stack, value);
+	Toy_freeLiteral(value);
+
+	return true;
+}
+
+static bool execSlotLoad(Toy_Interpreter* interpreter) {
+	int depth = (int)readByte(interpreter->bytecode, &interpreter->count);
+	int slot = (int)readByte(interpreter->bytecode, &interpreter->count);
+
+	return loadSlot(interpreter, depth, slot);
+}
+
 static bool execFnDecl(Toy_Interpreter* interpreter, bool lng) {
 	//read the index in the cache
 	int identifierIndex = 0;
 	int functionIndex = 0;
 
 	if (lng) {
-		identifierIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
-		functionIndex = (int)readShort(interpreter->bytecode, &interpreter->count);
+		identifierIndex = readIndex(interpreter->bytecode, &interpreter->count);
+		functionIndex = readIndex(interpreter->bytecode, &interpreter->count);
 	}
 	else {
 		identifierIndex = (int)readByte(interpreter->bytecode, &interpreter->count);
@@ -721,7 +884,9 @@ static bool execVarAssign(Toy_Interpreter* interpreter) {
 		return false;
 	}
 
-	if (!Toy_isDeclaredScopeVariable(interpreter->scope, lhs)) {
+	Toy_private_scope_slot* slot = TOY_IS_IDENTIFIER(lhs) ? Toy_private_findScopeVariable(interpreter->scope, lhs, lookupCacheOf(interpreter, lhs)) : NULL;
+
+	if (slot == NULL) {
 		interpreter->errorOutput("Undeclared variable \"");
 		Toy_printLiteralCustom(lhs, interpreter->errorOutput);
 		interpreter->errorOutput("\"\n");
@@ -732,29 +897,114 @@ static bool execVarAssign(Toy_Interpreter* interpreter) {
 	}
 
 	//BUGFIX: allow easy coercion on assign
-	Toy_Literal type = Toy_getScopeType(interpreter->scope, lhs);
-	if (TOY_AS_TYPE(type).typeOf == TOY_LITERAL_FLOAT && TOY_IS_INTEGER(rhs)) {
+	if (TOY_AS_TYPE(slot->type).typeOf == TOY_LITERAL_FLOAT && TOY_IS_INTEGER(rhs)) {
 		rhs = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(rhs));
 	}
 
-	if (!Toy_setScopeVariable(interpreter->scope, lhs, rhs, true)) {
+	if (!Toy_private_setScopeSlotValue(slot, rhs, true)) {
 		interpreter->errorOutput("Incorrect type assigned to variable \"");
 		Toy_printLiteralCustom(lhs, interpreter->errorOutput);
 		interpreter->errorOutput("\"\n");
 
 		Toy_freeLiteral(lhs);
 		Toy_freeLiteral(rhs);
-		Toy_freeLiteral(type);
 		return false;
 	}
 
 	Toy_freeLiteral(lhs);
+	Toy_freeLiteral(rhs);
+
+	return true;
+}
+
+static bool storeSlot(Toy_Interpreter* interpreter, int depth, int slot) {
+	Toy_Literal type = Toy_getScopeSlotType(interpreter->scope, depth, slot);
+
+	//if the slot hasn't been declared, fall back to assigning by name
+	if (TOY_IS_NULL(type)) {
+		Toy_Literal identifier = Toy_getScopeSlotName(interpreter->scope, depth, slot);
+		Toy_Literal rhs = Toy_popLiteralArray(&interpreter->stack);
+
+		Toy_pushLiteralArray(&interpreter->stack, identifier);
+		Toy_pushLiteralArray(&interpreter->stack, rhs);
+
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(rhs);
+
+		return execVarAssign(interpreter);
+	}
+
+	Toy_Literal rhs = Toy_popLiteralArray(&interpreter->stack);
+
+	Toy_Literal rhsIdn = rhs;
+	if (TOY_IS_IDENTIFIER(rhs) && Toy_parseIdentifierToValue(interpreter, &rhs)) {
+		Toy_freeLiteral(rhsIdn);
+	}
+
+	if (TOY_IS_ARRAY(rhs) || TOY_IS_DICTIONARY(rhs)) {
+		Toy_parseCompoundToValue(interpreter, &rhs);
+	}
+
+	//BUGFIX: allow easy coercion on assign
+	if (TOY_AS_TYPE(type).typeOf == TOY_LITERAL_FLOAT && TOY_IS_INTEGER(rhs)) {
+		rhs = TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(rhs));
+	}
+
+	if (!Toy_setScopeSlot(interpreter->scope, depth, slot, rhs, true)) {
+		Toy_Literal identifier = Toy_getScopeSlotName(interpreter->scope, depth, slot);
+
+		interpreter->errorOutput("Incorrect type assigned to variable \"");
+		Toy_printLiteralCustom(identifier, interpreter->errorOutput);
+		interpreter->errorOutput("\"\n");
+
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(rhs);
+		Toy_freeLiteral(type);
+		return false;
+	}
+
 	Toy_freeLiteral(rhs);
 	Toy_freeLiteral(type);
 
 	return true;
 }
 
+static bool execSlotStore(Toy_Interpreter* interpreter) {
+	int depth = (int)readByte(interpreter->bytecode, &interpreter->count);
+	int slot = (int)readByte(interpreter->bytecode, &interpreter->count);
+
+	return storeSlot(interpreter, depth, slot);
+}
+
+static bool execSlotIncrement(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	int depth = (int)readByte(interpreter->bytecode, &interpreter->count);
+	int slot = (int)readByte(interpreter->bytecode, &interpreter->count);
+
+	int delta = opcode == TOY_OP_SLOT_INCREMENT ? 1 : -1;
+	Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+	//integers can skip the stack
+	if (Toy_getScopeSlot(interpreter->scope, depth, slot, &value) && TOY_IS_INTEGER(value)) {
+		Toy_pushLiteralArray(&interpreter->stack, TOY_TO_INTEGER_LITERAL(TOY_AS_INTEGER(value) + delta));
+		return storeSlot(interpreter, depth, slot);
+	}
+
+	Toy_freeLiteral(value);
+
+	//anything else does what the fused instructions would have done
+	if (!loadSlot(interpreter, depth, slot)) {
+		return false;
+	}
+
+	Toy_pushLiteralArray(&interpreter->stack, TOY_TO_INTEGER_LITERAL(1));
+
+	if (!execArithmetic(interpreter, delta > 0 ? TOY_OP_ADDITION : TOY_OP_SUBTRACTION)) {
+		return false;
+	}
+
+	return storeSlot(interpreter, depth, slot);
+}
+
 static bool execVarArithmeticAssignInterjection(Toy_Interpreter* interpreter) {
 	Toy_Literal rhs = Toy_popLiteralArray(&interpreter->stack);
 	Toy_Literal lhs = Toy_popLiteralArray(&interpreter->stack);
@@ -1064,6 +1314,162 @@ static bool execCompareLessEqual(Toy_Interpreter* interpreter, bool invert) {
 	return true;
 }
 
+//quickening - the generic arithmetic and comparison opcodes rewrite themselves once they've seen two numbers of the same type, and the quickened opcodes rewrite themselves back when that stops being true
+static void rewriteOpcode(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	//borrowed bytecode is never written to, so the top level of those scripts isn't quickened
+	if (interpreter->bytecode == interpreter->readOnlyCode) {
+		return;
+	}
+
+	//the opcode was just read; the interpreter owns the bytecode, and each function's code is its own copy
+	((unsigned char*)interpreter->bytecode)[interpreter->count - 1] = (unsigned char)opcode;
+}
+
+static bool operandsAre(Toy_Interpreter* interpreter, Toy_LiteralType type) {
+	//identifiers aren't resolved here, so they'll always take the generic path
+	return interpreter->stack.count >= 2 && interpreter->stack.literals[interpreter->stack.count - 1].type == type && interpreter->stack.literals[interpreter->stack.count - 2].type == type;
+}
+
+static void quickenArithmetic(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	if (operandsAre(interpreter, TOY_LITERAL_INTEGER)) {
+		rewriteOpcode(interpreter, TOY_OP_ADDITION_INTEGER + (opcode - TOY_OP_ADDITION));
+	}
+	else if (operandsAre(interpreter, TOY_LITERAL_FLOAT) && opcode != TOY_OP_MODULO) {
+		rewriteOpcode(interpreter, TOY_OP_ADDITION_FLOAT + (opcode - TOY_OP_ADDITION));
+	}
+}
+
+static void quickenComparison(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	if (operandsAre(interpreter, TOY_LITERAL_INTEGER)) {
+		rewriteOpcode(interpreter, TOY_OP_COMPARE_LESS_INTEGER + (opcode - TOY_OP_COMPARE_LESS));
+	}
+	else if (operandsAre(interpreter, TOY_LITERAL_FLOAT)) {
+		rewriteOpcode(interpreter, TOY_OP_COMPARE_LESS_FLOAT + (opcode - TOY_OP_COMPARE_LESS));
+	}
+}
+
+//replace the two operands on the stack with the result - these are all plain values, so nothing needs freeing
+static void replaceOperands(Toy_Interpreter* interpreter, Toy_Literal result) {
+	Toy_unshareLiteralArray(&interpreter->stack);
+
+	interpreter->stack.count--;
+	interpreter->stack.literals[interpreter->stack.count - 1] = result;
+	interpreter->stack.literals[interpreter->stack.count] = TOY_TO_NULL_LITERAL;
+}
+
+static bool execArithmeticInteger(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	Toy_Opcode generic = TOY_OP_ADDITION + (opcode - TOY_OP_ADDITION_INTEGER);
+
+	//guard, which also leaves division by zero to the generic path's error
+	if (!operandsAre(interpreter, TOY_LITERAL_INTEGER) || ((opcode == TOY_OP_DIVISION_INTEGER || opcode == TOY_OP_MODULO_INTEGER) && TOY_AS_INTEGER(interpreter->stack.literals[interpreter->stack.count - 1]) == 0)) {
+		rewriteOpcode(interpreter, generic);
+		return execArithmetic(interpreter, generic);
+	}
+
+	int lhs = TOY_AS_INTEGER(interpreter->stack.literals[interpreter->stack.count - 2]);
+	int rhs = TOY_AS_INTEGER(interpreter->stack.literals[interpreter->stack.count - 1]);
+
+	switch(opcode) {
+		case TOY_OP_ADDITION_INTEGER:
+			replaceOperands(interpreter, TOY_TO_INTEGER_LITERAL(lhs + rhs));
+			return true;
+
+		case TOY_OP_SUBTRACTION_INTEGER:
+			replaceOperands(interpreter, TOY_TO_INTEGER_LITERAL(lhs - rhs));
+			return true;
+
+		case TOY_OP_MULTIPLICATION_INTEGER:
+			replaceOperands(interpreter, TOY_TO_INTEGER_LITERAL(lhs * rhs));
+			return true;
+
+		case TOY_OP_DIVISION_INTEGER:
+			replaceOperands(interpreter, TOY_TO_INTEGER_LITERAL(lhs / rhs));
+			return true;
+
+		case TOY_OP_MODULO_INTEGER:
+			replaceOperands(interpreter, TOY_TO_INTEGER_LITERAL(lhs % rhs));
+			return true;
+
+		default:
+			interpreter->errorOutput("[internal] bad opcode argument passed to execArithmeticInteger()\n");
+			return false;
+	}
+}
+
+static bool execArithmeticFloat(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	Toy_Opcode generic = TOY_OP_ADDITION + (opcode - TOY_OP_ADDITION_FLOAT);
+
+	//guard, which also leaves division by zero to the generic path's error
+	if (!operandsAre(interpreter, TOY_LITERAL_FLOAT) || (opcode == TOY_OP_DIVISION_FLOAT && TOY_AS_FLOAT(interpreter->stack.literals[interpreter->stack.count - 1]) == 0)) {
+		rewriteOpcode(interpreter, generic);
+		return execArithmetic(interpreter, generic);
+	}
+
+	float lhs = TOY_AS_FLOAT(interpreter->stack.literals[interpreter->stack.count - 2]);
+	float rhs = TOY_AS_FLOAT(interpreter->stack.literals[interpreter->stack.count - 1]);
+
+	switch(opcode) {
+		case TOY_OP_ADDITION_FLOAT:
+			replaceOperands(interpreter, TOY_TO_FLOAT_LITERAL(lhs + rhs));
+			return true;
+
+		case TOY_OP_SUBTRACTION_FLOAT:
+			replaceOperands(interpreter, TOY_TO_FLOAT_LITERAL(lhs - rhs));
+			return true;
+
+		case TOY_OP_MULTIPLICATION_FLOAT:
+			replaceOperands(interpreter, TOY_TO_FLOAT_LITERAL(lhs * rhs));
+			return true;
+
+		case TOY_OP_DIVISION_FLOAT:
+			replaceOperands(interpreter, TOY_TO_FLOAT_LITERAL(lhs / rhs));
+			return true;
+
+		default:
+			interpreter->errorOutput("[internal] bad opcode argument passed to execArithmeticFloat()\n");
+			return false;
+	}
+}
+
+static bool execCompareQuickened(Toy_Interpreter* interpreter, Toy_Opcode opcode) {
+	bool integers = opcode < TOY_OP_COMPARE_LESS_FLOAT;
+	Toy_Opcode generic = TOY_OP_COMPARE_LESS + (opcode - (integers ? TOY_OP_COMPARE_LESS_INTEGER : TOY_OP_COMPARE_LESS_FLOAT));
+
+	if (!operandsAre(interpreter, integers ? TOY_LITERAL_INTEGER : TOY_LITERAL_FLOAT)) {
+		rewriteOpcode(interpreter, generic);
+		return generic == TOY_OP_COMPARE_LESS || generic == TOY_OP_COMPARE_GREATER ? execCompareLess(interpreter, generic == TOY_OP_COMPARE_GREATER) : execCompareLessEqual(interpreter, generic == TOY_OP_COMPARE_GREATER_EQUAL);
+	}
+
+	//integers are compared as floats, the same as the generic path
+	Toy_Literal lhsLiteral = interpreter->stack.literals[interpreter->stack.count - 2];
+	Toy_Literal rhsLiteral = interpreter->stack.literals[interpreter->stack.count - 1];
+
+	float lhs = integers ? (float)TOY_AS_INTEGER(lhsLiteral) : TOY_AS_FLOAT(lhsLiteral);
+	float rhs = integers ? (float)TOY_AS_INTEGER(rhsLiteral) : TOY_AS_FLOAT(rhsLiteral);
+
+	switch(generic) {
+		case TOY_OP_COMPARE_LESS:
+			replaceOperands(interpreter, TOY_TO_BOOLEAN_LITERAL(lhs < rhs));
+			return true;
+
+		case TOY_OP_COMPARE_LESS_EQUAL:
+			replaceOperands(interpreter, TOY_TO_BOOLEAN_LITERAL(lhs <= rhs));
+			return true;
+
+		case TOY_OP_COMPARE_GREATER:
+			replaceOperands(interpreter, TOY_TO_BOOLEAN_LITERAL(lhs > rhs));
+			return true;
+
+		case TOY_OP_COMPARE_GREATER_EQUAL:
+			replaceOperands(interpreter, TOY_TO_BOOLEAN_LITERAL(lhs >= rhs));
+			return true;
+
+		default:
+			interpreter->errorOutput("[internal] bad opcode argument passed to execCompareQuickened()\n");
+			return false;
+	}
+}
+
 static bool execAnd(Toy_Interpreter* interpreter) {
 	Toy_Literal lhs = Toy_popLiteralArray(&interpreter->stack);
 
@@ -1076,7 +1482,7 @@ static bool execAnd(Toy_Interpreter* interpreter) {
 	if (!TOY_IS_TRUTHY(lhs)) {
 		Toy_pushLiteralArray(&interpreter->stack, lhs);
 
-		int target = (int)readShort(interpreter->bytecode, &interpreter->count);
+		int target = readIndex(interpreter->bytecode, &interpreter->count);
 
 		if (target + interpreter->codeStart > interpreter->length) {
 			interpreter->errorOutput("[internal] AND Jump out of range\n");
@@ -1087,7 +1493,7 @@ static bool execAnd(Toy_Interpreter* interpreter) {
 		interpreter->count = target + interpreter->codeStart;
 	}
 	else {
-		readShort(interpreter->bytecode, &interpreter->count); //discard
+		readIndex(interpreter->bytecode, &interpreter->count); //discard
 	}
 
 	Toy_freeLiteral(lhs);
@@ -1107,7 +1513,7 @@ static bool execOr(Toy_Interpreter* interpreter) {
 	if (TOY_IS_TRUTHY(lhs)) {
 		Toy_pushLiteralArray(&interpreter->stack, lhs);
 
-		int target = (int)readShort(interpreter->bytecode, &interpreter->count);
+		int target = readIndex(interpreter->bytecode, &interpreter->count);
 
 		if (target + interpreter->codeStart > interpreter->length) {
 			interpreter->errorOutput("[internal] OR Jump out of range\n");
@@ -1118,7 +1524,7 @@ static bool execOr(Toy_Interpreter* interpreter) {
 		interpreter->count = target + interpreter->codeStart;
 	}
 	else {
-		readShort(interpreter->bytecode, &interpreter->count); //discard
+		readIndex(interpreter->bytecode, &interpreter->count); //discard
 	}
 
 	Toy_freeLiteral(lhs);
@@ -1127,7 +1533,7 @@ static bool execOr(Toy_Interpreter* interpreter) {
 }
 
 static bool execJump(Toy_Interpreter* interpreter) {
-	int target = (int)readShort(interpreter->bytecode, &interpreter->count);
+	int target = readIndex(interpreter->bytecode, &interpreter->count);
 
 	if (target + interpreter->codeStart > interpreter->length) {
 		interpreter->errorOutput("[internal] Jump out of range\n");
@@ -1141,7 +1547,7 @@ static bool execJump(Toy_Interpreter* interpreter) {
 }
 
 static bool execJumpIfFalse(Toy_Interpreter* interpreter) {
-	int target = (int)readShort(interpreter->bytecode, &interpreter->count);
+	int target = readIndex(interpreter->bytecode, &interpreter->count);
 
 	if (target + interpreter->codeStart > interpreter->length) {
 		interpreter->errorOutput("[internal] Jump out of range (false jump)\n");
@@ -1171,11 +1577,326 @@ static bool execJumpIfFalse(Toy_Interpreter* interpreter) {
 	return true;
 }
 
-//expect stack: identifier, arg1, arg2, arg3..., stackSize
-//also supports identifier & arg1 to be other way around (looseFirstArgument)
-static bool execFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument) {
-	//BUGFIX: depth check - don't drown!
-	if (interpreter->depth >= 1000) {
+//INVERT and IF_FALSE_JUMP, fused by the optimizer
+static bool execJumpIfTrue(Toy_Interpreter* interpreter) {
+	int target = readIndex(interpreter->bytecode, &interpreter->count);
+
+	if (target + interpreter->codeStart > interpreter->length) {
+		interpreter->errorOutput("[internal] Jump out of range (true jump)\n");
+		return false;
+	}
+
+	//actually jump
+	Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
+
+	Toy_Literal litIdn = lit;
+	if (TOY_IS_IDENTIFIER(lit) && Toy_parseIdentifierToValue(interpreter, &lit)) {
+		Toy_freeLiteral(litIdn);
+	}
+
+	if (!TOY_IS_BOOLEAN(lit)) {
+		interpreter->errorOutput("Can't invert that literal: ");
+		Toy_printLiteralCustom(lit, interpreter->errorOutput);
+		interpreter->errorOutput("\n");
+
+		Toy_freeLiteral(lit);
+		return false;
+	}
+
+	if (TOY_AS_BOOLEAN(lit)) {
+		interpreter->count = target + interpreter->codeStart;
+	}
+
+	Toy_freeLiteral(lit);
+
+	return true;
+}
+
+//expect stack: identifier, arg1, arg2, arg3..., stackSize
+//also supports identifier & arg1 to be other way around (looseFirstArgument)
+//functions run within the caller's interpreter, each in its own call frame
+static void readInterpreterSections(Toy_Interpreter* interpreter);
+
+//point the callee at the function's code, and declare the parameters in a new scope - the arguments are resolved within the caller's scope
+static bool enterFunction(Toy_Interpreter* caller, Toy_Interpreter* callee, Toy_Literal func, Toy_LiteralArray* arguments, Toy_LiteralArray** returnArrayPtr) {
+	Toy_RefFunction* refFunction = (Toy_RefFunction*)(TOY_AS_FUNCTION(func).inner.ptr);
+	Toy_Scope* scope = Toy_pushScope(TOY_AS_FUNCTION(func).scope);
+
+	callee->bytecode = refFunction->data;
+	callee->length = refFunction->length;
+	callee->count = 0;
+
+	//prep the sections - these are decoded only once, then shared read-only between calls
+	if (refFunction->literalCache == NULL) {
+		Toy_initLiteralArray(&callee->literalCache);
+		readInterpreterSections(callee);
+
+		refFunction->literalCache = TOY_ALLOCATE(Toy_LiteralArray, 1);
+		*refFunction->literalCache = callee->literalCache; //ownership moves to the refFunction
+		refFunction->codeStart = callee->count;
+	}
+	else {
+		callee->literalCache = *refFunction->literalCache; //NOTE: shallow copy, never freed by the callee
+		callee->count = refFunction->codeStart;
+	}
+
+	//prep the arguments
+	Toy_LiteralArray* paramArray = TOY_AS_ARRAY(callee->literalCache.literals[ readIndex(callee->bytecode, &callee->count) ]);
+	Toy_LiteralArray* returnArray = TOY_AS_ARRAY(callee->literalCache.literals[ readIndex(callee->bytecode, &callee->count) ]);
+
+	//jumps are relative to this point, even when the slots are read early
+	callee->codeStart = callee->count;
+
+	//give the function's scope its slots, before the parameters are declared into them
+	if (callee->count < callee->length && callee->bytecode[callee->count] == TOY_OP_SCOPE_SLOTS) {
+		callee->count++;
+		int namesIndex = readIndex(callee->bytecode, &callee->count);
+		int lookupIndex = readIndex(callee->bytecode, &callee->count);
+		Toy_setScopeSlots(scope, TOY_AS_ARRAY(callee->literalCache.literals[namesIndex]), TOY_AS_DICTIONARY(callee->literalCache.literals[lookupIndex]));
+	}
+
+	//get the rest param, if it exists
+	Toy_Literal restParam = TOY_TO_NULL_LITERAL;
+	if (paramArray->count >= 2 && TOY_AS_TYPE(paramArray->literals[ paramArray->count -1 ]).typeOf == TOY_LITERAL_FUNCTION_ARG_REST) {
+		restParam = paramArray->literals[ paramArray->count -2 ];
+	}
+
+	//check the param total is correct
+	if ((TOY_IS_NULL(restParam) && paramArray->count != arguments->count * 2) || (!TOY_IS_NULL(restParam) && paramArray->count -2 > arguments->count * 2)) {
+		caller->errorOutput("Incorrect number of arguments passed to a function\n");
+
+		//free, and skip out
+		Toy_popScope(scope);
+		return false;
+	}
+
+	//BUGFIX: access the arguments from the beginning
+	int argumentIndex = 0;
+
+	//contents is the indexes of identifier & type
+	for (int i = 0; i < paramArray->count - (TOY_IS_NULL(restParam) ? 0 : 2); i += 2) { //don't count the rest parameter, if present
+		//declare and define each entry in the scope
+		if (!Toy_declareScopeVariable(scope, paramArray->literals[i], paramArray->literals[i + 1])) {
+			caller->errorOutput("[internal] Could not re-declare parameter\n");
+
+			//free, and skip out
+			Toy_popScope(scope);
+			return false;
+		}
+
+		//access the arguments in order
+		Toy_Literal arg = TOY_TO_NULL_LITERAL;
+		if (argumentIndex < arguments->count) {
+			arg = Toy_copyLiteral(arguments->literals[argumentIndex++]);
+		}
+
+		Toy_Literal argIdn = arg;
+		if (TOY_IS_IDENTIFIER(arg) && Toy_parseIdentifierToValue(caller, &arg)) {
+			Toy_freeLiteral(argIdn);
+		}
+
+		//BUGFIX: coerce ints to floats, if the function requires floats
+		if (TOY_IS_INTEGER(arg) && TOY_IS_TYPE(paramArray->literals[i + 1]) && TOY_AS_TYPE(paramArray->literals[i + 1]).typeOf == TOY_LITERAL_FLOAT) {
+			Toy_Literal f = TOY_TO_FLOAT_LITERAL( (float)TOY_AS_INTEGER(arg) );
+			Toy_freeLiteral(arg);
+			arg = f;
+		}
+
+		if (!Toy_setScopeVariable(scope, paramArray->literals[i], arg, false)) {
+			caller->errorOutput("[internal] Could not define parameter (bad type?)\n");
+
+			//free, and skip out
+			Toy_freeLiteral(arg);
+			Toy_popScope(scope);
+			return false;
+		}
+		Toy_freeLiteral(arg);
+	}
+
+	//if using rest, pack the optional extra arguments into the rest parameter (array)
+	if (!TOY_IS_NULL(restParam)) {
+		Toy_LiteralArray rest;
+		Toy_initLiteralArray(&rest);
+
+		//access the arguments in order
+		while (argumentIndex < arguments->count) {
+			Toy_Literal lit = Toy_copyLiteral(arguments->literals[argumentIndex++]);
+			Toy_pushLiteralArray(&rest, lit);
+			Toy_freeLiteral(lit);
+		}
+
+		Toy_Literal restType = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ARRAY, true);
+		Toy_Literal any = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false);
+		TOY_TYPE_PUSH_SUBTYPE(&restType, any);
+
+		//declare & define the rest parameter
+		if (!Toy_declareScopeVariable(scope, restParam, restType)) {
+			caller->errorOutput("[internal] Could not declare rest parameter\n");
+
+			//free, and skip out
+			Toy_freeLiteral(restType);
+			Toy_freeLiteralArray(&rest);
+			Toy_popScope(scope);
+			return false;
+		}
+
+		Toy_Literal lit = TOY_TO_ARRAY_LITERAL(&rest);
+		if (!Toy_setScopeVariable(scope, restParam, lit, false)) {
+			caller->errorOutput("[internal] Could not define rest parameter\n");
+
+			//free, and skip out
+			Toy_freeLiteral(restType);
+			Toy_freeLiteral(lit);
+			Toy_popScope(scope);
+			return false;
+		}
+
+		Toy_freeLiteral(restType);
+		Toy_freeLiteralArray(&rest);
+	}
+
+	callee->scope = scope;
+	*returnArrayPtr = returnArray;
+	return true;
+}
+
+//check the function's result against its return type, before handing it to the caller
+static void returnFunctionResult(Toy_Interpreter* interpreter, Toy_LiteralArray* returnArray, Toy_Literal ret, Toy_LiteralArray* returns) {
+	//BUGFIX: coerce the returned integers to floats, if specified
+	if (returnArray->count > 0 && TOY_AS_TYPE(returnArray->literals[0]).typeOf == TOY_LITERAL_FLOAT && TOY_IS_INTEGER(ret)) {
+		ret = TOY_TO_FLOAT_LITERAL( (float)TOY_AS_INTEGER(ret) );
+	}
+
+	//check the return types
+	if (returnArray->count > 0 && TOY_AS_TYPE(returnArray->literals[0]).typeOf != ret.type) {
+		interpreter->errorOutput("Bad type found in return value\n");
+		return;
+	}
+
+	Toy_pushLiteralArray(returns, ret);
+}
+
+//unwind the scopes of a function, up to the scope it was declared in
+static Toy_Scope* leaveFunctionScopes(Toy_Scope* scope, Toy_Scope* functionScope) {
+	//BUGFIX: handle scopes of functions, which refer to the parent scope (leaking memory)
+	while(scope != functionScope) {
+		//both the compiler's slots and the named variables are stored in slots
+		for (int i = 0; i < scope->slotCount; i++) {
+			if (TOY_IS_FUNCTION(scope->slots[i].value)) {
+				Toy_popScope(TOY_AS_FUNCTION(scope->slots[i].value).scope);
+				TOY_AS_FUNCTION(scope->slots[i].value).scope = NULL;
+			}
+		}
+
+		scope = Toy_popScope(scope);
+	}
+
+	return scope;
+}
+
+//Toy-to-Toy calls don't use the C stack, but unbounded recursion would still use up all of the memory
+#define TOY_MAX_CALL_FRAMES 200000
+
+//save the caller's position, and move into the function
+static bool pushCallFrame(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments, int* intermediateAssignDepth) {
+	if (interpreter->frameCount >= TOY_MAX_CALL_FRAMES) {
+		interpreter->errorOutput("Infinite recursion detected - panicking\n");
+		interpreter->panic = true;
+		return false;
+	}
+
+	if (interpreter->frameCount + 1 > interpreter->frameCapacity) {
+		int oldCapacity = interpreter->frameCapacity;
+
+		interpreter->frameCapacity = TOY_GROW_CAPACITY(oldCapacity);
+		interpreter->frames = TOY_GROW_ARRAY(Toy_private_interpreter_frame, interpreter->frames, oldCapacity, interpreter->frameCapacity);
+	}
+
+	Toy_private_interpreter_frame* frame = &interpreter->frames[interpreter->frameCount];
+
+	frame->bytecode = interpreter->bytecode;
+	frame->length = interpreter->length;
+	frame->count = interpreter->count;
+	frame->codeStart = interpreter->codeStart;
+	frame->literalCache = interpreter->literalCache;
+	frame->scope = interpreter->scope;
+	frame->stackBase = interpreter->stackBase;
+	frame->intermediateAssignDepth = *intermediateAssignDepth;
+
+	if (!enterFunction(interpreter, interpreter, func, arguments, &frame->returnArray)) {
+		//restore the caller's position
+		interpreter->bytecode = frame->bytecode;
+		interpreter->length = frame->length;
+		interpreter->count = frame->count;
+		interpreter->codeStart = frame->codeStart;
+		interpreter->literalCache = frame->literalCache;
+		return false;
+	}
+
+	frame->function = Toy_copyRefFunction(TOY_AS_FUNCTION(func).inner.ptr);
+	frame->functionScope = TOY_AS_FUNCTION(func).scope;
+	interpreter->frameCount++;
+	interpreter->stackBase = interpreter->stack.count;
+	*intermediateAssignDepth = 0;
+
+	return true;
+}
+
+//return to the caller's position, optionally passing on the function's result
+static void popCallFrame(Toy_Interpreter* interpreter, bool passResult, int* intermediateAssignDepth) {
+	Toy_private_interpreter_frame* frame = &interpreter->frames[--interpreter->frameCount];
+
+	//the result is whatever is left on top of the function's part of the stack
+	Toy_Literal ret = TOY_TO_NULL_LITERAL;
+	if (interpreter->stack.count > interpreter->stackBase) {
+		ret = Toy_popLiteralArray(&interpreter->stack);
+	}
+
+	while (interpreter->stack.count > interpreter->stackBase) {
+		Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
+	}
+
+	leaveFunctionScopes(interpreter->scope, frame->functionScope);
+
+	interpreter->bytecode = frame->bytecode;
+	interpreter->length = frame->length;
+	interpreter->count = frame->count;
+	interpreter->codeStart = frame->codeStart;
+	interpreter->literalCache = frame->literalCache;
+	interpreter->scope = frame->scope;
+	interpreter->stackBase = frame->stackBase;
+	*intermediateAssignDepth = frame->intermediateAssignDepth;
+
+	if (passResult) {
+		returnFunctionResult(interpreter, frame->returnArray, ret, &interpreter->stack);
+	}
+
+	Toy_freeLiteral(ret);
+	Toy_deleteRefFunction(frame->function);
+}
+
+//leave the function that just finished or failed, and return true if its caller can carry on
+static bool leaveCallFrame(Toy_Interpreter* interpreter, int entryFrameCount, int* intermediateAssignDepth) {
+	//frames pushed before this loop began belong to someone else
+	if (interpreter->frameCount <= entryFrameCount) {
+		return false;
+	}
+
+	//a panic discards every frame this loop is responsible for
+	if (interpreter->panic) {
+		while (interpreter->frameCount > entryFrameCount) {
+			popCallFrame(interpreter, false, intermediateAssignDepth);
+		}
+		return false;
+	}
+
+	popCallFrame(interpreter, true, intermediateAssignDepth);
+	return true;
+}
+
+static bool execFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument, int* intermediateAssignDepth) {
+	//BUGFIX: depth check - don't drown!
+	if (interpreter->depth >= 1000) {
 		interpreter->errorOutput("Infinite recursion detected - panicking\n");
 		interpreter->panic = true;
 		return false;
@@ -1236,8 +1957,14 @@ static bool execFnCall(Toy_Interpreter* interpreter, bool looseFirstArgument) {
 		Toy_freeLiteral(lit);
 	}
 
-	//call the function literal
-	bool ret = Toy_callLiteralFn(interpreter, func, &correct, &interpreter->stack);
+	//call the function literal - Toy functions carry on within this interpreter
+	bool ret;
+	if (TOY_IS_FUNCTION(func)) {
+		ret = pushCallFrame(interpreter, func, &correct, intermediateAssignDepth);
+	}
+	else {
+		ret = Toy_callLiteralFn(interpreter, func, &correct, &interpreter->stack);
+	}
 
 	if (!ret) {
 		interpreter->errorOutput("Error encountered in function \"");
@@ -1257,8 +1984,8 @@ static bool execFnReturn(Toy_Interpreter* interpreter) {
 	Toy_LiteralArray returns;
 	Toy_initLiteralArray(&returns);
 
-	//get the values of everything on the stack
-	while (interpreter->stack.count > 0) {
+	//get the values of everything on the function's part of the stack
+	while (interpreter->stack.count > interpreter->stackBase) {
 		Toy_Literal lit = Toy_popLiteralArray(&interpreter->stack);
 
 		Toy_Literal litIdn = lit;
@@ -1354,16 +2081,15 @@ static bool execIndex(Toy_Interpreter* interpreter, bool assignIntermediate) {
 		return false;
 	}
 
-	//build the argument list
-	Toy_LiteralArray arguments;
-	Toy_initLiteralArray(&arguments);
+	//build the argument list, reusing the interpreter's buffer - _index pops every argument, leaving it empty again
+	Toy_LiteralArray* arguments = &interpreter->indexArguments;
 
-	Toy_pushLiteralArray(&arguments, compound);
-	Toy_pushLiteralArray(&arguments, first);
-	Toy_pushLiteralArray(&arguments, second);
-	Toy_pushLiteralArray(&arguments, third);
-	Toy_pushLiteralArray(&arguments, TOY_TO_NULL_LITERAL); //it expects an assignment command
-	Toy_pushLiteralArray(&arguments, TOY_TO_NULL_LITERAL); //it expects an assignment "opcode"
+	Toy_pushLiteralArray(arguments, compound);
+	Toy_pushLiteralArray(arguments, first);
+	Toy_pushLiteralArray(arguments, second);
+	Toy_pushLiteralArray(arguments, third);
+	Toy_pushLiteralArray(arguments, TOY_TO_NULL_LITERAL); //it expects an assignment command
+	Toy_pushLiteralArray(arguments, TOY_TO_NULL_LITERAL); //it expects an assignment "opcode"
 
 	//leave the idn and compound on the stack
 	if (assignIntermediate) {
@@ -1377,7 +2103,7 @@ static bool execIndex(Toy_Interpreter* interpreter, bool assignIntermediate) {
 	}
 
 	//call the index function
-	if (Toy_private_index(interpreter, &arguments) < 0) {
+	if (Toy_private_index(interpreter, arguments) < 0) {
 		interpreter->errorOutput("Something went wrong while indexing (simple index): ");
 		Toy_printLiteralCustom(compoundIdn, interpreter->errorOutput);
 		interpreter->errorOutput("\n");
@@ -1390,7 +2116,6 @@ static bool execIndex(Toy_Interpreter* interpreter, bool assignIntermediate) {
 		if (freeIdn) {
 			Toy_freeLiteral(compoundIdn);
 		}
-		Toy_freeLiteralArray(&arguments);
 		return false;
 	}
 
@@ -1402,7 +2127,6 @@ static bool execIndex(Toy_Interpreter* interpreter, bool assignIntermediate) {
 	if (freeIdn) {
 		Toy_freeLiteral(compoundIdn);
 	}
-	Toy_freeLiteralArray(&arguments);
 
 	return true;
 }
@@ -1580,6 +2304,11 @@ static bool execIndexAssign(Toy_Interpreter* interpreter, int assignDepth) {
 }
 
 //the heart of toy
+#ifdef TOY_THREADED_DISPATCH
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
 static void execInterpreter(Toy_Interpreter* interpreter) {
 	//set the starting point for the interpreter
 	if (interpreter->codeStart == -1) {
@@ -1589,251 +2318,446 @@ static void execInterpreter(Toy_Interpreter* interpreter) {
 	//BUGFIX
 	int intermediateAssignDepth = 0;
 
+	//functions called from here are run by this loop, until they return
+	int entryFrameCount = interpreter->frameCount;
+
 	unsigned char opcode = readByte(interpreter->bytecode, &interpreter->count);
 
+#ifdef TOY_THREADED_DISPATCH
+	//each instruction jumps straight to the next one's label
+	static const void* dispatchTable[TOY_OP_SECTION_END + 1] = {
+		TOY_DISPATCH_ENTRY(TOY_OP_EOF),
+		TOY_DISPATCH_ENTRY(TOY_OP_PASS),
+		TOY_DISPATCH_ENTRY(TOY_OP_ASSERT),
+		TOY_DISPATCH_ENTRY(TOY_OP_PRINT),
+		TOY_DISPATCH_ENTRY(TOY_OP_LITERAL),
+		TOY_DISPATCH_ENTRY(TOY_OP_LITERAL_LONG),
+		TOY_DISPATCH_ENTRY(TOY_OP_LITERAL_RAW),
+		TOY_DISPATCH_ENTRY(TOY_OP_NEGATE),
+		TOY_DISPATCH_ENTRY(TOY_OP_ADDITION),
+		TOY_DISPATCH_ENTRY(TOY_OP_SUBTRACTION),
+		TOY_DISPATCH_ENTRY(TOY_OP_MULTIPLICATION),
+		TOY_DISPATCH_ENTRY(TOY_OP_DIVISION),
+		TOY_DISPATCH_ENTRY(TOY_OP_MODULO),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_ADDITION_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_SUBTRACTION_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_MULTIPLICATION_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_DIVISION_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_MODULO_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_GROUPING_BEGIN),
+		TOY_DISPATCH_ENTRY(TOY_OP_GROUPING_END),
+		TOY_DISPATCH_ENTRY(TOY_OP_SCOPE_BEGIN),
+		TOY_DISPATCH_ENTRY(TOY_OP_SCOPE_END),
+		TOY_DISPATCH_ENTRY(TOY_OP_SCOPE_SLOTS),
+		TOY_DISPATCH_ENTRY(TOY_OP_SLOT_DECL),
+		TOY_DISPATCH_ENTRY(TOY_OP_SLOT_LOAD),
+		TOY_DISPATCH_ENTRY(TOY_OP_SLOT_STORE),
+		TOY_DISPATCH_ENTRY(TOY_OP_SLOT_INCREMENT),
+		TOY_DISPATCH_ENTRY(TOY_OP_SLOT_DECREMENT),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_DECL),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_DECL_LONG),
+		TOY_DISPATCH_ENTRY(TOY_OP_FN_DECL),
+		TOY_DISPATCH_ENTRY(TOY_OP_FN_DECL_LONG),
+		TOY_DISPATCH_ENTRY(TOY_OP_VAR_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_TYPE_CAST),
+		TOY_DISPATCH_ENTRY(TOY_OP_TYPE_OF),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_EQUAL),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_NOT_EQUAL),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_LESS),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_LESS_EQUAL),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_GREATER),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_GREATER_EQUAL),
+		TOY_DISPATCH_ENTRY(TOY_OP_INVERT),
+		TOY_DISPATCH_ENTRY(TOY_OP_AND),
+		TOY_DISPATCH_ENTRY(TOY_OP_OR),
+		TOY_DISPATCH_ENTRY(TOY_OP_JUMP),
+		TOY_DISPATCH_ENTRY(TOY_OP_IF_FALSE_JUMP),
+		TOY_DISPATCH_ENTRY(TOY_OP_IF_TRUE_JUMP),
+		TOY_DISPATCH_ENTRY(TOY_OP_FN_CALL),
+		TOY_DISPATCH_ENTRY(TOY_OP_DOT),
+		TOY_DISPATCH_ENTRY(TOY_OP_FN_RETURN),
+		TOY_DISPATCH_ENTRY(TOY_OP_IMPORT),
+		TOY_DISPATCH_ENTRY(TOY_OP_INDEX),
+		TOY_DISPATCH_ENTRY(TOY_OP_INDEX_ASSIGN_INTERMEDIATE),
+		TOY_DISPATCH_ENTRY(TOY_OP_INDEX_ASSIGN),
+		TOY_DISPATCH_ENTRY(TOY_OP_POP_STACK),
+		TOY_DISPATCH_ENTRY(TOY_OP_ADDITION_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_SUBTRACTION_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_MULTIPLICATION_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_DIVISION_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_MODULO_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_ADDITION_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_SUBTRACTION_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_MULTIPLICATION_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_DIVISION_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_LESS_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_LESS_EQUAL_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_GREATER_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_GREATER_EQUAL_INTEGER),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_LESS_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_LESS_EQUAL_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_GREATER_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_COMPARE_GREATER_EQUAL_FLOAT),
+		TOY_DISPATCH_ENTRY(TOY_OP_SECTION_END),
+	};
+
+	TOY_DISPATCH_GOTO();
+	{
+		{
+#else
 	while(opcode != TOY_OP_EOF && opcode != TOY_OP_SECTION_END && !interpreter->panic) {
 		switch(opcode) {
-			case TOY_OP_PASS:
+#endif
+			TOY_DISPATCH(TOY_OP_EOF)
+			TOY_DISPATCH(TOY_OP_SECTION_END)
+				goto leave;
+
+			TOY_DISPATCH(TOY_OP_PASS)
 				//DO NOTHING
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_ASSERT:
+			TOY_DISPATCH(TOY_OP_ASSERT)
 				if (!execAssert(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_PRINT:
+			TOY_DISPATCH(TOY_OP_PRINT)
 				if (!execPrint(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_LITERAL:
-			case TOY_OP_LITERAL_LONG:
+			TOY_DISPATCH(TOY_OP_LITERAL)
+			TOY_DISPATCH(TOY_OP_LITERAL_LONG)
 				if (!execPushLiteral(interpreter, opcode == TOY_OP_LITERAL_LONG)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_LITERAL_RAW:
+			TOY_DISPATCH(TOY_OP_LITERAL_RAW)
 				if (!execRawLiteral(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_NEGATE:
+			TOY_DISPATCH(TOY_OP_NEGATE)
 				if (!execNegate(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_ADDITION)
+			TOY_DISPATCH(TOY_OP_SUBTRACTION)
+			TOY_DISPATCH(TOY_OP_MULTIPLICATION)
+			TOY_DISPATCH(TOY_OP_DIVISION)
+			TOY_DISPATCH(TOY_OP_MODULO)
+				quickenArithmetic(interpreter, opcode);
 
-			case TOY_OP_ADDITION:
-			case TOY_OP_SUBTRACTION:
-			case TOY_OP_MULTIPLICATION:
-			case TOY_OP_DIVISION:
-			case TOY_OP_MODULO:
 				if (!execArithmetic(interpreter, opcode)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_ADDITION_INTEGER)
+			TOY_DISPATCH(TOY_OP_SUBTRACTION_INTEGER)
+			TOY_DISPATCH(TOY_OP_MULTIPLICATION_INTEGER)
+			TOY_DISPATCH(TOY_OP_DIVISION_INTEGER)
+			TOY_DISPATCH(TOY_OP_MODULO_INTEGER)
+				if (!execArithmeticInteger(interpreter, opcode)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_ADDITION_FLOAT)
+			TOY_DISPATCH(TOY_OP_SUBTRACTION_FLOAT)
+			TOY_DISPATCH(TOY_OP_MULTIPLICATION_FLOAT)
+			TOY_DISPATCH(TOY_OP_DIVISION_FLOAT)
+				if (!execArithmeticFloat(interpreter, opcode)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_VAR_ADDITION_ASSIGN:
-			case TOY_OP_VAR_SUBTRACTION_ASSIGN:
-			case TOY_OP_VAR_MULTIPLICATION_ASSIGN:
-			case TOY_OP_VAR_DIVISION_ASSIGN:
-			case TOY_OP_VAR_MODULO_ASSIGN:
+			TOY_DISPATCH(TOY_OP_VAR_ADDITION_ASSIGN)
+			TOY_DISPATCH(TOY_OP_VAR_SUBTRACTION_ASSIGN)
+			TOY_DISPATCH(TOY_OP_VAR_MULTIPLICATION_ASSIGN)
+			TOY_DISPATCH(TOY_OP_VAR_DIVISION_ASSIGN)
+			TOY_DISPATCH(TOY_OP_VAR_MODULO_ASSIGN)
 				execVarArithmeticAssignInterjection(interpreter); //hang on, let me just prep this first
 
 				if (!execArithmetic(interpreter, opcode)) {
 					Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack)); //remove the extra identifier if this went south
-					return;
+					goto leave;
 				}
 
 				if (!execVarAssign(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_GROUPING_BEGIN:
+			TOY_DISPATCH(TOY_OP_GROUPING_BEGIN)
+				//groupings still recurse in C, so they count towards the depth check
+				interpreter->depth++;
 				execInterpreter(interpreter);
-			break;
+				interpreter->depth--;
+
+				//only calls can panic without failing, so only check after these
+				if (interpreter->panic) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_GROUPING_END:
+			TOY_DISPATCH(TOY_OP_GROUPING_END)
 				//And so doeth, yeet thine operation upwards
 				return;
 
 			//scope
-			case TOY_OP_SCOPE_BEGIN:
+			TOY_DISPATCH(TOY_OP_SCOPE_BEGIN)
 				interpreter->scope = Toy_pushScope(interpreter->scope);
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_SCOPE_END:
+			TOY_DISPATCH(TOY_OP_SCOPE_END)
 				interpreter->scope = Toy_popScope(interpreter->scope);
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_SCOPE_SLOTS)
+				if (!execScopeSlots(interpreter)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_SLOT_DECL)
+				if (!execSlotDecl(interpreter)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_SLOT_LOAD)
+				if (!execSlotLoad(interpreter)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_SLOT_STORE)
+				if (!execSlotStore(interpreter)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_SLOT_INCREMENT)
+			TOY_DISPATCH(TOY_OP_SLOT_DECREMENT)
+				if (!execSlotIncrement(interpreter, opcode)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
 
 			//TODO: custom type declarations?
 
-			case TOY_OP_VAR_DECL:
-			case TOY_OP_VAR_DECL_LONG:
+			TOY_DISPATCH(TOY_OP_VAR_DECL)
+			TOY_DISPATCH(TOY_OP_VAR_DECL_LONG)
 				if (!execVarDecl(interpreter, opcode == TOY_OP_VAR_DECL_LONG)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_FN_DECL:
-			case TOY_OP_FN_DECL_LONG:
+			TOY_DISPATCH(TOY_OP_FN_DECL)
+			TOY_DISPATCH(TOY_OP_FN_DECL_LONG)
 				if (!execFnDecl(interpreter, opcode == TOY_OP_FN_DECL_LONG)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_VAR_ASSIGN:
+			TOY_DISPATCH(TOY_OP_VAR_ASSIGN)
 				if (!execVarAssign(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_TYPE_CAST:
+			TOY_DISPATCH(TOY_OP_TYPE_CAST)
 				if (!execValCast(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_TYPE_OF:
+			TOY_DISPATCH(TOY_OP_TYPE_OF)
 				if (!execTypeOf(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_COMPARE_EQUAL:
+			TOY_DISPATCH(TOY_OP_COMPARE_EQUAL)
 				if (!execCompareEqual(interpreter, false)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_COMPARE_NOT_EQUAL:
+			TOY_DISPATCH(TOY_OP_COMPARE_NOT_EQUAL)
 				if (!execCompareEqual(interpreter, true)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_COMPARE_LESS)
+				quickenComparison(interpreter, opcode);
 
-			case TOY_OP_COMPARE_LESS:
 				if (!execCompareLess(interpreter, false)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_COMPARE_LESS_EQUAL)
+				quickenComparison(interpreter, opcode);
 
-			case TOY_OP_COMPARE_LESS_EQUAL:
 				if (!execCompareLessEqual(interpreter, false)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_COMPARE_GREATER)
+				quickenComparison(interpreter, opcode);
 
-			case TOY_OP_COMPARE_GREATER:
 				if (!execCompareLess(interpreter, true)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_COMPARE_GREATER_EQUAL)
+				quickenComparison(interpreter, opcode);
 
-			case TOY_OP_COMPARE_GREATER_EQUAL:
 				if (!execCompareLessEqual(interpreter, true)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_COMPARE_LESS_INTEGER)
+			TOY_DISPATCH(TOY_OP_COMPARE_LESS_EQUAL_INTEGER)
+			TOY_DISPATCH(TOY_OP_COMPARE_GREATER_INTEGER)
+			TOY_DISPATCH(TOY_OP_COMPARE_GREATER_EQUAL_INTEGER)
+			TOY_DISPATCH(TOY_OP_COMPARE_LESS_FLOAT)
+			TOY_DISPATCH(TOY_OP_COMPARE_LESS_EQUAL_FLOAT)
+			TOY_DISPATCH(TOY_OP_COMPARE_GREATER_FLOAT)
+			TOY_DISPATCH(TOY_OP_COMPARE_GREATER_EQUAL_FLOAT)
+				if (!execCompareQuickened(interpreter, opcode)) {
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_INVERT:
+			TOY_DISPATCH(TOY_OP_INVERT)
 				if (!execInvert(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_AND:
+			TOY_DISPATCH(TOY_OP_AND)
 				if (!execAnd(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_OR:
+			TOY_DISPATCH(TOY_OP_OR)
 				if (!execOr(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_JUMP:
+			TOY_DISPATCH(TOY_OP_JUMP)
 				if (!execJump(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_IF_FALSE_JUMP:
+			TOY_DISPATCH(TOY_OP_IF_FALSE_JUMP)
 				if (!execJumpIfFalse(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_FN_CALL:
-				if (!execFnCall(interpreter, false)) {
-					return;
+			TOY_DISPATCH(TOY_OP_IF_TRUE_JUMP)
+				if (!execJumpIfTrue(interpreter)) {
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_DOT:
-				if (!execFnCall(interpreter, true)) { //compensate for the out-of-order arguments
-					return;
+			TOY_DISPATCH(TOY_OP_FN_CALL)
+				if (!execFnCall(interpreter, false, &intermediateAssignDepth) || interpreter->panic) {
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
+
+			TOY_DISPATCH(TOY_OP_DOT)
+				if (!execFnCall(interpreter, true, &intermediateAssignDepth) || interpreter->panic) { //compensate for the out-of-order arguments
+					goto leave;
+				}
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_FN_RETURN:
+			TOY_DISPATCH(TOY_OP_FN_RETURN)
 				if (!execFnReturn(interpreter)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_IMPORT:
-				if (!execImport(interpreter)) {
-					return;
+			TOY_DISPATCH(TOY_OP_IMPORT)
+				if (!execImport(interpreter) || interpreter->panic) {
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_INDEX:
+			TOY_DISPATCH(TOY_OP_INDEX)
 				if (!execIndex(interpreter, false)) {
-					return;
+					goto leave;
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_INDEX_ASSIGN_INTERMEDIATE:
+			TOY_DISPATCH(TOY_OP_INDEX_ASSIGN_INTERMEDIATE)
 				if (!execIndex(interpreter, true)) {
-					return;
+					goto leave;
 				}
 				intermediateAssignDepth++;
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_INDEX_ASSIGN:
+			TOY_DISPATCH(TOY_OP_INDEX_ASSIGN)
 				if (!execIndexAssign(interpreter, intermediateAssignDepth)) {
-					return;
+					goto leave;
 				}
 				intermediateAssignDepth = 0;
-			break;
+			TOY_DISPATCH_NEXT;
 
-			case TOY_OP_POP_STACK:
-				while (interpreter->stack.count > 0) {
+			TOY_DISPATCH(TOY_OP_POP_STACK)
+				while (interpreter->stack.count > interpreter->stackBase) {
 					Toy_freeLiteral(Toy_popLiteralArray(&interpreter->stack));
 				}
-			break;
+			TOY_DISPATCH_NEXT;
 
-			default:
+			TOY_DISPATCH_DEFAULT
 				interpreter->errorOutput("Unknown opcode found, terminating\n");
-				return;
+				goto leave;
 		}
 
+#ifndef TOY_THREADED_DISPATCH
+resume:
 		opcode = readByte(interpreter->bytecode, &interpreter->count);
+#endif
+	}
+
+	//reached at the end of the code, or when an instruction fails
+leave:
+	if (leaveCallFrame(interpreter, entryFrameCount, &intermediateAssignDepth)) {
+		//carry on with the caller
+#ifdef TOY_THREADED_DISPATCH
+		TOY_DISPATCH_NEXT;
+#else
+		goto resume;
+#endif
 	}
 }
 
+#ifdef TOY_THREADED_DISPATCH
+#pragma GCC diagnostic pop
+#endif
+
 static void readInterpreterSections(Toy_Interpreter* interpreter) {
 	//data section
-	const unsigned short literalCount = readShort(interpreter->bytecode, &interpreter->count);
+	const int literalCount = readIndex(interpreter->bytecode, &interpreter->count);
 
 #ifndef TOY_EXPORT
 	if (Toy_commandLine.verbose) {
@@ -1902,7 +2826,7 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 			case TOY_LITERAL_STRING: {
 				const char* s = readString(interpreter->bytecode, &interpreter->count);
 				int length = strlen(s);
-				Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(s, length));
+				Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_internRefStringLength(s, length));
 				Toy_pushLiteralArray(&interpreter->literalCache, literal);
 				Toy_freeLiteral(literal);
 
@@ -1919,11 +2843,11 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 				Toy_LiteralArray* array = TOY_ALLOCATE(Toy_LiteralArray, 1);
 				Toy_initLiteralArray(array);
 
-				unsigned short length = readShort(interpreter->bytecode, &interpreter->count);
+				int length = readIndex(interpreter->bytecode, &interpreter->count);
 
 				//read each index, then unpack the value from the existing literal cache
 				for (int i = 0; i < length; i++) {
-					int index = readShort(interpreter->bytecode, &interpreter->count);
+					int index = readIndex(interpreter->bytecode, &interpreter->count);
 					Toy_pushLiteralArray(array, interpreter->literalCache.literals[index]);
 				}
 
@@ -1950,12 +2874,12 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 				Toy_LiteralDictionary* dictionary = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
 				Toy_initLiteralDictionary(dictionary);
 
-				unsigned short length = readShort(interpreter->bytecode, &interpreter->count);
+				int length = readIndex(interpreter->bytecode, &interpreter->count);
 
 				//read each index, then unpack the value from the existing literal cache
 				for (int i = 0; i < length / 2; i++) {
-					int key = readShort(interpreter->bytecode, &interpreter->count);
-					int val = readShort(interpreter->bytecode, &interpreter->count);
+					int key = readIndex(interpreter->bytecode, &interpreter->count);
+					int val = readIndex(interpreter->bytecode, &interpreter->count);
 					Toy_setLiteralDictionary(dictionary, interpreter->literalCache.literals[key], interpreter->literalCache.literals[val]);
 				}
 
@@ -1979,7 +2903,7 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 
 			case TOY_LITERAL_FUNCTION: {
 				//read the index
-				unsigned short index = readShort(interpreter->bytecode, &interpreter->count);
+				int index = readIndex(interpreter->bytecode, &interpreter->count);
 				Toy_Literal literal = TOY_TO_INTEGER_LITERAL(index);
 
 				//change the type, to read it PROPERLY below
@@ -2000,7 +2924,7 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 				const char* str = readString(interpreter->bytecode, &interpreter->count);
 
 				int length = strlen(str);
-				Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(str, length));
+				Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(str, length));
 
 				Toy_pushLiteralArray(&interpreter->literalCache, identifier);
 
@@ -2025,14 +2949,14 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 
 				//if it's an array type
 				if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_ARRAY) {
-					unsigned short vt = readShort(interpreter->bytecode, &interpreter->count);
+					int vt = readIndex(interpreter->bytecode, &interpreter->count);
 
 					TOY_TYPE_PUSH_SUBTYPE(&typeLiteral, Toy_copyLiteral(interpreter->literalCache.literals[vt]));
 				}
 
 				if (TOY_AS_TYPE(typeLiteral).typeOf == TOY_LITERAL_DICTIONARY) {
-					unsigned short kt = readShort(interpreter->bytecode, &interpreter->count);
-					unsigned short vt = readShort(interpreter->bytecode, &interpreter->count);
+					int kt = readIndex(interpreter->bytecode, &interpreter->count);
+					int vt = readIndex(interpreter->bytecode, &interpreter->count);
 
 					TOY_TYPE_PUSH_SUBTYPE(&typeLiteral, Toy_copyLiteral(interpreter->literalCache.literals[kt]));
 					TOY_TYPE_PUSH_SUBTYPE(&typeLiteral, Toy_copyLiteral(interpreter->literalCache.literals[vt]));
@@ -2069,14 +2993,14 @@ static void readInterpreterSections(Toy_Interpreter* interpreter) {
 	consumeByte(interpreter, TOY_OP_SECTION_END, interpreter->bytecode, &interpreter->count); //terminate the literal section
 
 	//read the function metadata
-	int functionCount = readShort(interpreter->bytecode, &interpreter->count);
-	int functionSize = readShort(interpreter->bytecode, &interpreter->count); //might not be needed
+	int functionCount = readIndex(interpreter->bytecode, &interpreter->count);
+	int functionSize = readIndex(interpreter->bytecode, &interpreter->count); //might not be needed
 
 	//read in the functions
 	for (int i = 0; i < interpreter->literalCache.count; i++) {
 		if (interpreter->literalCache.literals[i].type == TOY_LITERAL_FUNCTION_INTERMEDIATE) {
 			//get the size of the function
-			size_t size = (size_t)readShort(interpreter->bytecode, &interpreter->count);
+			size_t size = (size_t)readIndex(interpreter->bytecode, &interpreter->count);
 
 			//assert that the last memory slot is function end
 			if (interpreter->bytecode[interpreter->count + size - 1] != TOY_OP_FN_END) {
@@ -2099,6 +3023,8 @@ void Toy_initInterpreter(Toy_Interpreter* interpreter) {
 	interpreter->hooks = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
 	Toy_initLiteralDictionary(interpreter->hooks);
 
+	interpreter->lookupCache = allocateLookupCache();
+
 	//set up the output streams
 	Toy_setInterpreterPrint(interpreter, printWrapper);
 	Toy_setInterpreterAssert(interpreter, assertWrapper);
@@ -2108,44 +3034,18 @@ void Toy_initInterpreter(Toy_Interpreter* interpreter) {
 	Toy_resetInterpreter(interpreter);
 }
 
-void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length) {
-	//initialize here instead of initInterpreter()
-	Toy_initLiteralArray(&interpreter->literalCache);
-	interpreter->bytecode = NULL;
-	interpreter->length = 0;
-	interpreter->count = 0;
-	interpreter->codeStart = -1;
-
-	Toy_initLiteralArray(&interpreter->stack);
-
-	interpreter->depth = 0;
-	interpreter->panic = false;
-
-	//prep the bytecode
-	interpreter->bytecode = bytecode;
-	interpreter->length = length;
-	interpreter->count = 0;
-
-	if (!interpreter->bytecode) {
-		interpreter->errorOutput("No valid bytecode given\n");
-		return;
-	}
-
-	//prep the literal cache
-	if (interpreter->literalCache.count > 0) {
-		Toy_freeLiteralArray(&interpreter->literalCache); //automatically inits
-	}
-
+//check the header, and decode the literal and function sections of a script
+static bool readScriptSections(Toy_Interpreter* interpreter) {
 	//header section
 	const unsigned char major = readByte(interpreter->bytecode, &interpreter->count);
 	const unsigned char minor = readByte(interpreter->bytecode, &interpreter->count);
 	const unsigned char patch = readByte(interpreter->bytecode, &interpreter->count);
 
 	if (major != TOY_VERSION_MAJOR || minor > TOY_VERSION_MINOR) {
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, TOY_MAX_STRING_LENGTH, "Interpreter/bytecode version mismatch (expected %d.%d.%d or earlier, given %d.%d.%d)\n", TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, major, minor, patch);
+		char buffer[256];
+		snprintf(buffer, 256, "Interpreter/bytecode version mismatch (expected %d.%d.%d or earlier, given %d.%d.%d)\n", TOY_VERSION_MAJOR, TOY_VERSION_MINOR, TOY_VERSION_PATCH, major, minor, patch);
 		interpreter->errorOutput(buffer);
-		return;
+		return false;
 	}
 
 	const char* build = readString(interpreter->bytecode, &interpreter->count);
@@ -2163,6 +3063,58 @@ void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytec
 	//read the sections of the bytecode
 	readInterpreterSections(interpreter);
 
+	return true;
+}
+
+//run a script, decoding its sections on the first run only
+static void runScript(Toy_Interpreter* interpreter, Toy_Bytecode* script) {
+	//initialize here instead of initInterpreter()
+	Toy_initLiteralArray(&interpreter->literalCache);
+	interpreter->bytecode = NULL;
+	interpreter->length = 0;
+	interpreter->count = 0;
+	interpreter->codeStart = -1;
+	interpreter->readOnlyCode = NULL;
+
+	Toy_initLiteralArray(&interpreter->stack);
+	Toy_initLiteralArray(&interpreter->indexArguments);
+	interpreter->stackBase = 0;
+	interpreter->frames = NULL;
+	interpreter->frameCapacity = 0;
+	interpreter->frameCount = 0;
+
+	interpreter->depth = 0;
+	interpreter->panic = false;
+
+	if (!script->data) {
+		interpreter->errorOutput("No valid bytecode given\n");
+		return;
+	}
+
+	//prep the bytecode
+	interpreter->bytecode = script->data;
+	interpreter->length = (int)script->length;
+	interpreter->count = 0;
+
+	if (!script->writable) {
+		interpreter->readOnlyCode = script->data;
+	}
+
+	//prep the sections - these are decoded only once, then shared read-only between runs
+	if (script->codeStart < 0) {
+		if (!readScriptSections(interpreter)) {
+			Toy_freeLiteralArray(&interpreter->literalCache);
+			return;
+		}
+
+		script->literalCache = interpreter->literalCache; //ownership moves to the script
+		script->codeStart = interpreter->count;
+	}
+	else {
+		interpreter->literalCache = script->literalCache; //NOTE: shallow copy, never freed by the interpreter
+		interpreter->count = script->codeStart;
+	}
+
 	//code section
 #ifndef TOY_EXPORT
 	if (Toy_commandLine.verbose) {
@@ -2179,12 +3131,46 @@ void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytec
 		Toy_freeLiteral(lit);
 	}
 
-	//free the bytecode immediately after use TODO: because why?
-	TOY_FREE_ARRAY(unsigned char, interpreter->bytecode, interpreter->length);
-
 	//free the associated data
-	Toy_freeLiteralArray(&interpreter->literalCache);
+	Toy_initLiteralArray(&interpreter->literalCache);
 	Toy_freeLiteralArray(&interpreter->stack);
+	Toy_freeLiteralArray(&interpreter->indexArguments);
+	TOY_FREE_ARRAY(Toy_private_interpreter_frame, interpreter->frames, interpreter->frameCapacity);
+
+	interpreter->bytecode = NULL;
+	interpreter->readOnlyCode = NULL;
+}
+
+void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length) {
+	Toy_Bytecode script;
+	Toy_initBytecode(&script, bytecode, length);
+
+	//the interpreter owns this bytecode, so it can be quickened in place
+	script.writable = true;
+	runScript(interpreter, &script);
+
+	Toy_freeBytecode(&script);
+	TOY_FREE_ARRAY(unsigned char, bytecode, length);
+}
+
+void Toy_runInterpreterBytecode(Toy_Interpreter* interpreter, Toy_Bytecode* bytecode) {
+	runScript(interpreter, bytecode);
+}
+
+void Toy_initBytecode(Toy_Bytecode* bytecode, const unsigned char* data, size_t length) {
+	bytecode->data = data;
+	bytecode->length = length;
+	bytecode->writable = false;
+	Toy_initLiteralArray(&bytecode->literalCache);
+	bytecode->codeStart = -1;
+}
+
+void Toy_freeBytecode(Toy_Bytecode* bytecode) {
+	//the data is left alone
+	Toy_freeLiteralArray(&bytecode->literalCache);
+	bytecode->data = NULL;
+	bytecode->length = 0;
+	bytecode->codeStart = -1;
 }
 
 void Toy_resetInterpreter(Toy_Interpreter* interpreter) {
@@ -2217,6 +3203,46 @@ void Toy_freeInterpreter(Toy_Interpreter* interpreter) {
 	}
 
 	interpreter->hooks = NULL;
+
+	if (interpreter->lookupCache) {
+		Toy_private_freeScopeCache(interpreter->lookupCache, LOOKUP_CACHE_SIZE);
+		TOY_FREE_ARRAY(Toy_private_scope_cache, interpreter->lookupCache, LOOKUP_CACHE_SIZE);
+	}
+
+	interpreter->lookupCache = NULL;
+}
+
+void Toy_forkInterpreter(Toy_Interpreter* interpreter, Toy_Interpreter* snapshot) {
+	//the hooks are shared until either interpreter injects another
+	interpreter->hooks = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
+	Toy_shareLiteralDictionary(interpreter->hooks, snapshot->hooks);
+
+	//the fork's scopes are new, so nothing the snapshot cached would match anyway
+	interpreter->lookupCache = allocateLookupCache();
+
+	Toy_setInterpreterPrint(interpreter, snapshot->printOutput);
+	Toy_setInterpreterAssert(interpreter, snapshot->assertOutput);
+	Toy_setInterpreterError(interpreter, snapshot->errorOutput);
+
+	//the fork gets its own copy of the global scope, with every function rebound to it
+	interpreter->scope = Toy_forkScope(snapshot->scope);
+
+	//ready for Toy_callFn(), or another Toy_runInterpreter()
+	interpreter->bytecode = NULL;
+	interpreter->length = 0;
+	interpreter->count = 0;
+	interpreter->codeStart = -1;
+	interpreter->readOnlyCode = NULL;
+	Toy_initLiteralArray(&interpreter->literalCache);
+	Toy_initLiteralArray(&interpreter->stack);
+	Toy_initLiteralArray(&interpreter->indexArguments);
+	interpreter->stackBase = 0;
+	interpreter->frames = NULL;
+	interpreter->frameCapacity = 0;
+	interpreter->frameCount = 0;
+
+	interpreter->depth = 0;
+	interpreter->panic = false;
 }
 
 //for function calls
@@ -2264,217 +3290,44 @@ bool Toy_callLiteralFn(Toy_Interpreter* interpreter, Toy_Literal func, Toy_Liter
 	Toy_Interpreter inner;
 
 	//init the inner interpreter manually
-	Toy_initLiteralArray(&inner.literalCache);
-	inner.scope = Toy_pushScope(func.as.function.scope);
-	inner.bytecode = ((Toy_RefFunction*)(TOY_AS_FUNCTION(func).inner.ptr))->data;
-	inner.length = ((Toy_RefFunction*)(TOY_AS_FUNCTION(func).inner.ptr))->length;
-	inner.count = 0;
-	inner.codeStart = -1;
 	inner.depth = interpreter->depth + 1;
 	inner.panic = false;
+	inner.readOnlyCode = NULL;
 	Toy_initLiteralArray(&inner.stack);
+	Toy_initLiteralArray(&inner.indexArguments);
+	inner.stackBase = 0;
+	inner.frames = NULL;
+	inner.frameCapacity = 0;
+	inner.frameCount = 0;
 	inner.hooks = interpreter->hooks;
+	inner.lookupCache = interpreter->lookupCache;
 	Toy_setInterpreterPrint(&inner, interpreter->printOutput);
 	Toy_setInterpreterAssert(&inner, interpreter->assertOutput);
 	Toy_setInterpreterError(&inner, interpreter->errorOutput);
 
-	//prep the sections
-	readInterpreterSections(&inner);
-
-	//prep the arguments
-	Toy_LiteralArray* paramArray = TOY_AS_ARRAY(inner.literalCache.literals[ readShort(inner.bytecode, &inner.count) ]);
-	Toy_LiteralArray* returnArray = TOY_AS_ARRAY(inner.literalCache.literals[ readShort(inner.bytecode, &inner.count) ]);
-
-	//get the rest param, if it exists
-	Toy_Literal restParam = TOY_TO_NULL_LITERAL;
-	if (paramArray->count >= 2 && TOY_AS_TYPE(paramArray->literals[ paramArray->count -1 ]).typeOf == TOY_LITERAL_FUNCTION_ARG_REST) {
-		restParam = paramArray->literals[ paramArray->count -2 ];
-	}
-
-	//check the param total is correct
-	if ((TOY_IS_NULL(restParam) && paramArray->count != arguments->count * 2) || (!TOY_IS_NULL(restParam) && paramArray->count -2 > arguments->count * 2)) {
-		interpreter->errorOutput("Incorrect number of arguments passed to a function\n");
-
-		//free, and skip out
-		Toy_popScope(inner.scope);
-
+	Toy_LiteralArray* returnArray = NULL;
+	if (!enterFunction(interpreter, &inner, func, arguments, &returnArray)) {
 		Toy_freeLiteralArray(&inner.stack);
-		Toy_freeLiteralArray(&inner.literalCache);
-
+		Toy_freeLiteralArray(&inner.indexArguments);
 		return false;
 	}
 
-	//BUGFIX: access the arguments from the beginning
-	int argumentIndex = 0;
-
-	//contents is the indexes of identifier & type
-	for (int i = 0; i < paramArray->count - (TOY_IS_NULL(restParam) ? 0 : 2); i += 2) { //don't count the rest parameter, if present
-		//declare and define each entry in the scope
-		if (!Toy_declareScopeVariable(inner.scope, paramArray->literals[i], paramArray->literals[i + 1])) {
-			interpreter->errorOutput("[internal] Could not re-declare parameter\n");
-
-			//free, and skip out
-			Toy_popScope(inner.scope);
-
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
-
-			return false;
-		}
-
-		//access the arguments in order
-		Toy_Literal arg = TOY_TO_NULL_LITERAL;
-		if (argumentIndex < arguments->count) {
-			arg = Toy_copyLiteral(arguments->literals[argumentIndex++]);
-		}
-
-		Toy_Literal argIdn = arg;
-		if (TOY_IS_IDENTIFIER(arg) && Toy_parseIdentifierToValue(interpreter, &arg)) {
-			Toy_freeLiteral(argIdn);
-		}
-
-		//BUGFIX: coerce ints to floats, if the function requires floats
-		if (TOY_IS_INTEGER(arg) && TOY_IS_TYPE(paramArray->literals[i + 1]) && TOY_AS_TYPE(paramArray->literals[i + 1]).typeOf == TOY_LITERAL_FLOAT) {
-			Toy_Literal f = TOY_TO_FLOAT_LITERAL( (float)TOY_AS_INTEGER(arg) );
-			Toy_freeLiteral(arg);
-			arg = f;
-		}
-
-		if (!Toy_setScopeVariable(inner.scope, paramArray->literals[i], arg, false)) {
-			interpreter->errorOutput("[internal] Could not define parameter (bad type?)\n");
-
-			//free, and skip out
-			Toy_freeLiteral(arg);
-			Toy_popScope(inner.scope);
-
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
-
-			return false;
-		}
-		Toy_freeLiteral(arg);
-	}
-
-	//if using rest, pack the optional extra arguments into the rest parameter (array)
-	if (!TOY_IS_NULL(restParam)) {
-		Toy_LiteralArray rest;
-		Toy_initLiteralArray(&rest);
-
-		//access the arguments in order
-		while (argumentIndex < arguments->count) {
-			Toy_Literal lit = Toy_copyLiteral(arguments->literals[argumentIndex++]);
-			Toy_pushLiteralArray(&rest, lit);
-			Toy_freeLiteral(lit);
-		}
-
-		Toy_Literal restType = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ARRAY, true);
-		Toy_Literal any = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false);
-		TOY_TYPE_PUSH_SUBTYPE(&restType, any);
-
-		//declare & define the rest parameter
-		if (!Toy_declareScopeVariable(inner.scope, restParam, restType)) {
-			interpreter->errorOutput("[internal] Could not declare rest parameter\n");
-
-			//free, and skip out
-			Toy_freeLiteral(restType);
-			Toy_freeLiteralArray(&rest);
-			Toy_popScope(inner.scope);
-
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
-
-			return false;
-		}
-
-		Toy_Literal lit = TOY_TO_ARRAY_LITERAL(&rest);
-		if (!Toy_setScopeVariable(inner.scope, restParam, lit, false)) {
-			interpreter->errorOutput("[internal] Could not define rest parameter\n");
-
-			//free, and skip out
-			Toy_freeLiteral(restType);
-			Toy_freeLiteral(lit);
-			Toy_popScope(inner.scope);
-
-			Toy_freeLiteralArray(&inner.stack);
-			Toy_freeLiteralArray(&inner.literalCache);
-
-			return false;
-		}
-
-		Toy_freeLiteral(restType);
-		Toy_freeLiteralArray(&rest);
-	}
-
 	//execute the interpreter
 	execInterpreter(&inner);
 
 	//adopt the panic state
 	interpreter->panic = inner.panic;
 
-	//accept the stack as the results
-	Toy_LiteralArray returnsFromInner;
-	Toy_initLiteralArray(&returnsFromInner);
-
-	//unpack the results
-	for (int i = 0; i < (returnArray->count || 1); i++) {
-		Toy_Literal lit = Toy_popLiteralArray(&inner.stack);
-		Toy_pushLiteralArray(&returnsFromInner, lit); //NOTE: also reverses the order
-		Toy_freeLiteral(lit);
-	}
-
-	bool returnValue = true;
-
-	//TODO: remove this when multiple assignment is enabled - note the BUGFIX that balances the stack
-	if (returnsFromInner.count > 1) {
-		interpreter->errorOutput("Too many values returned (multiple returns not yet supported)\n");
-
-		returnValue = false;
-	}
-
-	for (int i = 0; i < returnsFromInner.count && returnValue; i++) {
-		Toy_Literal ret = Toy_popLiteralArray(&returnsFromInner);
-
-		//BUGFIX: coerce the returned integers to floats, if specified
-		if (returnArray->count > 0 && TOY_AS_TYPE(returnArray->literals[i]).typeOf == TOY_LITERAL_FLOAT && TOY_IS_INTEGER(ret)) {
-			Toy_Literal f = TOY_TO_FLOAT_LITERAL( (float)TOY_AS_INTEGER(ret) );
-			Toy_freeLiteral(ret);
-			ret = f;
-		}
-
-		//check the return types
-		if (returnArray->count > 0 && TOY_AS_TYPE(returnArray->literals[i]).typeOf != ret.type) {
-			interpreter->errorOutput("Bad type found in return value\n");
-
-			//free, and skip out
-			returnValue = false;
-			break;
-		}
-
-		Toy_pushLiteralArray(returns, ret); //NOTE: reverses again
-		Toy_freeLiteral(ret);
-	}
+	//accept the top of the stack as the result
+	Toy_Literal ret = Toy_popLiteralArray(&inner.stack);
+	returnFunctionResult(interpreter, returnArray, ret, returns);
+	Toy_freeLiteral(ret);
 
 	//manual free
-	//BUGFIX: handle scopes of functions, which refer to the parent scope (leaking memory)
-	while(inner.scope != TOY_AS_FUNCTION(func).scope) {
-		for (int i = 0; i < inner.scope->variables.capacity; i++) {
-			//handle keys, just in case
-			if (TOY_IS_FUNCTION(inner.scope->variables.entries[i].key)) {
-				Toy_popScope(TOY_AS_FUNCTION(inner.scope->variables.entries[i].key).scope);
-				TOY_AS_FUNCTION(inner.scope->variables.entries[i].key).scope = NULL;
-			}
-
-			if (TOY_IS_FUNCTION(inner.scope->variables.entries[i].value)) {
-				Toy_popScope(TOY_AS_FUNCTION(inner.scope->variables.entries[i].value).scope);
-				TOY_AS_FUNCTION(inner.scope->variables.entries[i].value).scope = NULL;
-			}
-		}
-
-		inner.scope = Toy_popScope(inner.scope);
-	}
-	Toy_freeLiteralArray(&returnsFromInner);
+	leaveFunctionScopes(inner.scope, TOY_AS_FUNCTION(func).scope);
 	Toy_freeLiteralArray(&inner.stack);
-	Toy_freeLiteralArray(&inner.literalCache);
+	Toy_freeLiteralArray(&inner.indexArguments);
+	TOY_FREE_ARRAY(Toy_private_interpreter_frame, inner.frames, inner.frameCapacity);
 
 	//BUGFIX: this function needs to eat the arguments
 	Toy_freeLiteralArray(arguments);
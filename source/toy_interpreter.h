@@ -42,6 +42,32 @@ Conventionally, when an alias is given, all of the functions should instead be i
 #include "toy_literal_dictionary.h"
 #include "toy_scope.h"
 
+//the state of a caller, saved while a Toy function runs within the same interpreter
+typedef struct Toy_private_interpreter_frame {
+	Toy_RefFunction* function; //keeps the callee's code alive until it returns
+	Toy_Scope* functionScope; //the scope the callee was declared in
+	Toy_LiteralArray* returnArray; //the callee's return types
+
+	//the caller's position
+	const unsigned char* bytecode;
+	int length;
+	int count;
+	int codeStart;
+	Toy_LiteralArray literalCache;
+	Toy_Scope* scope;
+	int stackBase;
+	int intermediateAssignDepth;
+} Toy_private_interpreter_frame;
+
+//compiled bytecode which can be run many times, by any number of interpreters - the data is borrowed, and only written to if allowed
+typedef struct Toy_Bytecode {
+	const unsigned char* data;
+	size_t length;
+	bool writable; //false by default - set this if the data is private to this thread, so the top level of the script can be quickened
+	Toy_LiteralArray literalCache; //decoded by the first run, then shared read-only between runs
+	int codeStart; //-1 until the sections have been decoded
+} Toy_Bytecode;
+
 //the interpreter acts depending on the bytecode instructions
 typedef struct Toy_Interpreter {
 	//input
@@ -50,20 +76,31 @@ typedef struct Toy_Interpreter {
 	int count;
 	int codeStart; //BUGFIX: for jumps, must be initialized to -1
 	Toy_LiteralArray literalCache; //read-only - built from the bytecode, refreshed each time new bytecode is provided
+	const unsigned char* readOnlyCode; //borrowed bytecode being run, which can't be quickened
 
 	//operation
 	Toy_Scope* scope;
 	Toy_LiteralArray stack;
+	int stackBase; //the current function's part of the stack begins here
+	Toy_LiteralArray indexArguments; //reused by every index, so reading from a compound doesn't allocate
+
+	//calls between Toy functions don't recurse in C
+	Toy_private_interpreter_frame* frames;
+	int frameCapacity;
+	int frameCount;
 
 	//Library APIs
 	Toy_LiteralDictionary* hooks;
 
+	//where each identifier was last found, shared with any inner interpreters
+	Toy_private_scope_cache* lookupCache;
+
 	//debug outputs
 	Toy_PrintFn printOutput;
 	Toy_PrintFn assertOutput;
 	Toy_PrintFn errorOutput;
 
-	int depth; //don't overflow
+	int depth; //don't overflow the C stack
 	bool panic;
 } Toy_Interpreter;
 
@@ -81,7 +118,7 @@ TOY_API void Toy_initInterpreter(Toy_Interpreter* interpreter); //start of progr
 /*!
 ### void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length)
 
-This function takes a `Toy_Interpreter` and `bytecode` (as well as the `length` of the bytecode), checks its version information, parses and un-flattens the literal cache, and executes the compiled program stored in the bytecode. This function also consumes the bytecode, so the `bytecode` argument is no longer valid after calls.
+This function takes a `Toy_Interpreter` and `bytecode` (as well as the `length` of the bytecode), checks its version information, parses and un-flattens the literal cache, and executes the compiled program stored in the bytecode. This function also consumes the bytecode, so the `bytecode` argument is no longer valid after calls - to run the same bytecode more than once, see `Toy_runInterpreterBytecode()`.
 
 If the given bytecode's embedded version is not compatible with the current interpreter, then this function will refuse to execute.
 
@@ -89,6 +126,31 @@ Re-using a `Toy_Interpreter` instance without first resetting it is possible (th
 !*/
 TOY_API void Toy_runInterpreter(Toy_Interpreter* interpreter, const unsigned char* bytecode, size_t length);
 
+/*!
+### void Toy_runInterpreterBytecode(Toy_Interpreter* interpreter, Toy_Bytecode* bytecode)
+
+This function behaves like `Toy_runInterpreter()`, except that the bytecode is only borrowed - it is never freed, so it can be run again, or by several interpreters at once (such as when it's read-only memory shared between threads). The literal and function sections are decoded by the first run, and kept in `bytecode` for the runs that follow.
+
+Unless `bytecode->writable` is set, the data is never written to either, and so the top level of the script isn't quickened - code within functions always is, as each function has its own copy. A private, copy-on-write mapping of a file (see `Toy_mapFile()` in the repl tools) can safely be marked as writable.
+
+Each thread should use its own `Toy_Bytecode`, even for the same data, as the decoded sections belong to the context they were decoded in.
+!*/
+TOY_API void Toy_runInterpreterBytecode(Toy_Interpreter* interpreter, Toy_Bytecode* bytecode);
+
+/*!
+### void Toy_initBytecode(Toy_Bytecode* bytecode, const unsigned char* data, size_t length)
+
+This function initializes `bytecode`, which borrows `data` (as well as the `length` of the data) until it is freed. The data is treated as read-only, until `bytecode->writable` is set.
+!*/
+TOY_API void Toy_initBytecode(Toy_Bytecode* bytecode, const unsigned char* data, size_t length);
+
+/*!
+### void Toy_freeBytecode(Toy_Bytecode* bytecode)
+
+This function frees the sections decoded by `Toy_runInterpreterBytecode()`. The borrowed data is left alone, and can be freed by the caller afterwards.
+!*/
+TOY_API void Toy_freeBytecode(Toy_Bytecode* bytecode);
+
 /*!
 ### void Toy_resetInterpreter(Toy_Interpreter* interpreter)
 
@@ -110,6 +172,15 @@ This function frees a `Toy_Interpreter`, clearing all of the memory used within.
 !*/
 TOY_API void Toy_freeInterpreter(Toy_Interpreter* interpreter);
 
+/*!
+### void Toy_forkInterpreter(Toy_Interpreter* interpreter, Toy_Interpreter* snapshot)
+
+This function initializes `interpreter` as a copy of `snapshot`, which is an interpreter that has already been set up - usually by running a script that imports its libraries, declares its functions and fills in its global variables. The fork is given its own copy of the global scope (see `Toy_forkScope()`), so nothing it does is visible to `snapshot` or to other forks, and it shares the snapshot's hooks and output functions. This is much cheaper than setting up a new interpreter from scratch.
+
+The fork can then be used with `Toy_callFn()`, or to run further bytecode, and is freed with `Toy_freeInterpreter()` as normal. `snapshot` must not be running while it is forked, and functions carry shared state between the two, so they should stay on the same thread. See [toy_interpreter_pool.h](toy_interpreter_pool_h.md) for a pool of forks.
+!*/
+TOY_API void Toy_forkInterpreter(Toy_Interpreter* interpreter, Toy_Interpreter* snapshot);
+
 /*!
 ### bool Toy_injectNativeFn(Toy_Interpreter* interpreter, const char* name, Toy_NativeFn func)
 
@@ -134,6 +205,8 @@ TOY_API bool Toy_injectNativeHook(Toy_Interpreter* interpreter, const char* name
 This function calls a `Toy_Literal` which contains a function, with the arguments to that function passed in as `arguments` and the results stored in `returns`. It returns true on success, otherwise it returns false.
 
 The literal `func` can be either a native function or a Toy function, but it won't execute a hook.
+
+This is intended for host programs and native functions; calls made from within Toy scripts instead run in the caller's interpreter, using a call frame rather than the C stack.
 !*/
 TOY_API bool Toy_callLiteralFn(Toy_Interpreter* interpreter, Toy_Literal func, Toy_LiteralArray* arguments, Toy_LiteralArray* returns);
 
@@ -0,0 +1,60 @@
+#include "toy_interpreter_pool.h"
+
+#include "toy_memory.h"
+
+static void pushIdle(Toy_InterpreterPool* pool, Toy_Interpreter* interpreter) {
+	if (pool->count + 1 > pool->capacity) {
+		int oldCapacity = pool->capacity;
+
+		pool->capacity = TOY_GROW_CAPACITY(oldCapacity);
+		pool->idle = TOY_GROW_ARRAY(Toy_Interpreter*, pool->idle, oldCapacity, pool->capacity);
+	}
+
+	pool->idle[pool->count++] = interpreter;
+}
+
+//exposed functions
+void Toy_initInterpreterPool(Toy_InterpreterPool* pool, Toy_Interpreter* snapshot, int count) {
+	pool->snapshot = snapshot;
+	pool->idle = NULL;
+	pool->capacity = 0;
+	pool->count = 0;
+
+	for (int i = 0; i < count; i++) {
+		Toy_Interpreter* interpreter = TOY_ALLOCATE(Toy_Interpreter, 1);
+		Toy_forkInterpreter(interpreter, snapshot);
+		pushIdle(pool, interpreter);
+	}
+}
+
+void Toy_freeInterpreterPool(Toy_InterpreterPool* pool) {
+	for (int i = 0; i < pool->count; i++) {
+		Toy_freeInterpreter(pool->idle[i]);
+		TOY_FREE(Toy_Interpreter, pool->idle[i]);
+	}
+
+	TOY_FREE_ARRAY(Toy_Interpreter*, pool->idle, pool->capacity);
+
+	pool->snapshot = NULL;
+	pool->idle = NULL;
+	pool->capacity = 0;
+	pool->count = 0;
+}
+
+Toy_Interpreter* Toy_acquireInterpreter(Toy_InterpreterPool* pool) {
+	if (pool->count > 0) {
+		return pool->idle[--pool->count];
+	}
+
+	Toy_Interpreter* interpreter = TOY_ALLOCATE(Toy_Interpreter, 1);
+	Toy_forkInterpreter(interpreter, pool->snapshot);
+	return interpreter;
+}
+
+void Toy_releaseInterpreter(Toy_InterpreterPool* pool, Toy_Interpreter* interpreter) {
+	//fork again now, so the next acquire is ready to go
+	Toy_freeInterpreter(interpreter);
+	Toy_forkInterpreter(interpreter, pool->snapshot);
+
+	pushIdle(pool, interpreter);
+}
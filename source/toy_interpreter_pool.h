@@ -0,0 +1,69 @@
+#pragma once
+
+/*!
+# toy_interpreter_pool.h
+
+This header defines the interpreter pool structure, which hands out pre-warmed copies of a single interpreter. This is useful when the same script handles many requests - the setup (importing libraries, declaring functions and filling in global variables) is done once, in the pool's snapshot, and each request gets a fresh fork of it (see `Toy_forkInterpreter()`).
+
+```c
+Toy_Interpreter snapshot;
+Toy_initInterpreter(&snapshot);
+Toy_injectNativeHook(&snapshot, "standard", Toy_hookStandard);
+Toy_runInterpreter(&snapshot, tb, size); //declares fn handle(request)
+
+Toy_InterpreterPool pool;
+Toy_initInterpreterPool(&pool, &snapshot, 4);
+
+//for each request
+Toy_Interpreter* interpreter = Toy_acquireInterpreter(&pool);
+Toy_callFn(interpreter, "handle", &arguments, &returns);
+Toy_releaseInterpreter(&pool, interpreter);
+
+Toy_freeInterpreterPool(&pool);
+Toy_freeInterpreter(&snapshot);
+```
+
+A pool, and its snapshot, should only be used by one thread - give each worker thread its own.
+!*/
+
+#include "toy_common.h"
+#include "toy_interpreter.h"
+
+typedef struct Toy_InterpreterPool {
+	Toy_Interpreter* snapshot; //not owned by the pool
+	Toy_Interpreter** idle; //forks waiting to be acquired
+	int capacity;
+	int count;
+} Toy_InterpreterPool;
+
+/*!
+## Defined Functions
+!*/
+
+/*!
+### void Toy_initInterpreterPool(Toy_InterpreterPool* pool, Toy_Interpreter* snapshot, int count)
+
+This function initializes `pool`, and forks `count` interpreters from `snapshot` ahead of time. `snapshot` must outlive the pool, and shouldn't be run again while the pool is in use.
+!*/
+TOY_API void Toy_initInterpreterPool(Toy_InterpreterPool* pool, Toy_Interpreter* snapshot, int count);
+
+/*!
+### void Toy_freeInterpreterPool(Toy_InterpreterPool* pool)
+
+This function frees every idle interpreter held by `pool`. Any interpreters still acquired from the pool should be released first.
+!*/
+TOY_API void Toy_freeInterpreterPool(Toy_InterpreterPool* pool);
+
+/*!
+### Toy_Interpreter* Toy_acquireInterpreter(Toy_InterpreterPool* pool)
+
+This function returns an interpreter in the same state as the pool's snapshot, forking a new one if none are idle.
+!*/
+TOY_API Toy_Interpreter* Toy_acquireInterpreter(Toy_InterpreterPool* pool);
+
+/*!
+### void Toy_releaseInterpreter(Toy_InterpreterPool* pool, Toy_Interpreter* interpreter)
+
+This function returns `interpreter` to `pool`. Anything it did is discarded, and it is forked from the snapshot again, ready for the next call to `Toy_acquireInterpreter()`.
+!*/
+TOY_API void Toy_releaseInterpreter(Toy_InterpreterPool* pool, Toy_Interpreter* interpreter);
@@ -64,14 +64,74 @@ char* Toy_findKeywordByType(Toy_TokenType type) {
 	return NULL;
 }
 
-Toy_TokenType Toy_findTypeByKeyword(const char* keyword) {
-	const int length = strlen(keyword);
+//the length and first character have already been checked, so compare the rest
+static Toy_TokenType matchKeyword(const char* lexeme, int length, const char* keyword, Toy_TokenType type) {
+	return memcmp(lexeme + 1, keyword + 1, length - 1) == 0 ? type : TOY_TOKEN_EOF;
+}
 
-	for (int i = 0; Toy_keywordTypes[i].keyword; i++) {
-		if (!strncmp(keyword, Toy_keywordTypes[i].keyword, length)) {
-			return Toy_keywordTypes[i].type;
-		}
+//NOTE: this must be kept in sync with Toy_keywordTypes above
+Toy_TokenType Toy_findTypeByLexeme(const char* lexeme, int length) {
+	switch(length) {
+		case 2:
+			switch(lexeme[0]) {
+				case 'a': return matchKeyword(lexeme, length, "as", TOY_TOKEN_AS);
+				case 'd': return matchKeyword(lexeme, length, "do", TOY_TOKEN_DO);
+				case 'f': return matchKeyword(lexeme, length, "fn", TOY_TOKEN_FUNCTION);
+				case 'i': return lexeme[1] == 'f' ? TOY_TOKEN_IF : matchKeyword(lexeme, length, "in", TOY_TOKEN_IN);
+				case 'o': return matchKeyword(lexeme, length, "of", TOY_TOKEN_OF);
+			}
+		break;
+
+		case 3:
+			switch(lexeme[0]) {
+				case 'a': return matchKeyword(lexeme, length, "any", TOY_TOKEN_ANY);
+				case 'f': return matchKeyword(lexeme, length, "for", TOY_TOKEN_FOR);
+				case 'i': return matchKeyword(lexeme, length, "int", TOY_TOKEN_INTEGER);
+				case 'v': return matchKeyword(lexeme, length, "var", TOY_TOKEN_VAR);
+			}
+		break;
+
+		case 4:
+			switch(lexeme[0]) {
+				case 'b': return matchKeyword(lexeme, length, "bool", TOY_TOKEN_BOOLEAN);
+				case 'e': return matchKeyword(lexeme, length, "else", TOY_TOKEN_ELSE);
+				case 'n': return matchKeyword(lexeme, length, "null", TOY_TOKEN_NULL);
+				case 't': return lexeme[1] == 'y' ? matchKeyword(lexeme, length, "type", TOY_TOKEN_TYPE) : matchKeyword(lexeme, length, "true", TOY_TOKEN_LITERAL_TRUE);
+			}
+		break;
+
+		case 5:
+			switch(lexeme[0]) {
+				case 'b': return matchKeyword(lexeme, length, "break", TOY_TOKEN_BREAK);
+				case 'c': return lexeme[1] == 'l' ? matchKeyword(lexeme, length, "class", TOY_TOKEN_CLASS) : matchKeyword(lexeme, length, "const", TOY_TOKEN_CONST);
+				case 'f': return lexeme[1] == 'l' ? matchKeyword(lexeme, length, "float", TOY_TOKEN_FLOAT) : matchKeyword(lexeme, length, "false", TOY_TOKEN_LITERAL_FALSE);
+				case 'p': return matchKeyword(lexeme, length, "print", TOY_TOKEN_PRINT);
+				case 'w': return matchKeyword(lexeme, length, "while", TOY_TOKEN_WHILE);
+			}
+		break;
+
+		case 6:
+			switch(lexeme[0]) {
+				case 'a': return lexeme[2] == 's' ? matchKeyword(lexeme, length, "assert", TOY_TOKEN_ASSERT) : matchKeyword(lexeme, length, "astype", TOY_TOKEN_ASTYPE);
+				case 'e': return matchKeyword(lexeme, length, "export", TOY_TOKEN_EXPORT);
+				case 'i': return matchKeyword(lexeme, length, "import", TOY_TOKEN_IMPORT);
+				case 'o': return matchKeyword(lexeme, length, "opaque", TOY_TOKEN_OPAQUE);
+				case 'r': return matchKeyword(lexeme, length, "return", TOY_TOKEN_RETURN);
+				case 's': return matchKeyword(lexeme, length, "string", TOY_TOKEN_STRING);
+				case 't': return matchKeyword(lexeme, length, "typeof", TOY_TOKEN_TYPEOF);
+			}
+		break;
+
+		case 7:
+			return lexeme[0] == 'f' ? matchKeyword(lexeme, length, "foreach", TOY_TOKEN_FOREACH) : TOY_TOKEN_EOF;
+
+		case 8:
+			return lexeme[0] == 'c' ? matchKeyword(lexeme, length, "continue", TOY_TOKEN_CONTINUE) : TOY_TOKEN_EOF;
 	}
 
 	return TOY_TOKEN_EOF;
 }
+
+Toy_TokenType Toy_findTypeByKeyword(const char* keyword) {
+	return Toy_findTypeByLexeme(keyword, strlen(keyword));
+}
@@ -12,3 +12,6 @@ extern Toy_KeywordType Toy_keywordTypes[];
 char* Toy_findKeywordByType(Toy_TokenType type);
 
 Toy_TokenType Toy_findTypeByKeyword(const char* keyword);
+
+//returns TOY_TOKEN_EOF if the lexeme isn't a keyword
+Toy_TokenType Toy_findTypeByLexeme(const char* lexeme, int length);
@@ -235,25 +235,25 @@ static Toy_Token makeKeywordOrIdentifier(Toy_Lexer* lexer) {
 		advance(lexer);
 	}
 
-	//scan for a keyword
-	for (int i = 0; Toy_keywordTypes[i].keyword; i++) {
-		if (strlen(Toy_keywordTypes[i].keyword) == (size_t)(lexer->current - lexer->start) && !strncmp(Toy_keywordTypes[i].keyword, &lexer->source[lexer->start], lexer->current - lexer->start)) {
-			Toy_Token token;
+	//check for a keyword
+	Toy_TokenType type = Toy_findTypeByLexeme(&lexer->source[lexer->start], lexer->current - lexer->start);
 
-			token.type = Toy_keywordTypes[i].type;
-			token.lexeme = &lexer->source[lexer->start];
-			token.length = lexer->current - lexer->start;
-			token.line = lexer->line;
+	if (type != TOY_TOKEN_EOF) {
+		Toy_Token token;
+
+		token.type = type;
+		token.lexeme = &lexer->source[lexer->start];
+		token.length = lexer->current - lexer->start;
+		token.line = lexer->line;
 
 #ifndef TOY_EXPORT
-			if (Toy_commandLine.verbose) {
-				printf("kwd:");
-				Toy_private_printToken(&token);
-			}
+		if (Toy_commandLine.verbose) {
+			printf("kwd:");
+			Toy_private_printToken(&token);
+		}
 #endif
 
-			return token;
-		}
+		return token;
 	}
 
 	//return an identifier
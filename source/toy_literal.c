@@ -11,24 +11,120 @@
 #include <string.h>
 
 //hash util functions
+static uint64_t hashSeed = 0;
+
+//a wyhash-style string hash - the input is read 8 bytes at a time, and each pair of words is folded together with a 64x64->128 bit multiply
+static const uint64_t hashSecret[4] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 HashProduct;
+#endif
+
+static void hashMultiply(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+	HashProduct product = (HashProduct)*a * *b;
+	*a = (uint64_t)product;
+	*b = (uint64_t)(product >> 64);
+#else
+	//the same product, from 32-bit halves
+	uint64_t lolo = (*a & 0xFFFFFFFF) * (*b & 0xFFFFFFFF);
+	uint64_t lohi = (*a & 0xFFFFFFFF) * (*b >> 32);
+	uint64_t hilo = (*a >> 32) * (*b & 0xFFFFFFFF);
+	uint64_t hihi = (*a >> 32) * (*b >> 32);
+
+	uint64_t cross = (lolo >> 32) + (lohi & 0xFFFFFFFF) + hilo;
+
+	*a = (cross << 32) | (lolo & 0xFFFFFFFF);
+	*b = hihi + (lohi >> 32) + (cross >> 32);
+#endif
+}
+
+static uint64_t hashMix(uint64_t a, uint64_t b) {
+	hashMultiply(&a, &b);
+	return a ^ b;
+}
+
+static uint64_t hashRead64(const char* ptr) {
+	uint64_t result;
+	memcpy(&result, ptr, sizeof(result));
+	return result;
+}
+
+static uint64_t hashRead32(const char* ptr) {
+	uint32_t result;
+	memcpy(&result, ptr, sizeof(result));
+	return result;
+}
+
 static unsigned int hashString(const char* string, int length) {
-	unsigned int hash = 2166136261u;
+	const unsigned char* bytes = (const unsigned char*)string;
+	uint64_t seed = hashSeed ^ hashMix(hashSeed ^ hashSecret[0], hashSecret[1]);
+	uint64_t a = 0;
+	uint64_t b = 0;
+
+	if (length <= 16) {
+		//short strings are read as two overlapping halves, so every byte counts (including nulls)
+		if (length >= 4) {
+			int offset = (length >> 3) << 2;
+			a = (hashRead32(string) << 32) | hashRead32(string + offset);
+			b = (hashRead32(string + length - 4) << 32) | hashRead32(string + length - 4 - offset);
+		}
+		else if (length > 0) {
+			a = ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[length >> 1] << 8) | bytes[length - 1];
+		}
+	}
+	else {
+		const char* ptr = string;
+		int remaining = length;
+
+		//long strings are split across three independent lanes
+		if (remaining > 48) {
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+
+			do {
+				seed = hashMix(hashRead64(ptr) ^ hashSecret[1], hashRead64(ptr + 8) ^ seed);
+				seed1 = hashMix(hashRead64(ptr + 16) ^ hashSecret[2], hashRead64(ptr + 24) ^ seed1);
+				seed2 = hashMix(hashRead64(ptr + 32) ^ hashSecret[3], hashRead64(ptr + 40) ^ seed2);
+				ptr += 48;
+				remaining -= 48;
+			} while (remaining > 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (remaining > 16) {
+			seed = hashMix(hashRead64(ptr) ^ hashSecret[1], hashRead64(ptr + 8) ^ seed);
+			ptr += 16;
+			remaining -= 16;
+		}
 
-	for (int i = 0; i < length; i++) {
-		hash *= string[i];
-		hash ^= 16777619;
+		//the last 16 bytes, which may overlap the ones already read
+		a = hashRead64(ptr + remaining - 16);
+		b = hashRead64(ptr + remaining - 8);
 	}
 
-	return hash;
+	a ^= hashSecret[1];
+	b ^= seed;
+	hashMultiply(&a, &b);
+
+	uint64_t hash = hashMix(a ^ hashSecret[0] ^ (uint64_t)length, b ^ hashSecret[1]);
+	return (unsigned int)(hash ^ (hash >> 32));
 }
 
 static unsigned int hashUInt(unsigned int x) {
+    x ^= (unsigned int)hashSeed;
     x = ((x >> 16) ^ x) * 0x45d9f3b;
     x = ((x >> 16) ^ x) * 0x45d9f3b;
     x = (x >> 16) ^ x;
     return x;
 }
 
+//order-sensitive, so permutations of the same elements hash differently
+static unsigned int hashCombine(unsigned int hash, unsigned int element) {
+	return hash ^ (element + 0x9e3779b9u + (hash << 6) + (hash >> 2));
+}
+
 //exposed functions
 void Toy_freeLiteral(Toy_Literal literal) {
 	//refstrings
@@ -85,6 +181,9 @@ bool Toy_private_isTruthy(Toy_Literal x) {
 }
 
 Toy_Literal Toy_private_toIdentifierLiteral(Toy_RefString* ptr) {
+	//identical identifiers share one refstring, so comparing them is cheap
+	ptr = Toy_internRefString(ptr);
+
 	return ((Toy_Literal){{ .identifier = { .ptr = ptr, .hash = hashString(Toy_toCString(ptr), Toy_lengthRefString(ptr)) }},TOY_LITERAL_IDENTIFIER});
 }
 
@@ -116,40 +215,17 @@ Toy_Literal Toy_copyLiteral(Toy_Literal original) {
 		}
 
 		case TOY_LITERAL_ARRAY: {
+			//the elements are shared until either array is modified
 			Toy_LiteralArray* array = TOY_ALLOCATE(Toy_LiteralArray, 1);
-			Toy_initLiteralArray(array);
-
-			//preallocate enough space
-			array->capacity = TOY_AS_ARRAY(original)->capacity;
-			array->literals = TOY_GROW_ARRAY(Toy_Literal, array->literals, 0, array->capacity);
-
-			//copy each element
-			for (int i = 0; i < TOY_AS_ARRAY(original)->count; i++) {
-				Toy_pushLiteralArray(array, TOY_AS_ARRAY(original)->literals[i]);
-			}
+			Toy_shareLiteralArray(array, TOY_AS_ARRAY(original));
 
 			return TOY_TO_ARRAY_LITERAL(array);
 		}
 
 		case TOY_LITERAL_DICTIONARY: {
+			//the entries are shared until either dictionary is modified
 			Toy_LiteralDictionary* dictionary = TOY_ALLOCATE(Toy_LiteralDictionary, 1);
-			Toy_initLiteralDictionary(dictionary);
-
-			//preallocate enough space
-			dictionary->capacity = TOY_AS_DICTIONARY(original)->capacity;
-			dictionary->entries = TOY_ALLOCATE(Toy_private_dictionary_entry, dictionary->capacity);
-
-			for (int i = 0; i < dictionary->capacity; i++) {
-				dictionary->entries[i].key = TOY_TO_NULL_LITERAL;
-				dictionary->entries[i].value = TOY_TO_NULL_LITERAL;
-			}
-
-			//copy each entry
-			for (int i = 0; i < TOY_AS_DICTIONARY(original)->capacity; i++) {
-				if ( !TOY_IS_NULL(TOY_AS_DICTIONARY(original)->entries[i].key) ) {
-					Toy_setLiteralDictionary(dictionary, TOY_AS_DICTIONARY(original)->entries[i].key, TOY_AS_DICTIONARY(original)->entries[i].value);
-				}
-			}
+			Toy_shareLiteralDictionary(dictionary, TOY_AS_DICTIONARY(original));
 
 			return TOY_TO_DICTIONARY_LITERAL(dictionary);
 		}
@@ -283,6 +359,11 @@ bool Toy_literalsAreEqual(Toy_Literal lhs, Toy_Literal rhs) {
 				return false;
 			}
 
+			//shared buffers are always equal
+			if (TOY_AS_ARRAY(lhs)->literals == TOY_AS_ARRAY(rhs)->literals) {
+				return true;
+			}
+
 			//mismatched elements (in order)
 			for (int i = 0; i < TOY_AS_ARRAY(lhs)->count; i++) {
 				if (!Toy_literalsAreEqual( TOY_AS_ARRAY(lhs)->literals[i], TOY_AS_ARRAY(rhs)->literals[i] )) {
@@ -292,6 +373,11 @@ bool Toy_literalsAreEqual(Toy_Literal lhs, Toy_Literal rhs) {
 			return true;
 
 		case TOY_LITERAL_DICTIONARY:
+			//shared entries are always equal
+			if (TOY_AS_DICTIONARY(lhs)->entries == TOY_AS_DICTIONARY(rhs)->entries) {
+				return true;
+			}
+
 			//relatively slow, especially when nested
 			for (int i = 0; i < TOY_AS_DICTIONARY(lhs)->capacity; i++) {
 				if (!TOY_IS_NULL(TOY_AS_DICTIONARY(lhs)->entries[i].key)) { //only compare non-null keys
@@ -391,12 +477,12 @@ int Toy_hashLiteral(Toy_Literal lit) {
 		}
 
 		case TOY_LITERAL_STRING:
-			return hashString(Toy_toCString(TOY_AS_STRING(lit)), Toy_lengthRefString(TOY_AS_STRING(lit)));
+			return hashString(Toy_dataRefString(TOY_AS_STRING(lit)), Toy_lengthRefString(TOY_AS_STRING(lit)));
 
 		case TOY_LITERAL_ARRAY: {
 			unsigned int res = 0;
 			for (int i = 0; i < TOY_AS_ARRAY(lit)->count; i++) {
-				res += Toy_hashLiteral(TOY_AS_ARRAY(lit)->literals[i]);
+				res = hashCombine(res, Toy_hashLiteral(TOY_AS_ARRAY(lit)->literals[i]));
 			}
 			return hashUInt(res);
 		}
@@ -405,8 +491,8 @@ int Toy_hashLiteral(Toy_Literal lit) {
 			unsigned int res = 0;
 			for (int i = 0; i < TOY_AS_DICTIONARY(lit)->capacity; i++) {
 				if (!TOY_IS_NULL(TOY_AS_DICTIONARY(lit)->entries[i].key)) { //only hash non-null keys
-					res += Toy_hashLiteral(TOY_AS_DICTIONARY(lit)->entries[i].key);
-					res += Toy_hashLiteral(TOY_AS_DICTIONARY(lit)->entries[i].value);
+					//each pair is combined in order, but the pairs are summed, as equal dictionaries can hold them in any order
+					res += hashCombine(Toy_hashLiteral(TOY_AS_DICTIONARY(lit)->entries[i].key), Toy_hashLiteral(TOY_AS_DICTIONARY(lit)->entries[i].value));
 				}
 			}
 			return hashUInt(res);
@@ -434,29 +520,35 @@ int Toy_hashLiteral(Toy_Literal lit) {
 	}
 }
 
+void Toy_setLiteralHashSeed(unsigned int seed) {
+	hashSeed = seed == 0 ? 0 : hashMix(seed, hashSecret[2]);
+}
+
 //utils
 static void stdoutWrapper(const char* output) {
 	printf("%s", output);
 }
 
-//buffer the prints
-static char* globalPrintBuffer = NULL;
-static size_t globalPrintCapacity = 0;
-static size_t globalPrintCount = 0;
+//buffer the prints - each thread needs its own, as the print functions can't carry any state
+static _Thread_local char* globalPrintBuffer = NULL;
+static _Thread_local size_t globalPrintCapacity = 0;
+static _Thread_local size_t globalPrintCount = 0;
 
 //BUGFIX: string quotes shouldn't show when just printing strings, but should show when printing them as members of something else
-static char quotes = 0; //set to 0 to not show string quotes
+static _Thread_local char quotes = 0; //set to 0 to not show string quotes
 
 static void printToBuffer(const char* str) {
-	while (strlen(str) + globalPrintCount + 1 > globalPrintCapacity) {
+	size_t length = strlen(str);
+
+	while (length + globalPrintCount + 1 > globalPrintCapacity) {
 		int oldCapacity = globalPrintCapacity;
 
 		globalPrintCapacity = TOY_GROW_CAPACITY(globalPrintCapacity);
 		globalPrintBuffer = TOY_GROW_ARRAY(char, globalPrintBuffer, oldCapacity, globalPrintCapacity);
 	}
 
-	snprintf(globalPrintBuffer + globalPrintCount, strlen(str) + 1, "%s", str ? str : "\0");
-	globalPrintCount += strlen(str);
+	memcpy(globalPrintBuffer + globalPrintCount, str, length + 1);
+	globalPrintCount += length;
 }
 
 //exposed functions
@@ -496,14 +588,22 @@ void Toy_printLiteralCustom(Toy_Literal literal, Toy_PrintFn printFn) {
 		break;
 
 		case TOY_LITERAL_STRING: {
-			char buffer[TOY_MAX_STRING_LENGTH];
+			//refstrings are already terminated
 			if (!quotes) {
-				snprintf(buffer, TOY_MAX_STRING_LENGTH, "%.*s", (int)Toy_lengthRefString(TOY_AS_STRING(literal)), Toy_toCString(TOY_AS_STRING(literal)));
-			}
-			else {
-				snprintf(buffer, TOY_MAX_STRING_LENGTH, "%c%.*s%c", quotes, (int)Toy_lengthRefString(TOY_AS_STRING(literal)), Toy_toCString(TOY_AS_STRING(literal)), quotes);
+				printFn(Toy_toCString(TOY_AS_STRING(literal)));
+				break;
 			}
+
+			size_t length = Toy_lengthRefString(TOY_AS_STRING(literal));
+			char* buffer = TOY_ALLOCATE(char, length + 3);
+
+			buffer[0] = quotes;
+			memcpy(buffer + 1, Toy_dataRefString(TOY_AS_STRING(literal)), length);
+			buffer[length + 1] = quotes;
+			buffer[length + 2] = '\0';
+
 			printFn(buffer);
+			TOY_FREE_ARRAY(char, buffer, length + 3);
 		}
 		break;
 
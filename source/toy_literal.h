@@ -251,13 +251,6 @@ This macro is only valid on `TOY_LITERAL_FUNCTION`.
 !*/
 #define TOY_AS_FUNCTION_BYTECODE_LENGTH(lit)	(Toy_lengthRefFunction((lit).inner.ptr))
 
-/*!
-### TOY_MAX_STRING_LENGTH
-
-The maximum length of a string in Toy, which is 4096 bytes by default. This can be changed at compile time, but the results of doing so are not officially supported.
-!*/
-#define TOY_MAX_STRING_LENGTH					4096
-
 /*!
 ### TOY_HASH_I(lit)
 
@@ -333,9 +326,20 @@ types that can't be hashed are
 * any
 
 In the case of identifiers, their hashes are precomputed on creation and are stored within the literal.
+
+Strings and identifiers are hashed 8 bytes at a time, in the style of wyhash. Arrays combine the hashes of their elements in order, so `[1, 2]` and `[2, 1]` hash differently, while dictionaries combine each key with its value, and then sum the pairs, as equal dictionaries may hold their pairs in any order.
 !*/
 TOY_API int Toy_hashLiteral(Toy_Literal lit);
 
+/*!
+### void Toy_setLiteralHashSeed(unsigned int seed)
+
+This function mixes `seed` into every hash found by `Toy_hashLiteral()` afterwards, so the order of entries in a dictionary (and which keys collide) can't be predicted without knowing it. This can be used to resist "hash flooding", where a script is handed many keys chosen to collide. The default seed is `0`, which keeps hashes identical between runs.
+
+Since dictionaries and identifiers store the hashes they were created with, this must be called before any literals are created, such as at the start of `main()`, and not while other threads are running.
+!*/
+TOY_API void Toy_setLiteralHashSeed(unsigned int seed);
+
 /*!
 ### void Toy_printLiteral(Toy_Literal literal)
 
@@ -2,9 +2,47 @@
 
 #include "toy_memory.h"
 
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
+//the literals are stored just after a reference counter, so copies of an array can share them until one is modified
+typedef struct LiteralBuffer {
+	atomic_int refCount;
+	Toy_Literal literals[];
+} LiteralBuffer;
+
+#define BUFFER_SIZE(capacity) (sizeof(LiteralBuffer) + sizeof(Toy_Literal) * (capacity))
+#define BUFFER_OF(array) ((LiteralBuffer*)((char*)((array)->literals) - offsetof(LiteralBuffer, literals)))
+
+//util functions
+static void growBuffer(Toy_LiteralArray* array, int capacity) {
+	LiteralBuffer* buffer = NULL;
+
+	if (array->capacity > 0) {
+		buffer = Toy_reallocate(BUFFER_OF(array), BUFFER_SIZE(array->capacity), BUFFER_SIZE(capacity));
+	}
+	else {
+		buffer = Toy_reallocate(NULL, 0, BUFFER_SIZE(capacity));
+		atomic_init(&buffer->refCount, 1);
+	}
+
+	array->literals = buffer->literals;
+	array->capacity = capacity;
+}
+
+//clean up memory, if this was the last reference to it
+static void releaseBuffer(LiteralBuffer* buffer, int count, int capacity) {
+	if (atomic_fetch_sub_explicit(&buffer->refCount, 1, memory_order_acq_rel) == 1) {
+		for(int i = 0; i < count; i++) {
+			Toy_freeLiteral(buffer->literals[i]);
+		}
+
+		Toy_reallocate(buffer, BUFFER_SIZE(capacity), 0);
+	}
+}
+
 //exposed functions
 void Toy_initLiteralArray(Toy_LiteralArray* array) {
 	array->capacity = 0;
@@ -13,23 +51,45 @@ void Toy_initLiteralArray(Toy_LiteralArray* array) {
 }
 
 void Toy_freeLiteralArray(Toy_LiteralArray* array) {
-	//clean up memory
-	for(int i = 0; i < array->count; i++) {
-		Toy_freeLiteral(array->literals[i]);
+	if (array->capacity > 0) {
+		releaseBuffer(BUFFER_OF(array), array->count, array->capacity);
 	}
 
+	Toy_initLiteralArray(array);
+}
+
+void Toy_shareLiteralArray(Toy_LiteralArray* array, Toy_LiteralArray* original) {
+	*array = *original;
+
 	if (array->capacity > 0) {
-		TOY_FREE_ARRAY(Toy_Literal, array->literals, array->capacity);
-		Toy_initLiteralArray(array);
+		atomic_fetch_add_explicit(&BUFFER_OF(array)->refCount, 1, memory_order_relaxed);
 	}
 }
 
+void Toy_unshareLiteralArray(Toy_LiteralArray* array) {
+	if (array->capacity == 0 || atomic_load_explicit(&BUFFER_OF(array)->refCount, memory_order_acquire) <= 1) {
+		return;
+	}
+
+	//give this array its own copy of the literals
+	LiteralBuffer* original = BUFFER_OF(array);
+	LiteralBuffer* buffer = Toy_reallocate(NULL, 0, BUFFER_SIZE(array->capacity));
+	atomic_init(&buffer->refCount, 1);
+
+	for (int i = 0; i < array->count; i++) {
+		buffer->literals[i] = Toy_copyLiteral(original->literals[i]);
+	}
+
+	//the other copies may have been freed in the meantime, on another thread
+	releaseBuffer(original, array->count, array->capacity);
+	array->literals = buffer->literals;
+}
+
 int Toy_pushLiteralArray(Toy_LiteralArray* array, Toy_Literal literal) {
-	if (array->capacity < array->count + 1) {
-		int oldCapacity = array->capacity;
+	Toy_unshareLiteralArray(array);
 
-		array->capacity = TOY_GROW_CAPACITY(oldCapacity);
-		array->literals = TOY_GROW_ARRAY(Toy_Literal, array->literals, oldCapacity, array->capacity);
+	if (array->capacity < array->count + 1) {
+		growBuffer(array, TOY_GROW_CAPACITY(array->capacity));
 	}
 
 	array->literals[array->count] = Toy_copyLiteral(literal);
@@ -41,6 +101,8 @@ Toy_Literal Toy_popLiteralArray(Toy_LiteralArray* array) {
 		return TOY_TO_NULL_LITERAL;
 	}
 
+	Toy_unshareLiteralArray(array);
+
 	//get the return
 	Toy_Literal ret = array->literals[array->count-1];
 
@@ -79,6 +141,8 @@ bool Toy_setLiteralArray(Toy_LiteralArray* array, Toy_Literal index, Toy_Literal
 		return false;
 	}
 
+	Toy_unshareLiteralArray(array);
+
 	Toy_freeLiteral(array->literals[idx]);
 	array->literals[idx] = Toy_copyLiteral(value);
 
@@ -5,6 +5,8 @@
 
 This header defines the array structure, which manages a series of `Toy_Literal` instances in sequential memory. The array does not take ownership of given literals, instead it makes an internal copy.
 
+The internal buffer is reference counted, and can be shared between several arrays (see `Toy_shareLiteralArray()`). Any function here that modifies an array will first give it a private copy of a shared buffer, so copying an array is cheap, while each copy still behaves as an independent value.
+
 The array type is one of two fundemental data structures used throughout Toy - the other is the dictionary.
 !*/
 
@@ -32,10 +34,24 @@ TOY_API void Toy_initLiteralArray(Toy_LiteralArray* array);
 /*!
 ### void Toy_freeLiteralArray(Toy_LiteralArray* array)
 
-This function frees a `Toy_LiteralArray` pointed to by `array`. Every literal within is passed to `Toy_freeLiteral()` before its memory is released.
+This function frees a `Toy_LiteralArray` pointed to by `array`. If this was the last reference to the internal buffer, every literal within is passed to `Toy_freeLiteral()` before its memory is released.
 !*/
 TOY_API void Toy_freeLiteralArray(Toy_LiteralArray* array);
 
+/*!
+### void Toy_shareLiteralArray(Toy_LiteralArray* array, Toy_LiteralArray* original)
+
+This function initializes `array` as a copy of `original`, sharing the internal buffer rather than copying each element. This is how `Toy_copyLiteral()` copies arrays.
+!*/
+TOY_API void Toy_shareLiteralArray(Toy_LiteralArray* array, Toy_LiteralArray* original);
+
+/*!
+### void Toy_unshareLiteralArray(Toy_LiteralArray* array)
+
+If the internal buffer of `array` is shared with another array, this function gives `array` its own copy of it. This must be called before modifying the contents of `array->literals` directly, but is handled automatically by the other functions here.
+!*/
+TOY_API void Toy_unshareLiteralArray(Toy_LiteralArray* array);
+
 /*!
 ### int Toy_pushLiteralArray(Toy_LiteralArray* array, Toy_Literal literal)
 
@@ -4,9 +4,103 @@
 
 #include "toy_console_colors.h"
 
+#include <stdatomic.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define USE_SSE2
+#endif
+
+//the entries are stored just after a reference counter, so copies of a dictionary can share them until one is modified
+typedef struct EntryBuffer {
+	atomic_int refCount;
+	Toy_private_dictionary_entry entries[];
+} EntryBuffer;
+
+//one control byte per entry follows the entries, in the same allocation
+#define BUFFER_SIZE(capacity) (sizeof(EntryBuffer) + (sizeof(Toy_private_dictionary_entry) + 1) * (capacity))
+#define BUFFER_OF(ptr) ((EntryBuffer*)((char*)(ptr) - offsetof(EntryBuffer, entries)))
+#define CONTROL_OF(ptr, capacity) ((signed char*)((ptr) + (capacity)))
+
+//the control bytes are probed a group at a time - a full slot holds 7 bits of its hash, and empty or deleted slots have the high bit set
+#define GROUP_WIDTH 16
+#define CONTROL_EMPTY ((signed char)-128)
+#define CONTROL_DELETED ((signed char)-2)
+
+#define HASH_GROUP(hash) ((hash) >> 7)
+#define HASH_FRAGMENT(hash) ((signed char)((hash) & 0x7F))
+
+//one bit for each slot in a group
+typedef unsigned int GroupMask;
+
+static GroupMask matchControl(const signed char* group, signed char control) {
+#ifdef USE_SSE2
+	__m128i bytes = _mm_loadu_si128((const __m128i*)group);
+	return (GroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(control)));
+#else
+	GroupMask mask = 0;
+	for (int i = 0; i < GROUP_WIDTH; i++) {
+		mask |= (GroupMask)(group[i] == control) << i;
+	}
+	return mask;
+#endif
+}
+
+static GroupMask matchFree(const signed char* group) {
+#ifdef USE_SSE2
+	return (GroupMask)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+	GroupMask mask = 0;
+	for (int i = 0; i < GROUP_WIDTH; i++) {
+		mask |= (GroupMask)(group[i] < 0) << i;
+	}
+	return mask;
+#endif
+}
+
+static int lowestBit(GroupMask mask) {
+#if defined(__GNUC__)
+	return __builtin_ctz(mask);
+#else
+	int index = 0;
+	while (!(mask & 1)) {
+		mask >>= 1;
+		index++;
+	}
+	return index;
+#endif
+}
+
+//the smallest capacity that holds "count" entries without exceeding the max load
+static int capacityFor(int count) {
+	int capacity = GROUP_WIDTH;
+
+	while (count + 1 > capacity * TOY_DICTIONARY_MAX_LOAD) {
+		capacity *= 2;
+	}
+
+	return capacity;
+}
 
 //util functions
+static Toy_private_dictionary_entry* allocateEntryArray(int capacity) {
+	EntryBuffer* buffer = Toy_reallocate(NULL, 0, BUFFER_SIZE(capacity));
+	atomic_init(&buffer->refCount, 1);
+
+	for (int i = 0; i < capacity; i++) {
+		buffer->entries[i].key = TOY_TO_NULL_LITERAL;
+		buffer->entries[i].value = TOY_TO_NULL_LITERAL;
+		buffer->entries[i].hash = 0;
+	}
+
+	memset(CONTROL_OF(buffer->entries, capacity), CONTROL_EMPTY, capacity);
+
+	return buffer->entries;
+}
+
 static void setEntryValues(Toy_private_dictionary_entry* entry, Toy_Literal key, Toy_Literal value) {
 	//much simpler now
 	Toy_freeLiteral(entry->key);
@@ -16,96 +110,87 @@ static void setEntryValues(Toy_private_dictionary_entry* entry, Toy_Literal key,
 	entry->value = Toy_copyLiteral(value);
 }
 
-static Toy_private_dictionary_entry* getEntryArray(Toy_private_dictionary_entry* array, int capacity, Toy_Literal key, unsigned int hash, bool mustExist) {
+//returns the index of "key", or -1 if it isn't present
+static int findEntry(Toy_private_dictionary_entry* array, int capacity, Toy_Literal key, unsigned int hash, int* groupsProbed) {
 	if (!capacity) {
-		return NULL;
+		return -1;
 	}
 
-	//find "key", starting at index
-	int index = hash % capacity;
-	int start = index;
+	signed char* control = CONTROL_OF(array, capacity);
+	const int groupMask = capacity / GROUP_WIDTH - 1;
+	const signed char fragment = HASH_FRAGMENT(hash);
+	int group = HASH_GROUP(hash) & groupMask;
 
-	//increment once, so it can't equal start
-	if (++index >= capacity) {
-		index = 0;
-	}
+	//triangular probing visits every group once
+	for (int step = 1; step <= groupMask + 1; step++) {
+		const signed char* ptr = control + group * GROUP_WIDTH;
 
-	//literal probing and collision checking
-	while (index != start) { //WARNING: this is the only function allowed to retrieve an entry from the array
-		Toy_private_dictionary_entry* entry = &array[index];
+		for (GroupMask mask = matchControl(ptr, fragment); mask; mask &= mask - 1) {
+			int index = group * GROUP_WIDTH + lowestBit(mask);
 
-		if (TOY_IS_NULL(entry->key)) { //if key is empty, it's either empty or tombstone
-			if (TOY_IS_NULL(entry->value) && !mustExist) {
-				//found a truly empty bucket
-				return entry;
-			}
-			//else it's a tombstone - ignore
-		} else {
-			if (Toy_literalsAreEqual(key, entry->key)) {
-				return entry;
+			if (array[index].hash == hash && Toy_literalsAreEqual(key, array[index].key)) {
+				if (groupsProbed != NULL) {
+					*groupsProbed = step;
+				}
+				return index;
 			}
 		}
 
-		if (++index >= capacity) {
-			index = 0;
+		//a key is never placed beyond a group with an empty slot
+		if (matchControl(ptr, CONTROL_EMPTY)) {
+			return -1;
 		}
-		//index = (index + 1) % capacity;
+
+		group = (group + step) & groupMask;
 	}
 
-	return NULL;
+	return -1;
 }
 
-static void adjustEntryCapacity(Toy_private_dictionary_entry** dictionaryHandle, int oldCapacity, int capacity) {
-	//new entry space
-	Toy_private_dictionary_entry* newEntries = TOY_ALLOCATE(Toy_private_dictionary_entry, capacity);
+//returns the index of the first empty or deleted slot along the probe sequence for "hash"
+static int findFreeEntry(Toy_private_dictionary_entry* array, int capacity, unsigned int hash) {
+	signed char* control = CONTROL_OF(array, capacity);
+	const int groupMask = capacity / GROUP_WIDTH - 1;
+	int group = HASH_GROUP(hash) & groupMask;
 
-	for (int i = 0; i < capacity; i++) {
-		newEntries[i].key = TOY_TO_NULL_LITERAL;
-		newEntries[i].value = TOY_TO_NULL_LITERAL;
-	}
+	for (int step = 1; step <= groupMask + 1; step++) {
+		GroupMask mask = matchFree(control + group * GROUP_WIDTH);
 
-	//move the old array into the new one
-	for (int i = 0; i < oldCapacity; i++) {
-		if (TOY_IS_NULL((*dictionaryHandle)[i].key)) {
-			continue;
+		if (mask) {
+			return group * GROUP_WIDTH + lowestBit(mask);
 		}
 
-		//place the key and value in the new array (reusing string memory)
-		Toy_private_dictionary_entry* entry = getEntryArray(newEntries, capacity, TOY_TO_NULL_LITERAL, Toy_hashLiteral((*dictionaryHandle)[i].key), false);
-
-		entry->key = (*dictionaryHandle)[i].key;
-		entry->value = (*dictionaryHandle)[i].value;
+		group = (group + step) & groupMask;
 	}
 
-	//clear the old array
-	if (oldCapacity > 0) {
-		TOY_FREE_ARRAY(Toy_private_dictionary_entry, *dictionaryHandle, oldCapacity);
-	}
-
-	*dictionaryHandle = newEntries;
+	return -1; //unreachable while the load is below 100%
 }
 
-static bool setEntryArray(Toy_private_dictionary_entry** dictionaryHandle, int* capacityPtr, int contains, Toy_Literal key, Toy_Literal value, int hash) {
-	//expand array if needed
-	if (contains + 1 > *capacityPtr * TOY_DICTIONARY_MAX_LOAD) {
-		int oldCapacity = *capacityPtr;
-		*capacityPtr = TOY_GROW_CAPACITY(*capacityPtr);
-		adjustEntryCapacity(dictionaryHandle, oldCapacity, *capacityPtr); //custom rather than automatic reallocation
-	}
+static void adjustEntryCapacity(Toy_LiteralDictionary* dictionary, int capacity) {
+	//new entry space
+	Toy_private_dictionary_entry* newEntries = allocateEntryArray(capacity);
+	signed char* newControl = CONTROL_OF(newEntries, capacity);
 
-	Toy_private_dictionary_entry* entry = getEntryArray(*dictionaryHandle, *capacityPtr, key, hash, false);
+	//move the old array into the new one, using the cached hashes
+	for (int i = 0; i < dictionary->capacity; i++) {
+		if (TOY_IS_NULL(dictionary->entries[i].key)) {
+			continue;
+		}
 
-	//true = contains increase
-	if (TOY_IS_NULL(entry->key)) {
-		setEntryValues(entry, key, value);
-		return true;
+		int index = findFreeEntry(newEntries, capacity, dictionary->entries[i].hash);
+
+		newEntries[index] = dictionary->entries[i];
+		newControl[index] = HASH_FRAGMENT(dictionary->entries[i].hash);
 	}
-	else {
-		setEntryValues(entry, key, value);
-		return false;
+
+	//clear the old array (never shared at this point), which also drops every tombstone
+	if (dictionary->capacity > 0) {
+		Toy_reallocate(BUFFER_OF(dictionary->entries), BUFFER_SIZE(dictionary->capacity), 0);
 	}
 
-	return false;
+	dictionary->entries = newEntries;
+	dictionary->capacity = capacity;
+	dictionary->contains = dictionary->count;
 }
 
 static void freeEntry(Toy_private_dictionary_entry* entry) {
@@ -120,13 +205,18 @@ static void freeEntryArray(Toy_private_dictionary_entry* array, int capacity) {
 		return;
 	}
 
+	//only clean up memory if this was the last reference to it
+	if (atomic_fetch_sub_explicit(&BUFFER_OF(array)->refCount, 1, memory_order_acq_rel) > 1) {
+		return;
+	}
+
 	for (int i = 0; i < capacity; i++) {
 		if (!TOY_IS_NULL(array[i].key)) {
 			freeEntry(&array[i]);
 		}
 	}
 
-	TOY_FREE_ARRAY(Toy_private_dictionary_entry, array, capacity);
+	Toy_reallocate(BUFFER_OF(array), BUFFER_SIZE(capacity), 0);
 }
 
 //exposed functions
@@ -141,11 +231,41 @@ void Toy_initLiteralDictionary(Toy_LiteralDictionary* dictionary) {
 void Toy_freeLiteralDictionary(Toy_LiteralDictionary* dictionary) {
 	if (dictionary->capacity > 0) {
 		freeEntryArray(dictionary->entries, dictionary->capacity);
-		dictionary->capacity = 0;
-		dictionary->contains = 0;
+	}
+
+	Toy_initLiteralDictionary(dictionary);
+}
+
+void Toy_shareLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_LiteralDictionary* original) {
+	*dictionary = *original;
+
+	if (dictionary->capacity > 0) {
+		atomic_fetch_add_explicit(&BUFFER_OF(dictionary->entries)->refCount, 1, memory_order_relaxed);
 	}
 }
 
+void Toy_unshareLiteralDictionary(Toy_LiteralDictionary* dictionary) {
+	if (dictionary->capacity == 0 || atomic_load_explicit(&BUFFER_OF(dictionary->entries)->refCount, memory_order_acquire) <= 1) {
+		return;
+	}
+
+	//give this dictionary its own copy of the entries, in the same positions (including tombstones)
+	Toy_private_dictionary_entry* original = dictionary->entries;
+	Toy_private_dictionary_entry* entries = allocateEntryArray(dictionary->capacity);
+
+	for (int i = 0; i < dictionary->capacity; i++) {
+		entries[i].key = Toy_copyLiteral(original[i].key);
+		entries[i].value = Toy_copyLiteral(original[i].value);
+		entries[i].hash = original[i].hash;
+	}
+
+	memcpy(CONTROL_OF(entries, dictionary->capacity), CONTROL_OF(original, dictionary->capacity), dictionary->capacity);
+
+	//the other copies may have been freed in the meantime, on another thread
+	freeEntryArray(original, dictionary->capacity);
+	dictionary->entries = entries;
+}
+
 void Toy_setLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key, Toy_Literal value) {
 	if (TOY_IS_NULL(key)) {
 		fprintf(stderr, TOY_CC_ERROR "Dictionaries can't have null keys (set)\n" TOY_CC_RESET);
@@ -163,12 +283,33 @@ void Toy_setLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key
 		return;
 	}
 
-	const int increment = setEntryArray(&dictionary->entries, &dictionary->capacity, dictionary->contains, key, value, Toy_hashLiteral(key));
+	Toy_unshareLiteralDictionary(dictionary);
+
+	const unsigned int hash = Toy_hashLiteral(key);
+	int index = findEntry(dictionary->entries, dictionary->capacity, key, hash, NULL);
+
+	if (index >= 0) {
+		setEntryValues(&dictionary->entries[index], key, value);
+		return;
+	}
+
+	//grow the array, or just clear out the tombstones, if needed
+	if (dictionary->contains + 1 > dictionary->capacity * TOY_DICTIONARY_MAX_LOAD) {
+		adjustEntryCapacity(dictionary, capacityFor(dictionary->count)); //custom rather than automatic reallocation
+	}
+
+	index = findFreeEntry(dictionary->entries, dictionary->capacity, hash);
+	signed char* control = CONTROL_OF(dictionary->entries, dictionary->capacity);
 
-	if (increment) {
+	//tombstones are already counted
+	if (control[index] == CONTROL_EMPTY) {
 		dictionary->contains++;
-		dictionary->count++;
 	}
+
+	control[index] = HASH_FRAGMENT(hash);
+	dictionary->entries[index].hash = hash;
+	setEntryValues(&dictionary->entries[index], key, value);
+	dictionary->count++;
 }
 
 Toy_Literal Toy_getLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key) {
@@ -188,10 +329,10 @@ Toy_Literal Toy_getLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Lite
 		return TOY_TO_NULL_LITERAL;
 	}
 
-	Toy_private_dictionary_entry* entry = getEntryArray(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), true);
+	int index = findEntry(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), NULL);
 
-	if (entry != NULL) {
-		return Toy_copyLiteral(entry->value);
+	if (index >= 0) {
+		return Toy_copyLiteral(dictionary->entries[index].value);
 	}
 	else {
 		return TOY_TO_NULL_LITERAL;
@@ -215,17 +356,41 @@ void Toy_removeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal
 		return;
 	}
 
-	Toy_private_dictionary_entry* entry = getEntryArray(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), true);
+	int index = findEntry(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), NULL);
 
-	if (entry != NULL) {
-		freeEntry(entry);
-		entry->value = TOY_TO_BOOLEAN_LITERAL(true); //tombstone
-		dictionary->count--;
+	if (index < 0) {
+		return;
+	}
+
+	Toy_unshareLiteralDictionary(dictionary);
+
+	freeEntry(&dictionary->entries[index]);
+	dictionary->count--;
+
+	//no probe sequence continues past a group with an empty slot, so this slot can be emptied rather than tombstoned
+	signed char* control = CONTROL_OF(dictionary->entries, dictionary->capacity);
+	signed char* group = control + index / GROUP_WIDTH * GROUP_WIDTH;
+
+	if (matchControl(group, CONTROL_EMPTY)) {
+		control[index] = CONTROL_EMPTY;
+		dictionary->contains--;
+	}
+	else {
+		control[index] = CONTROL_DELETED;
+	}
+
+	//shrink the array once it's mostly empty
+	if (dictionary->capacity > GROUP_WIDTH && dictionary->count < dictionary->capacity * TOY_DICTIONARY_MIN_LOAD) {
+		adjustEntryCapacity(dictionary, capacityFor(dictionary->count));
 	}
 }
 
 bool Toy_existsLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key) {
-	//null & not tombstoned
-	Toy_private_dictionary_entry* entry = getEntryArray(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), false);
-	return entry != NULL && !(TOY_IS_NULL(entry->key) && TOY_IS_NULL(entry->value));
+	return findEntry(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), NULL) >= 0;
+}
+
+int Toy_probeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key) {
+	int groupsProbed = 0;
+	findEntry(dictionary->entries, dictionary->capacity, key, Toy_hashLiteral(key), &groupsProbed);
+	return groupsProbed;
 }
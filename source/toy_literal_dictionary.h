@@ -5,6 +5,10 @@
 
 This header defines the dictionary structure (as well as the private entry structure), which manages a series of `Toy_Literal` instances stored in a key-value hash map. The dictionary does not take ownership of given literals, instead it makes an internal copy.
 
+The entries are laid out as a "Swiss table" - alongside them is an array of control bytes, one per entry, holding either 7 bits of that entry's hash or a marker for an empty or deleted slot. Lookups compare a group of 16 control bytes at once (using SSE2 where it's available), and only look at the entries whose bits match. Unused entries always have a null key, so the entries can be iterated directly, from `0` to `capacity`.
+
+The internal entries are reference counted, and can be shared between several dictionaries (see `Toy_shareLiteralDictionary()`). Any function here that modifies a dictionary will first give it a private copy of shared entries.
+
 The dictionary type is one of two fundemental data structures used throughout Toy - the other is the array.
 !*/
 
@@ -26,12 +30,22 @@ Since this process can be memory and time intensive, a configurable macro is use
 The current default value is `0.75`, representing 75% capacity.
 !*/
 
-//TODO: benchmark this
 #define TOY_DICTIONARY_MAX_LOAD 0.75
 
+/*!
+### TOY_DICTIONARY_MIN_LOAD
+
+If removing an entry leaves a dictionary with less than this percentage of it's capacity in use, then the dictionary is moved into a smaller buffer.
+
+The current default value is `0.125`, representing 12.5% capacity.
+!*/
+
+#define TOY_DICTIONARY_MIN_LOAD 0.125
+
 typedef struct Toy_private_dictionary_entry {
 	Toy_Literal key;
 	Toy_Literal value;
+	unsigned int hash; //cached, so the entries can be moved without hashing each key again
 } Toy_private_dictionary_entry;
 
 typedef struct Toy_LiteralDictionary {
@@ -55,14 +69,28 @@ TOY_API void Toy_initLiteralDictionary(Toy_LiteralDictionary* dictionary);
 /*!
 ### void Toy_freeLiteralDictionary(Toy_LiteralDictionary* dictionary)
 
-This function frees a `Toy_LiteralDictionary` pointed to by `dictionary`. Every literal within is passed to `Toy_freeLiteral()` before its memory is released.
+This function frees a `Toy_LiteralDictionary` pointed to by `dictionary`. If this was the last reference to the internal entries, every literal within is passed to `Toy_freeLiteral()` before its memory is released.
 !*/
 TOY_API void Toy_freeLiteralDictionary(Toy_LiteralDictionary* dictionary);
 
+/*!
+### void Toy_shareLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_LiteralDictionary* original)
+
+This function initializes `dictionary` as a copy of `original`, sharing the internal entries rather than copying each key and value. This is how `Toy_copyLiteral()` copies dictionaries.
+!*/
+TOY_API void Toy_shareLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_LiteralDictionary* original);
+
+/*!
+### void Toy_unshareLiteralDictionary(Toy_LiteralDictionary* dictionary)
+
+If the internal entries of `dictionary` are shared with another dictionary, this function gives `dictionary` its own copy of them. This must be called before modifying `dictionary->entries` directly, but is handled automatically by the other functions here.
+!*/
+TOY_API void Toy_unshareLiteralDictionary(Toy_LiteralDictionary* dictionary);
+
 /*!
 ### void Toy_setLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key, Toy_Literal value)
 
-This function inserts the given key-value pair of literals into `dictionary`, creating it if it doesn't exist, or freeing and overwriting it if `key` is already present. This function may also expand the memory buffer if needed.
+This function inserts the given key-value pair of literals into `dictionary`, creating it if it doesn't exist, or freeing and overwriting it if `key` is already present. This function may also expand the memory buffer (or clear out removed entries) if needed.
 
 When expanding the memory buffer, a full copy of the existing dictionary's contents is created - this can be memory intensive.
 
@@ -82,7 +110,7 @@ TOY_API Toy_Literal Toy_getLiteralDictionary(Toy_LiteralDictionary* dictionary,
 /*!
 ### void Toy_removeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key)
 
-This function removes the key-value pair of literals from `dictionary` identified by `key`, if it exists.
+This function removes the key-value pair of literals from `dictionary` identified by `key`, if it exists. This function may also shrink the memory buffer, if it's mostly empty.
 
 Literal functions and opaques cannot be used as keys.
 !*/
@@ -94,3 +122,10 @@ TOY_API void Toy_removeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_
 This function returns true if the key-value pair identified by `key` exists within `dictionary`, otherwise it returns false.
 !*/
 TOY_API bool Toy_existsLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key);
+
+/*!
+### int Toy_probeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key)
+
+This function returns the number of groups of entries that were searched to find `key` within `dictionary` (at least `1`), or `0` if it doesn't exist, for debugging.
+!*/
+TOY_API int Toy_probeLiteralDictionary(Toy_LiteralDictionary* dictionary, Toy_Literal key);
@@ -1,11 +1,13 @@
 #include "toy_memory.h"
 #include "toy_refstring.h"
 #include "toy_reffunction.h"
+#include "toy_context.h"
 
 #include "toy_console_colors.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 //default allocator
 void* Toy_private_defaultMemoryAllocator(void* pointer, size_t oldSize, size_t newSize) {
@@ -29,12 +31,228 @@ void* Toy_private_defaultMemoryAllocator(void* pointer, size_t oldSize, size_t n
 	return mem;
 }
 
-//static variables
-static Toy_MemoryAllocatorFn allocator = Toy_private_defaultMemoryAllocator;
-
 //exposed API
 void* Toy_reallocate(void* pointer, size_t oldSize, size_t newSize) {
-	return allocator(pointer, oldSize, newSize);
+	return Toy_getContext()->allocator(pointer, oldSize, newSize);
+}
+
+//memory regions - small allocations are carved out of large chunks, and recycled by size class
+#define TOY_REGION_CHUNK_SIZE (64 * 1024)
+#define TOY_REGION_MIN_CLASS_SIZE 16
+#define TOY_REGION_CLASS_COUNT 10 //16 bytes up to 8KB, anything larger gets a chunk of its own
+
+typedef struct Toy_private_region_chunk {
+	unsigned char* start;
+	size_t size;
+	bool dedicated; //holds a single large allocation
+} Toy_private_region_chunk;
+
+typedef struct Toy_private_region_free_block {
+	struct Toy_private_region_free_block* next;
+} Toy_private_region_free_block;
+
+//each context can have a region of its own
+typedef struct Toy_private_memory_region {
+	Toy_MemoryAllocatorFn backing; //where the chunks come from
+
+	Toy_private_region_chunk* chunks; //sorted by address
+	int chunkCapacity;
+	int chunkCount;
+
+	unsigned char* bump;
+	size_t bumpRemaining;
+
+	Toy_private_region_free_block* freeLists[TOY_REGION_CLASS_COUNT];
+} Toy_private_memory_region;
+
+static int regionSizeClass(size_t size) {
+	size_t classSize = TOY_REGION_MIN_CLASS_SIZE;
+
+	for (int i = 0; i < TOY_REGION_CLASS_COUNT; i++) {
+		if (size <= classSize) {
+			return i;
+		}
+		classSize <<= 1;
+	}
+
+	return -1;
+}
+
+//find the chunk containing the pointer, or -1 if it was allocated outside of the region
+static int regionFindChunk(Toy_private_memory_region* region, void* pointer) {
+	unsigned char* ptr = (unsigned char*)pointer;
+	int low = 0;
+	int high = region->chunkCount - 1;
+
+	while (low <= high) {
+		int mid = (low + high) / 2;
+
+		if (ptr < region->chunks[mid].start) {
+			high = mid - 1;
+		}
+		else if (ptr >= region->chunks[mid].start + region->chunks[mid].size) {
+			low = mid + 1;
+		}
+		else {
+			return mid;
+		}
+	}
+
+	return -1;
+}
+
+static bool regionInsertChunk(Toy_private_memory_region* region, unsigned char* start, size_t size, bool dedicated) {
+	if (region->chunkCount + 1 > region->chunkCapacity) {
+		int oldCapacity = region->chunkCapacity;
+		region->chunkCapacity = TOY_GROW_CAPACITY(oldCapacity);
+
+		Toy_private_region_chunk* chunks = region->backing(region->chunks, sizeof(Toy_private_region_chunk) * oldCapacity, sizeof(Toy_private_region_chunk) * region->chunkCapacity);
+
+		if (chunks == NULL) {
+			region->chunkCapacity = oldCapacity;
+			return false;
+		}
+
+		region->chunks = chunks;
+	}
+
+	//keep the chunks sorted
+	int index = region->chunkCount;
+	while (index > 0 && region->chunks[index - 1].start > start) {
+		region->chunks[index] = region->chunks[index - 1];
+		index--;
+	}
+
+	region->chunks[index].start = start;
+	region->chunks[index].size = size;
+	region->chunks[index].dedicated = dedicated;
+	region->chunkCount++;
+
+	return true;
+}
+
+static void regionRemoveChunk(Toy_private_memory_region* region, int index) {
+	for (int i = index; i < region->chunkCount - 1; i++) {
+		region->chunks[i] = region->chunks[i + 1];
+	}
+
+	region->chunkCount--;
+}
+
+static void* regionAllocate(Toy_private_memory_region* region, size_t size) {
+	int sizeClass = regionSizeClass(size);
+
+	//large allocations are handed straight to the backing allocator, but still belong to the region
+	if (sizeClass < 0) {
+		unsigned char* mem = region->backing(NULL, 0, size);
+
+		if (mem != NULL && !regionInsertChunk(region, mem, size, true)) {
+			region->backing(mem, size, 0);
+			return NULL;
+		}
+
+		return mem;
+	}
+
+	//reuse a freed block of the same size class
+	if (region->freeLists[sizeClass] != NULL) {
+		Toy_private_region_free_block* block = region->freeLists[sizeClass];
+		region->freeLists[sizeClass] = block->next;
+		return block;
+	}
+
+	//carve a new block out of the current chunk, the tail of a full chunk is abandoned
+	size_t classSize = (size_t)TOY_REGION_MIN_CLASS_SIZE << sizeClass;
+
+	if (region->bumpRemaining < classSize) {
+		unsigned char* chunk = region->backing(NULL, 0, TOY_REGION_CHUNK_SIZE);
+
+		if (chunk == NULL) {
+			return NULL;
+		}
+
+		if (!regionInsertChunk(region, chunk, TOY_REGION_CHUNK_SIZE, false)) {
+			region->backing(chunk, TOY_REGION_CHUNK_SIZE, 0);
+			return NULL;
+		}
+
+		region->bump = chunk;
+		region->bumpRemaining = TOY_REGION_CHUNK_SIZE;
+	}
+
+	void* mem = region->bump;
+	region->bump += classSize;
+	region->bumpRemaining -= classSize;
+
+	return mem;
+}
+
+static void regionFree(Toy_private_memory_region* region, void* pointer, size_t oldSize, int chunkIndex) {
+	if (region->chunks[chunkIndex].dedicated) {
+		size_t size = region->chunks[chunkIndex].size;
+		regionRemoveChunk(region, chunkIndex);
+		region->backing(pointer, size, 0);
+		return;
+	}
+
+	int sizeClass = regionSizeClass(oldSize);
+	Toy_private_region_free_block* block = (Toy_private_region_free_block*)pointer;
+	block->next = region->freeLists[sizeClass];
+	region->freeLists[sizeClass] = block;
+}
+
+static void* regionAllocator(void* pointer, size_t oldSize, size_t newSize) {
+	Toy_private_memory_region* region = Toy_getContext()->region;
+
+	if (pointer == NULL) {
+		return newSize == 0 ? NULL : regionAllocate(region, newSize);
+	}
+
+	int chunkIndex = regionFindChunk(region, pointer);
+
+	//allocated before the region began
+	if (chunkIndex < 0) {
+		return region->backing(pointer, oldSize, newSize);
+	}
+
+	if (newSize == 0) {
+		regionFree(region, pointer, oldSize, chunkIndex);
+		return NULL;
+	}
+
+	//large allocations can be resized in place by the backing allocator
+	if (region->chunks[chunkIndex].dedicated && regionSizeClass(newSize) < 0) {
+		size_t size = region->chunks[chunkIndex].size;
+		unsigned char* mem = region->backing(pointer, size, newSize);
+
+		if (mem == NULL) {
+			return NULL;
+		}
+
+		regionRemoveChunk(region, chunkIndex);
+		regionInsertChunk(region, mem, newSize, true); //there's always room after the removal
+		return mem;
+	}
+
+	//still fits within the same size class
+	if (!region->chunks[chunkIndex].dedicated && regionSizeClass(newSize) == regionSizeClass(oldSize)) {
+		return pointer;
+	}
+
+	//move to a different size class
+	if (region->chunks[chunkIndex].dedicated) {
+		oldSize = region->chunks[chunkIndex].size;
+	}
+
+	void* mem = regionAllocate(region, newSize);
+
+	if (mem == NULL) {
+		return NULL;
+	}
+
+	memcpy(mem, pointer, oldSize < newSize ? oldSize : newSize);
+	regionFree(region, pointer, oldSize, regionFindChunk(region, pointer)); //the chunks may have shifted
+	return mem;
 }
 
 void Toy_setMemoryAllocator(Toy_MemoryAllocatorFn fn) {
@@ -48,7 +266,58 @@ void Toy_setMemoryAllocator(Toy_MemoryAllocatorFn fn) {
 		exit(-1);
 	}
 
-	allocator = fn;
+	Toy_getContext()->allocator = fn;
 	Toy_setRefStringAllocatorFn(fn);
 	Toy_setRefFunctionAllocatorFn(fn);
 }
+
+bool Toy_beginMemoryRegion() {
+	Toy_Context* context = Toy_getContext();
+
+	if (context->region != NULL) {
+		fprintf(stderr, TOY_CC_ERROR "[internal] Memory region error (a region is already active)\n" TOY_CC_RESET);
+		return false;
+	}
+
+	Toy_private_memory_region* region = context->allocator(NULL, 0, sizeof(Toy_private_memory_region));
+
+	if (region == NULL) {
+		return false;
+	}
+
+	region->backing = context->allocator;
+	region->chunks = NULL;
+	region->chunkCapacity = 0;
+	region->chunkCount = 0;
+	region->bump = NULL;
+	region->bumpRemaining = 0;
+
+	for (int i = 0; i < TOY_REGION_CLASS_COUNT; i++) {
+		region->freeLists[i] = NULL;
+	}
+
+	context->region = region;
+	Toy_setMemoryAllocator(regionAllocator);
+
+	return true;
+}
+
+void Toy_endMemoryRegion() {
+	Toy_Context* context = Toy_getContext();
+	Toy_private_memory_region* region = context->region;
+
+	if (region == NULL) {
+		return;
+	}
+
+	//restore the previous allocator before releasing anything
+	Toy_setMemoryAllocator(region->backing);
+	context->region = NULL;
+
+	for (int i = 0; i < region->chunkCount; i++) {
+		region->backing(region->chunks[i].start, region->chunks[i].size, 0);
+	}
+
+	region->backing(region->chunks, sizeof(Toy_private_region_chunk) * region->chunkCapacity, 0);
+	region->backing(region, sizeof(Toy_private_memory_region), 0);
+}
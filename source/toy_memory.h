@@ -105,8 +105,26 @@ TOY_API void* Toy_reallocate(void* pointer, size_t oldSize, size_t newSize);
 /*!
 ### void Toy_setMemoryAllocator(Toy_MemoryAllocatorFn)
 
-This function sets the memory allocator, replacing the default memory allocator.
+This function sets the memory allocator of the current context, replacing the default memory allocator. See [toy_context.h](toy_context_h.md).
 
 This function also overwrites any given refstring and reffunction memory allocators, see [toy_refstring.h](toy_refstring_h.md).
 !*/
 TOY_API void Toy_setMemoryAllocator(Toy_MemoryAllocatorFn);
+
+/*!
+### bool Toy_beginMemoryRegion()
+
+This function begins a memory region, by replacing the current memory allocator with a region allocator. Within a region, small allocations are carved out of large chunks and recycled through free lists sorted by size, while larger allocations are tracked individually. All of the memory is obtained from the allocator that was active when the region began.
+
+Everything allocated within a region must be finished with before the region ends - this is intended for hosts which run a script from start to finish, such as a server handling a request. Memory allocated before the region began can still be freed within it. Each context can have one region active at a time, and `Toy_setMemoryAllocator()` should not be called while it is.
+
+This function returns false if a region is already active within the current context.
+!*/
+TOY_API bool Toy_beginMemoryRegion();
+
+/*!
+### void Toy_endMemoryRegion()
+
+This function ends the memory region of the current context, releasing all of the memory allocated within it in one shot, and then restores the previous memory allocator.
+!*/
+TOY_API void Toy_endMemoryRegion();
@@ -84,6 +84,40 @@ typedef enum Toy_Opcode {
 
 	//meta
 	TOY_OP_FN_END, //different from SECTION_END
+
+	//local variables, resolved to numbered slots by the compiler
+	TOY_OP_SCOPE_SLOTS,		//give the current scope its slots (as long literals of the identifiers, and of each identifier's slot)
+	TOY_OP_SLOT_DECL,		//declare the variable in a slot (slot, long type literal)
+	TOY_OP_SLOT_LOAD,		//push the value of a slot (depth, slot)
+	TOY_OP_SLOT_STORE,		//assign to a slot (depth, slot)
+
+	//superinstructions - never emitted by the compiler, Toy_optimizeCompiler() fuses common sequences into these
+	TOY_OP_IF_TRUE_JUMP,	//INVERT, IF_FALSE_JUMP
+	TOY_OP_SLOT_INCREMENT,	//SLOT_LOAD, LITERAL 1, ADDITION, SLOT_STORE (depth, slot)
+	TOY_OP_SLOT_DECREMENT,	//SLOT_LOAD, LITERAL 1, SUBTRACTION, SLOT_STORE (depth, slot)
+
+	//quickened forms - never emitted by the compiler, the interpreter rewrites the generic opcodes into these once it has seen the operand types
+	TOY_OP_ADDITION_INTEGER,
+	TOY_OP_SUBTRACTION_INTEGER,
+	TOY_OP_MULTIPLICATION_INTEGER,
+	TOY_OP_DIVISION_INTEGER,
+	TOY_OP_MODULO_INTEGER,
+
+	TOY_OP_ADDITION_FLOAT,
+	TOY_OP_SUBTRACTION_FLOAT,
+	TOY_OP_MULTIPLICATION_FLOAT,
+	TOY_OP_DIVISION_FLOAT,
+
+	TOY_OP_COMPARE_LESS_INTEGER,
+	TOY_OP_COMPARE_LESS_EQUAL_INTEGER,
+	TOY_OP_COMPARE_GREATER_INTEGER,
+	TOY_OP_COMPARE_GREATER_EQUAL_INTEGER,
+
+	TOY_OP_COMPARE_LESS_FLOAT,
+	TOY_OP_COMPARE_LESS_EQUAL_FLOAT,
+	TOY_OP_COMPARE_GREATER_FLOAT,
+	TOY_OP_COMPARE_GREATER_EQUAL_FLOAT,
+
 	TOY_OP_SECTION_END = 255,
 	//TODO: add more
 
@@ -92,3 +126,6 @@ typedef enum Toy_Opcode {
 	TOY_OP_POSTFIX,
 } Toy_Opcode;
 
+//literal indexes, counts, sizes and jump targets are written as 16 bits - any that don't fit are written as this marker, followed by all 32 bits
+#define TOY_OPERAND_WIDE 0xFFFF
+
@@ -7,6 +7,7 @@
 #include "toy_console_colors.h"
 
 #include <stdio.h>
+#include <string.h>
 
 //utility functions
 static void error(Toy_Parser* parser, Toy_Token token, const char* message) {
@@ -132,7 +133,7 @@ static Toy_Opcode asType(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodeLiteral(nodeHandle, literal);
+	Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 
 	Toy_freeLiteral(literal);
 
@@ -142,7 +143,7 @@ static Toy_Opcode asType(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 static Toy_Opcode typeOf(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	Toy_ASTNode* rhs = NULL;
 	parsePrecedence(parser, &rhs, PREC_CALL);
-	Toy_emitASTNodeUnary(nodeHandle, TOY_OP_TYPE_OF, rhs);
+	Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_TYPE_OF, rhs);
 	return TOY_OP_EOF;
 }
 
@@ -160,7 +161,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		if (iterations == 0 && match(parser, TOY_TOKEN_COLON)) {
 			consume(parser, TOY_TOKEN_BRACKET_RIGHT, "Expected ']' at the end of empty dictionary definition");
 			//emit an empty dictionary and finish
-			Toy_emitASTNodeCompound(&dictionary, TOY_LITERAL_DICTIONARY);
+			Toy_emitASTNodeCompound(&parser->arena, &dictionary, TOY_LITERAL_DICTIONARY);
 			break;
 		}
 
@@ -202,7 +203,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 			//init the dictionary
 			if (!dictionary) {
-				Toy_emitASTNodeCompound(&dictionary, TOY_LITERAL_DICTIONARY);
+				Toy_emitASTNodeCompound(&parser->arena, &dictionary, TOY_LITERAL_DICTIONARY);
 			}
 
 			//grow the node if needed
@@ -210,7 +211,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = dictionary->compound.capacity;
 
 				dictionary->compound.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				dictionary->compound.nodes = TOY_GROW_ARRAY(Toy_ASTNode, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
+				dictionary->compound.nodes = Toy_private_growASTNodes(&parser->arena, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
 			}
 
 			//store the left and right in the node
@@ -227,7 +228,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 			//init the array
 			if (!array) {
-				Toy_emitASTNodeCompound(&array, TOY_LITERAL_ARRAY);
+				Toy_emitASTNodeCompound(&parser->arena, &array, TOY_LITERAL_ARRAY);
 			}
 
 			//grow the node if needed
@@ -235,12 +236,12 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = array->compound.capacity;
 
 				array->compound.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				array->compound.nodes = TOY_GROW_ARRAY(Toy_ASTNode, array->compound.nodes, oldCapacity, array->compound.capacity);
+				array->compound.nodes = Toy_private_growASTNodes(&parser->arena, array->compound.nodes, oldCapacity, array->compound.capacity);
 			}
 
 			//copy into the array, and manually free the temp node
 			array->compound.nodes[array->compound.count++] = *left;
-			TOY_FREE(Toy_ASTNode, left);
+			Toy_private_freeASTNodes(left, 1);
 		}
 	}
 
@@ -253,7 +254,7 @@ static Toy_Opcode compound(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		//both are null, must be an array (because reasons)
-		Toy_emitASTNodeCompound(&array, TOY_LITERAL_ARRAY);
+		Toy_emitASTNodeCompound(&parser->arena, &array, TOY_LITERAL_ARRAY);
 		(*nodeHandle) = array;
 	}
 
@@ -298,17 +299,9 @@ static Toy_Opcode string(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				}
 			}
 
-			//for length safety
-			if (strLength > TOY_MAX_STRING_LENGTH) {
-				strLength = TOY_MAX_STRING_LENGTH;
-				char msg[256];
-				snprintf(msg, 256, TOY_CC_ERROR "Strings can only be a maximum of %d characters long" TOY_CC_RESET, TOY_MAX_STRING_LENGTH);
-				error(parser, parser->previous, msg);
-			}
-
-			Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, strLength));
+			Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_internRefStringLength(buffer, strLength));
 			TOY_FREE_ARRAY(char, buffer, parser->previous.length);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 			return TOY_OP_EOF;
 		}
@@ -329,7 +322,7 @@ static Toy_Opcode grouping(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' at end of grouping");
 
 			//process the result without optimisations
-			Toy_emitASTNodeGrouping(nodeHandle);
+			Toy_emitASTNodeGrouping(&parser->arena, nodeHandle);
 			return TOY_OP_EOF;
 		}
 
@@ -493,7 +486,7 @@ static Toy_Opcode unary(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		}
 
 		//actually emit the negation node
-		Toy_emitASTNodeUnary(nodeHandle, TOY_OP_NEGATE, tmpNode);
+		Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_NEGATE, tmpNode);
 	}
 
 	else if (parser->previous.type == TOY_TOKEN_NOT) {
@@ -514,7 +507,7 @@ static Toy_Opcode unary(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		}
 
 		//actually emit the negation
-		Toy_emitASTNodeUnary(nodeHandle, TOY_OP_INVERT, tmpNode);
+		Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_INVERT, tmpNode);
 	}
 
 	else {
@@ -544,15 +537,15 @@ static char* removeChar(const char* lexeme, int length, char c) {
 static Toy_Opcode atomic(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	switch(parser->previous.type) {
 		case TOY_TOKEN_NULL:
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_NULL_LITERAL);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_NULL_LITERAL);
 			return TOY_OP_EOF;
 
 		case TOY_TOKEN_LITERAL_TRUE:
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_BOOLEAN_LITERAL(true));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_BOOLEAN_LITERAL(true));
 			return TOY_OP_EOF;
 
 		case TOY_TOKEN_LITERAL_FALSE:
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_BOOLEAN_LITERAL(false));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_BOOLEAN_LITERAL(false));
 			return TOY_OP_EOF;
 
 		case TOY_TOKEN_LITERAL_INTEGER: {
@@ -560,7 +553,7 @@ static Toy_Opcode atomic(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			const char* lexeme = removeChar(parser->previous.lexeme, parser->previous.length, '_');
 			sscanf(lexeme, "%d", &value);
 			TOY_FREE_ARRAY(char, lexeme, parser->previous.length + 1);
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_INTEGER_LITERAL(value));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_INTEGER_LITERAL(value));
 			return TOY_OP_EOF;
 		}
 
@@ -569,16 +562,16 @@ static Toy_Opcode atomic(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			const char* lexeme = removeChar(parser->previous.lexeme, parser->previous.length, '_');
 			sscanf(lexeme, "%f", &value);
 			TOY_FREE_ARRAY(char, lexeme, parser->previous.length + 1);
-			Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_FLOAT_LITERAL(value));
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_FLOAT_LITERAL(value));
 			return TOY_OP_EOF;
 		}
 
 		case TOY_TOKEN_TYPE: {
 			if (match(parser, TOY_TOKEN_CONST)) {
-				Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, true));
+				Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, true));
 			}
 			else {
-				Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, false));
+				Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_TYPE_LITERAL(TOY_LITERAL_TYPE, false));
 			}
 
 			return TOY_OP_EOF;
@@ -607,8 +600,8 @@ static Toy_Opcode identifier(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		error(parser, parser->previous, "Identifiers can only be a maximum of 256 characters long");
 	}
 
-	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(identifierToken.lexeme, length));
-	Toy_emitASTNodeLiteral(nodeHandle, identifier);
+	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(identifierToken.lexeme, length));
+	Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, identifier);
 	Toy_freeLiteral(identifier);
 
 	return TOY_OP_EOF;
@@ -618,28 +611,28 @@ static Toy_Opcode castingPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	switch(parser->previous.type) {
 		case TOY_TOKEN_BOOLEAN: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_BOOLEAN, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
 
 		case TOY_TOKEN_INTEGER: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
 
 		case TOY_TOKEN_FLOAT: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_FLOAT, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
 
 		case TOY_TOKEN_STRING: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_STRING, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
@@ -647,7 +640,7 @@ static Toy_Opcode castingPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		//BUGFIX: handle this here, and not in castingPrefix, so "any" can be recognized as a type properly
 		case TOY_TOKEN_ANY: {
 			Toy_Literal literal = TOY_TO_TYPE_LITERAL(TOY_LITERAL_ANY, false);
-			Toy_emitASTNodeLiteral(nodeHandle, literal);
+			Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, literal);
 			Toy_freeLiteral(literal);
 		}
 		break;
@@ -705,7 +698,7 @@ static Toy_Opcode incrementPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle)
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePrefixIncrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePrefixIncrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -722,7 +715,7 @@ static Toy_Opcode incrementInfix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePostfixIncrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePostfixIncrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -739,7 +732,7 @@ static Toy_Opcode decrementPrefix(Toy_Parser* parser, Toy_ASTNode** nodeHandle)
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePrefixDecrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePrefixDecrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -756,7 +749,7 @@ static Toy_Opcode decrementInfix(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodePostfixDecrement(nodeHandle, tmpNode->atomic.literal);
+	Toy_emitASTNodePostfixDecrement(&parser->arena, nodeHandle, tmpNode->atomic.literal);
 
 	Toy_freeASTNode(tmpNode);
 
@@ -779,7 +772,7 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		//arithmetic
 		case TOY_TOKEN_PAREN_LEFT: {
 			Toy_ASTNode* arguments = NULL;
-			Toy_emitASTNodeFnCollection(&arguments);
+			Toy_emitASTNodeFnCollection(&parser->arena, &arguments);
 
 			//if there's arguments
 			if (!match(parser, TOY_TOKEN_PAREN_RIGHT)) {
@@ -790,7 +783,7 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 						int oldCapacity = arguments->fnCollection.capacity;
 
 						arguments->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-						arguments->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, arguments->fnCollection.nodes, oldCapacity, arguments->fnCollection.capacity);
+						arguments->fnCollection.nodes = Toy_private_growASTNodes(&parser->arena, arguments->fnCollection.nodes, oldCapacity, arguments->fnCollection.capacity);
 					}
 
 					Toy_ASTNode* tmpNode = NULL;
@@ -803,14 +796,14 @@ static Toy_Opcode fnCall(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 					}
 
 					arguments->fnCollection.nodes[arguments->fnCollection.count++] = *tmpNode;
-					TOY_FREE(Toy_ASTNode, tmpNode); //simply free the tmpNode, so you don't free the children
+					Toy_private_freeASTNodes(tmpNode, 1); //simply free the tmpNode, so you don't free the children
 				} while(match(parser, TOY_TOKEN_COMMA));
 
 				consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' at end of argument list");
 			}
 
 			//emit the call
-			Toy_emitASTNodeFnCall(nodeHandle, arguments);
+			Toy_emitASTNodeFnCall(&parser->arena, nodeHandle, arguments);
 
 			return TOY_OP_FN_CALL;
 		}
@@ -834,9 +827,9 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 	Toy_ASTNode* third = NULL;
 
 	//booleans indicate blank slice indexing
-	Toy_emitASTNodeLiteral(&first, TOY_TO_INDEX_BLANK_LITERAL);
-	Toy_emitASTNodeLiteral(&second, TOY_TO_INDEX_BLANK_LITERAL);
-	Toy_emitASTNodeLiteral(&third, TOY_TO_INDEX_BLANK_LITERAL);
+	Toy_emitASTNodeLiteral(&parser->arena, &first, TOY_TO_INDEX_BLANK_LITERAL);
+	Toy_emitASTNodeLiteral(&parser->arena, &second, TOY_TO_INDEX_BLANK_LITERAL);
+	Toy_emitASTNodeLiteral(&parser->arena, &third, TOY_TO_INDEX_BLANK_LITERAL);
 
 	bool readFirst = false; //pattern matching is bullcrap
 
@@ -865,7 +858,7 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 		Toy_freeASTNode(third);
 		third = NULL;
 
-		Toy_emitASTNodeIndex(nodeHandle, first, second, third);
+		Toy_emitASTNodeIndex(&parser->arena, nodeHandle, first, second, third);
 		return TOY_OP_INDEX;
 	}
 
@@ -887,7 +880,7 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 	if (match(parser, TOY_TOKEN_BRACKET_RIGHT)) {
 		Toy_freeASTNode(third);
 		third = NULL;
-		Toy_emitASTNodeIndex(nodeHandle, first, second, third);
+		Toy_emitASTNodeIndex(&parser->arena, nodeHandle, first, second, third);
 		return TOY_OP_INDEX;
 	}
 
@@ -903,7 +896,7 @@ static Toy_Opcode indexAccess(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //
 		return TOY_OP_EOF;
 	}
 
-	Toy_emitASTNodeIndex(nodeHandle, first, second, third);
+	Toy_emitASTNodeIndex(&parser->arena, nodeHandle, first, second, third);
 
 	consume(parser, TOY_TOKEN_BRACKET_RIGHT, "Expected ']' in index notation");
 
@@ -920,7 +913,7 @@ static Toy_Opcode question(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	consume(parser, TOY_TOKEN_COLON, "Expected ':' in ternary expression");
 	parsePrecedence(parser, &elsePath, PREC_TERNARY);
 
-	Toy_emitASTNodeTernary(nodeHandle, NULL, thenPath, elsePath);
+	Toy_emitASTNodeTernary(&parser->arena, nodeHandle, NULL, thenPath, elsePath);
 
 	return TOY_OP_TERNARY;
 }
@@ -1077,17 +1070,8 @@ static bool calcStaticBinaryArithmetic(Toy_Parser* parser, Toy_ASTNode** nodeHan
 
 	//special case for string concatenation ONLY
 	if (TOY_IS_STRING(lhs) && TOY_IS_STRING(rhs) && (*nodeHandle)->binary.opcode == TOY_OP_ADDITION) {
-		//check for overflow
-		int totalLength = TOY_AS_STRING(lhs)->length + TOY_AS_STRING(rhs)->length;
-		if (totalLength > TOY_MAX_STRING_LENGTH) {
-			error(parser, parser->previous, "Can't concatenate these strings, result is too long (error found in constant folding)\n");
-			return false;
-		}
-
 		//concat the strings
-		char buffer[TOY_MAX_STRING_LENGTH];
-		snprintf(buffer, TOY_MAX_STRING_LENGTH, "%s%s", Toy_toCString(TOY_AS_STRING(lhs)), Toy_toCString(TOY_AS_STRING(rhs)));
-		result = TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, totalLength));
+		result = TOY_TO_STRING_LITERAL(Toy_concatRefString(TOY_AS_STRING(lhs), TOY_AS_STRING(rhs)));
 	}
 
 	//type coersion
@@ -1298,16 +1282,16 @@ static void parsePrecedence(Toy_Parser* parser, Toy_ASTNode** nodeHandle, Preced
 		}
 
 		if (opcode == TOY_OP_AND) {
-			Toy_emitASTNodeAnd(nodeHandle, rhsNode);
+			Toy_emitASTNodeAnd(&parser->arena, nodeHandle, rhsNode);
 			continue;
 		}
 
 		if (opcode == TOY_OP_OR) {
-			Toy_emitASTNodeOr(nodeHandle, rhsNode);
+			Toy_emitASTNodeOr(&parser->arena, nodeHandle, rhsNode);
 			continue;
 		}
 
-		Toy_emitASTNodeBinary(nodeHandle, rhsNode, opcode);
+		Toy_emitASTNodeBinary(&parser->arena, nodeHandle, rhsNode, opcode);
 
 		//optimise away the constants
 		if (!parser->panic && !calcStaticBinaryArithmetic(parser, nodeHandle)) {
@@ -1330,7 +1314,7 @@ static void expression(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 //statements
 static void blockStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//init
-	Toy_emitASTNodeBlock(nodeHandle);
+	Toy_emitASTNodeBlock(&parser->arena, nodeHandle);
 
 	//sub-scope, compile it and push it up in a node
 	while (!match(parser, TOY_TOKEN_BRACE_RIGHT)) {
@@ -1338,7 +1322,7 @@ static void blockStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			int oldCapacity = (*nodeHandle)->block.capacity;
 
 			(*nodeHandle)->block.capacity = TOY_GROW_CAPACITY(oldCapacity);
-			(*nodeHandle)->block.nodes = TOY_GROW_ARRAY(Toy_ASTNode, (*nodeHandle)->block.nodes, oldCapacity, (*nodeHandle)->block.capacity);
+			(*nodeHandle)->block.nodes = Toy_private_growASTNodes(&parser->arena, (*nodeHandle)->block.nodes, oldCapacity, (*nodeHandle)->block.capacity);
 		}
 
 		Toy_ASTNode* tmpNode = NULL;
@@ -1353,7 +1337,7 @@ static void blockStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 		//BUGFIX: statements no longer require the existing node
 		((*nodeHandle)->block.nodes[(*nodeHandle)->block.count++]) = *tmpNode;
-		TOY_FREE(Toy_ASTNode, tmpNode); //simply free the tmpNode, so you don't free the children
+		Toy_private_freeASTNodes(tmpNode, 1); //simply free the tmpNode, so you don't free the children
 	}
 }
 
@@ -1361,14 +1345,14 @@ static void printStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//set the node info
 	Toy_ASTNode* node = NULL;
 	expression(parser, &node);
-	Toy_emitASTNodeUnary(nodeHandle, TOY_OP_PRINT, node);
+	Toy_emitASTNodeUnary(&parser->arena, nodeHandle, TOY_OP_PRINT, node);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of print statement");
 }
 
 static void assertStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//set the node info
-	(*nodeHandle) = TOY_ALLOCATE(Toy_ASTNode, 1); //special case, because I'm lazy
+	(*nodeHandle) = Toy_private_allocateASTNodes(&parser->arena, 1); //special case, because I'm lazy
 	(*nodeHandle)->type = TOY_AST_NODE_BINARY;
 	(*nodeHandle)->binary.opcode = TOY_OP_ASSERT;
 
@@ -1397,7 +1381,7 @@ static void ifStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		declaration(parser, &elsePath);
 	}
 
-	Toy_emitASTNodeIf(nodeHandle, condition, thenPath, elsePath);
+	Toy_emitASTNodeIf(&parser->arena, nodeHandle, condition, thenPath, elsePath);
 }
 
 static void whileStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
@@ -1412,7 +1396,7 @@ static void whileStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' at end of while clause");
 	declaration(parser, &thenPath);
 
-	Toy_emitASTNodeWhile(nodeHandle, condition, thenPath);
+	Toy_emitASTNodeWhile(&parser->arena, nodeHandle, condition, thenPath);
 }
 
 static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
@@ -1436,7 +1420,7 @@ static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' after empty declaration of for clause");
-		Toy_emitASTNodePass(&preClause);
+		Toy_emitASTNodePass(&parser->arena, &preClause);
 	}
 
 	//check the condition clause
@@ -1448,7 +1432,7 @@ static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' after empty condition of for clause");
 		//empty clause defaults to forever
 		Toy_Literal f = TOY_TO_BOOLEAN_LITERAL(true);
-		Toy_emitASTNodeLiteral(&condition, f);
+		Toy_emitASTNodeLiteral(&parser->arena, &condition, f);
 	}
 
 	//check the postfix clause
@@ -1458,30 +1442,30 @@ static void forStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		consume(parser, TOY_TOKEN_PAREN_RIGHT, "Expected ')' after empty increment of for clause");
-		Toy_emitASTNodePass(&postClause);
+		Toy_emitASTNodePass(&parser->arena, &postClause);
 	}
 
 	//read the path
 	declaration(parser, &thenPath);
 
-	Toy_emitASTNodeFor(nodeHandle, preClause, condition, postClause, thenPath);
+	Toy_emitASTNodeFor(&parser->arena, nodeHandle, preClause, condition, postClause, thenPath);
 }
 
 static void breakStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
-	Toy_emitASTNodeBreak(nodeHandle);
+	Toy_emitASTNodeBreak(&parser->arena, nodeHandle);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of break statement");
 }
 
 static void continueStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
-	Toy_emitASTNodeContinue(nodeHandle);
+	Toy_emitASTNodeContinue(&parser->arena, nodeHandle);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of continue statement");
 }
 
 static void returnStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	Toy_ASTNode* returnValues = NULL;
-	Toy_emitASTNodeFnCollection(&returnValues);
+	Toy_emitASTNodeFnCollection(&parser->arena, &returnValues);
 
 	if (!match(parser, TOY_TOKEN_SEMICOLON)) {
 		do { //loop for multiple returns (disabled later in the pipeline)
@@ -1490,7 +1474,7 @@ static void returnStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = returnValues->fnCollection.capacity;
 
 				returnValues->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				returnValues->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, returnValues->fnCollection.nodes, oldCapacity, returnValues->fnCollection.capacity);
+				returnValues->fnCollection.nodes = Toy_private_growASTNodes(&parser->arena, returnValues->fnCollection.nodes, oldCapacity, returnValues->fnCollection.capacity);
 			}
 
 			Toy_ASTNode* node = NULL;
@@ -1503,13 +1487,13 @@ static void returnStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 			}
 
 			returnValues->fnCollection.nodes[returnValues->fnCollection.count++] = *node;
-			TOY_FREE(Toy_ASTNode, node); //free manually
+			Toy_private_freeASTNodes(node, 1); //free manually
 		} while(match(parser, TOY_TOKEN_COMMA));
 
 		consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of return statement");
 	}
 
-	Toy_emitASTNodeFnReturn(nodeHandle, returnValues);
+	Toy_emitASTNodeFnReturn(&parser->arena, nodeHandle, returnValues);
 }
 
 static void importStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
@@ -1535,7 +1519,7 @@ static void importStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		Toy_freeASTNode(node);
 	}
 
-	Toy_emitASTNodeImport(nodeHandle, idn, alias);
+	Toy_emitASTNodeImport(&parser->arena, nodeHandle, idn, alias);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of import statement");
 
@@ -1547,7 +1531,7 @@ static void importStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 static void expressionStmt(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	//BUGFIX: check for empty statements
 	if (match(parser, TOY_TOKEN_SEMICOLON)) {
-		Toy_emitASTNodeLiteral(nodeHandle, TOY_TO_NULL_LITERAL);
+		Toy_emitASTNodeLiteral(&parser->arena, nodeHandle, TOY_TO_NULL_LITERAL);
 		return;
 	}
 
@@ -1697,7 +1681,7 @@ static Toy_Literal readTypeToLiteral(Toy_Parser* parser) {
 				length = 256;
 				error(parser, parser->previous, "Identifiers can only be a maximum of 256 characters long");
 			}
-			literal = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(identifierToken.lexeme, length));
+			literal = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(identifierToken.lexeme, length));
 		}
 		break;
 
@@ -1732,7 +1716,7 @@ static void varDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		error(parser, parser->previous, "Identifiers can only be a maximum of 256 characters long");
 	}
 
-	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(identifierToken.lexeme, length));
+	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(identifierToken.lexeme, length));
 
 	//read the type, if present
 	Toy_Literal typeLiteral;
@@ -1751,13 +1735,13 @@ static void varDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	}
 	else {
 		//values are null by default
-		Toy_emitASTNodeLiteral(&expressionNode, TOY_TO_NULL_LITERAL);
+		Toy_emitASTNodeLiteral(&parser->arena, &expressionNode, TOY_TO_NULL_LITERAL);
 	}
 
 	//TODO: static type checking?
 
 	//declare it
-	Toy_emitASTNodeVarDecl(nodeHandle, identifier, typeLiteral, expressionNode);
+	Toy_emitASTNodeVarDecl(&parser->arena, nodeHandle, identifier, typeLiteral, expressionNode);
 
 	consume(parser, TOY_TOKEN_SEMICOLON, "Expected ';' at end of var declaration");
 }
@@ -1775,14 +1759,14 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 		error(parser, parser->previous, "Identifiers can only be a maximum of 256 characters long");
 	}
 
-	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(identifierToken.lexeme, length));
+	Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(identifierToken.lexeme, length));
 
 	//read the parameters and arity
 	consume(parser, TOY_TOKEN_PAREN_LEFT, "Expected '(' after function identifier");
 
 	//for holding the array of arguments
 	Toy_ASTNode* argumentNode = NULL;
-	Toy_emitASTNodeFnCollection(&argumentNode);
+	Toy_emitASTNodeFnCollection(&parser->arena, &argumentNode);
 
 	//read args
 	if (!match(parser, TOY_TOKEN_PAREN_RIGHT)) {
@@ -1801,7 +1785,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 					error(parser, parser->previous, "Identifiers can only be a maximum of 256 characters long");
 				}
 
-				Toy_Literal argIdentifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(argIdentifierToken.lexeme, length));
+				Toy_Literal argIdentifier = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(argIdentifierToken.lexeme, length));
 
 				//set the type (array of any types)
 				Toy_Literal argTypeLiteral = TOY_TO_TYPE_LITERAL(TOY_LITERAL_FUNCTION_ARG_REST, false);
@@ -1811,15 +1795,15 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 					int oldCapacity = argumentNode->fnCollection.capacity;
 
 					argumentNode->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-					argumentNode->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
+					argumentNode->fnCollection.nodes = Toy_private_growASTNodes(&parser->arena, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
 				}
 
 				//store the arg in the array
 				Toy_ASTNode* literalNode = NULL;
-				Toy_emitASTNodeVarDecl(&literalNode, argIdentifier, argTypeLiteral, NULL);
+				Toy_emitASTNodeVarDecl(&parser->arena, &literalNode, argIdentifier, argTypeLiteral, NULL);
 
 				argumentNode->fnCollection.nodes[argumentNode->fnCollection.count++] = *literalNode;
-				TOY_FREE(Toy_ASTNode, literalNode);
+				Toy_private_freeASTNodes(literalNode, 1);
 
 				break;
 			}
@@ -1836,7 +1820,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				error(parser, parser->previous, "Identifiers can only be a maximum of 256 characters long");
 			}
 
-			Toy_Literal argIdentifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefStringLength(argIdentifierToken.lexeme, length));
+			Toy_Literal argIdentifier = TOY_TO_IDENTIFIER_LITERAL(Toy_internRefStringLength(argIdentifierToken.lexeme, length));
 
 			//read optional type of the identifier
 			Toy_Literal argTypeLiteral;
@@ -1853,15 +1837,15 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = argumentNode->fnCollection.capacity;
 
 				argumentNode->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				argumentNode->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
+				argumentNode->fnCollection.nodes = Toy_private_growASTNodes(&parser->arena, argumentNode->fnCollection.nodes, oldCapacity, argumentNode->fnCollection.capacity);
 			}
 
 			//store the arg in the array
 			Toy_ASTNode* literalNode = NULL;
-			Toy_emitASTNodeVarDecl(&literalNode, argIdentifier, argTypeLiteral, NULL);
+			Toy_emitASTNodeVarDecl(&parser->arena, &literalNode, argIdentifier, argTypeLiteral, NULL);
 
 			argumentNode->fnCollection.nodes[argumentNode->fnCollection.count++] = *literalNode;
-			TOY_FREE(Toy_ASTNode, literalNode);
+			Toy_private_freeASTNodes(literalNode, 1);
 
 		} while (match(parser, TOY_TOKEN_COMMA)); //if comma is read, continue
 
@@ -1870,7 +1854,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 
 	//read the return types, if present
 	Toy_ASTNode* returnNode = NULL;
-	Toy_emitASTNodeFnCollection(&returnNode);
+	Toy_emitASTNodeFnCollection(&parser->arena, &returnNode);
 
 	if (match(parser, TOY_TOKEN_COLON)) {
 		do {
@@ -1879,14 +1863,14 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 				int oldCapacity = returnNode->fnCollection.capacity;
 
 				returnNode->fnCollection.capacity = TOY_GROW_CAPACITY(oldCapacity);
-				returnNode->fnCollection.nodes = TOY_GROW_ARRAY(Toy_ASTNode, returnNode->fnCollection.nodes, oldCapacity, returnNode->fnCollection.capacity);
+				returnNode->fnCollection.nodes = Toy_private_growASTNodes(&parser->arena, returnNode->fnCollection.nodes, oldCapacity, returnNode->fnCollection.capacity);
 			}
 
 			Toy_ASTNode* literalNode = NULL;
-			Toy_emitASTNodeLiteral(&literalNode, readTypeToLiteral(parser));
+			Toy_emitASTNodeLiteral(&parser->arena, &literalNode, readTypeToLiteral(parser));
 
 			returnNode->fnCollection.nodes[returnNode->fnCollection.count++] = *literalNode;
-			TOY_FREE(Toy_ASTNode, literalNode);
+			Toy_private_freeASTNodes(literalNode, 1);
 		} while(match(parser, TOY_TOKEN_COMMA));
 	}
 
@@ -1897,7 +1881,7 @@ static void fnDecl(Toy_Parser* parser, Toy_ASTNode** nodeHandle) {
 	blockStmt(parser, &blockNode);
 
 	//declare it
-	Toy_emitASTNodeFnDecl(nodeHandle, identifier, argumentNode, returnNode, blockNode);
+	Toy_emitASTNodeFnDecl(&parser->arena, nodeHandle, identifier, argumentNode, returnNode, blockNode);
 }
 
 static void declaration(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //assume nodeHandle holds a blank node
@@ -1913,6 +1897,487 @@ static void declaration(Toy_Parser* parser, Toy_ASTNode** nodeHandle) { //assume
 	}
 }
 
+//optimisation: constant propagation and dead branch elimination, over each complete statement
+static void pushParserConstant(Toy_Parser* parser, Toy_Literal identifier, Toy_Literal value) {
+	if (parser->constantCount + 1 > parser->constantCapacity) {
+		int oldCapacity = parser->constantCapacity;
+
+		parser->constantCapacity = TOY_GROW_CAPACITY(oldCapacity);
+		parser->constants = TOY_GROW_ARRAY(Toy_private_parser_constant, parser->constants, oldCapacity, parser->constantCapacity);
+	}
+
+	Toy_private_parser_constant* constant = &parser->constants[parser->constantCount++];
+
+	constant->identifier = Toy_copyLiteral(identifier);
+	constant->value = Toy_copyLiteral(value);
+	constant->depth = parser->constantDepth;
+}
+
+static bool findParserConstant(Toy_Parser* parser, Toy_Literal identifier, Toy_Literal* value) {
+	for (int i = parser->constantCount - 1; i >= 0; i--) {
+		//imports can declare anything, so nothing past this can be propagated
+		if (TOY_IS_NULL(parser->constants[i].identifier)) {
+			return false;
+		}
+
+		if (Toy_literalsAreEqual(parser->constants[i].identifier, identifier)) {
+			*value = parser->constants[i].value;
+			return !TOY_IS_NULL(*value);
+		}
+	}
+
+	return false;
+}
+
+//non-constant declarations only need to be tracked when they hide a constant
+static void declareParserVariable(Toy_Parser* parser, Toy_Literal identifier, Toy_Literal value) {
+	Toy_Literal hidden = TOY_TO_NULL_LITERAL;
+
+	if (TOY_IS_NULL(value) && !findParserConstant(parser, identifier, &hidden)) {
+		return;
+	}
+
+	pushParserConstant(parser, identifier, value);
+}
+
+static void beginParserScope(Toy_Parser* parser) {
+	parser->constantDepth++;
+}
+
+static void endParserScope(Toy_Parser* parser) {
+	while (parser->constantCount > 0 && parser->constants[parser->constantCount - 1].depth >= parser->constantDepth) {
+		parser->constantCount--;
+		Toy_freeLiteral(parser->constants[parser->constantCount].identifier);
+		Toy_freeLiteral(parser->constants[parser->constantCount].value);
+	}
+
+	parser->constantDepth--;
+}
+
+//only these literals can be folded - null, identifiers, types, etc. are left to the interpreter
+static bool isConstantNode(Toy_ASTNode* node) {
+	if (node == NULL || node->type != TOY_AST_NODE_LITERAL) {
+		return false;
+	}
+
+	Toy_Literal literal = node->atomic.literal;
+	return TOY_IS_BOOLEAN(literal) || TOY_IS_INTEGER(literal) || TOY_IS_FLOAT(literal) || TOY_IS_STRING(literal);
+}
+
+//overwrite a node with one of its own children, which must be detached from it first
+static void replaceASTNode(Toy_Parser* parser, Toy_ASTNode* node, Toy_ASTNode* child) {
+	Toy_ASTNode* old = Toy_private_allocateASTNodes(&parser->arena, 1);
+	*old = *node;
+
+	*node = *child;
+	Toy_private_freeASTNodes(child, 1);
+
+	Toy_freeASTNode(old);
+}
+
+static void replaceASTNodeLiteral(Toy_Parser* parser, Toy_ASTNode* node, Toy_Literal literal) {
+	Toy_ASTNode* tmp = NULL;
+	Toy_emitASTNodeLiteral(&parser->arena, &tmp, literal);
+	replaceASTNode(parser, node, tmp);
+}
+
+//mirrors the interpreter's casting rules
+static Toy_Literal calcStaticCast(Toy_Literal type, Toy_Literal value) {
+	switch(TOY_AS_TYPE(type).typeOf) {
+		case TOY_LITERAL_BOOLEAN:
+			return TOY_TO_BOOLEAN_LITERAL(TOY_IS_TRUTHY(value));
+
+		case TOY_LITERAL_INTEGER:
+			if (TOY_IS_BOOLEAN(value)) {
+				return TOY_TO_INTEGER_LITERAL(TOY_AS_BOOLEAN(value) ? 1 : 0);
+			}
+
+			if (TOY_IS_FLOAT(value)) {
+				return TOY_TO_INTEGER_LITERAL(TOY_AS_FLOAT(value));
+			}
+
+			if (TOY_IS_STRING(value)) {
+				int val = 0;
+				sscanf(Toy_toCString(TOY_AS_STRING(value)), "%d", &val);
+				return TOY_TO_INTEGER_LITERAL(val);
+			}
+
+			return Toy_copyLiteral(value);
+
+		case TOY_LITERAL_FLOAT:
+			if (TOY_IS_BOOLEAN(value)) {
+				return TOY_TO_FLOAT_LITERAL(TOY_AS_BOOLEAN(value) ? 1 : 0);
+			}
+
+			if (TOY_IS_INTEGER(value)) {
+				return TOY_TO_FLOAT_LITERAL(TOY_AS_INTEGER(value));
+			}
+
+			if (TOY_IS_STRING(value)) {
+				float val = 0;
+				sscanf(Toy_toCString(TOY_AS_STRING(value)), "%f", &val);
+				return TOY_TO_FLOAT_LITERAL(val);
+			}
+
+			return Toy_copyLiteral(value);
+
+		case TOY_LITERAL_STRING: {
+			char buffer[128];
+
+			if (TOY_IS_BOOLEAN(value)) {
+				snprintf(buffer, 128, "%s", TOY_AS_BOOLEAN(value) ? "true" : "false");
+			}
+			else if (TOY_IS_INTEGER(value)) {
+				snprintf(buffer, 128, "%d", TOY_AS_INTEGER(value));
+			}
+			else if (TOY_IS_FLOAT(value)) {
+				snprintf(buffer, 128, "%g", TOY_AS_FLOAT(value));
+			}
+			else {
+				return Toy_copyLiteral(value);
+			}
+
+			return TOY_TO_STRING_LITERAL(Toy_createRefStringLength(buffer, strlen(buffer)));
+		}
+
+		default:
+			return TOY_TO_NULL_LITERAL;
+	}
+}
+
+static void optimizeNode(Toy_Parser* parser, Toy_ASTNode* node);
+
+//assignment targets, indexed values, callees and the operands of typeof are left as identifiers
+static void optimizeTarget(Toy_Parser* parser, Toy_ASTNode* node) {
+	if (node != NULL && node->type == TOY_AST_NODE_LITERAL && TOY_IS_IDENTIFIER(node->atomic.literal)) {
+		return;
+	}
+
+	optimizeNode(parser, node);
+}
+
+//the bodies of if, while and for statements might not run, so their declarations can't be relied on
+static void optimizeBranch(Toy_Parser* parser, Toy_ASTNode* node) {
+	if (node == NULL) {
+		return;
+	}
+
+	optimizeNode(parser, node);
+
+	if (node->type == TOY_AST_NODE_VAR_DECL) {
+		declareParserVariable(parser, node->varDecl.identifier, TOY_TO_NULL_LITERAL);
+	}
+}
+
+static void optimizeBinary(Toy_Parser* parser, Toy_ASTNode* node) {
+	Toy_Opcode opcode = node->binary.opcode;
+
+	if ((opcode >= TOY_OP_VAR_ASSIGN && opcode <= TOY_OP_VAR_MODULO_ASSIGN) || opcode == TOY_OP_INDEX || opcode == TOY_OP_FN_CALL || opcode == TOY_OP_DOT || opcode == TOY_OP_TYPE_CAST) {
+		optimizeTarget(parser, node->binary.left);
+	}
+	else {
+		optimizeNode(parser, node->binary.left);
+	}
+
+	optimizeNode(parser, node->binary.right);
+
+	//casts, with the type on the left
+	if (opcode == TOY_OP_TYPE_CAST) {
+		Toy_ASTNode* typeNode = node->binary.left;
+
+		while (typeNode->type == TOY_AST_NODE_GROUPING) {
+			typeNode = typeNode->grouping.child;
+		}
+
+		if (typeNode->type == TOY_AST_NODE_LITERAL && TOY_IS_TYPE(typeNode->atomic.literal) && isConstantNode(node->binary.right)) {
+			Toy_Literal result = calcStaticCast(typeNode->atomic.literal, node->binary.right->atomic.literal);
+
+			if (!TOY_IS_NULL(result)) {
+				replaceASTNodeLiteral(parser, node, result);
+				Toy_freeLiteral(result);
+			}
+		}
+
+		return;
+	}
+
+	if (!isConstantNode(node->binary.left) || !isConstantNode(node->binary.right)) {
+		return;
+	}
+
+	Toy_Literal lhs = node->binary.left->atomic.literal;
+	Toy_Literal rhs = node->binary.right->atomic.literal;
+
+	//leave anything that would fail to the interpreter, in case it's never run
+	if (opcode == TOY_OP_DIVISION || opcode == TOY_OP_MODULO) {
+		if ((TOY_IS_INTEGER(rhs) && TOY_AS_INTEGER(rhs) == 0) || (TOY_IS_FLOAT(rhs) && TOY_AS_FLOAT(rhs) == 0)) {
+			return;
+		}
+	}
+
+	if (opcode == TOY_OP_MODULO && (TOY_IS_FLOAT(lhs) || TOY_IS_FLOAT(rhs))) {
+		return;
+	}
+
+	calcStaticBinaryArithmetic(parser, &node);
+
+	//booleans and strings can be compared for equality too
+	if (node->type == TOY_AST_NODE_BINARY && (opcode == TOY_OP_COMPARE_EQUAL || opcode == TOY_OP_COMPARE_NOT_EQUAL)) {
+		bool equal = Toy_literalsAreEqual(lhs, rhs);
+		replaceASTNodeLiteral(parser, node, TOY_TO_BOOLEAN_LITERAL(opcode == TOY_OP_COMPARE_EQUAL ? equal : !equal));
+	}
+}
+
+static void optimizeNode(Toy_Parser* parser, Toy_ASTNode* node) {
+	if (node == NULL) {
+		return;
+	}
+
+	switch(node->type) {
+		case TOY_AST_NODE_LITERAL: {
+			Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+			if (TOY_IS_IDENTIFIER(node->atomic.literal) && findParserConstant(parser, node->atomic.literal, &value)) {
+				Toy_freeLiteral(node->atomic.literal);
+				node->atomic.literal = Toy_copyLiteral(value);
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_UNARY: {
+			if (node->unary.opcode == TOY_OP_TYPE_OF) {
+				optimizeTarget(parser, node->unary.child);
+				break;
+			}
+
+			optimizeNode(parser, node->unary.child);
+
+			if (!isConstantNode(node->unary.child)) {
+				break;
+			}
+
+			Toy_Literal lit = node->unary.child->atomic.literal;
+
+			if (node->unary.opcode == TOY_OP_NEGATE && TOY_IS_INTEGER(lit)) {
+				replaceASTNodeLiteral(parser, node, TOY_TO_INTEGER_LITERAL(-TOY_AS_INTEGER(lit)));
+			}
+			else if (node->unary.opcode == TOY_OP_NEGATE && TOY_IS_FLOAT(lit)) {
+				replaceASTNodeLiteral(parser, node, TOY_TO_FLOAT_LITERAL(-TOY_AS_FLOAT(lit)));
+			}
+			else if (node->unary.opcode == TOY_OP_INVERT && TOY_IS_BOOLEAN(lit)) {
+				replaceASTNodeLiteral(parser, node, TOY_TO_BOOLEAN_LITERAL(!TOY_AS_BOOLEAN(lit)));
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_BINARY:
+			optimizeBinary(parser, node);
+		break;
+
+		case TOY_AST_NODE_TERNARY: {
+			optimizeNode(parser, node->ternary.condition);
+
+			if (isConstantNode(node->ternary.condition)) {
+				Toy_ASTNode* path = NULL;
+
+				if (TOY_IS_TRUTHY(node->ternary.condition->atomic.literal)) {
+					path = node->ternary.thenPath;
+					node->ternary.thenPath = NULL;
+				}
+				else {
+					path = node->ternary.elsePath;
+					node->ternary.elsePath = NULL;
+				}
+
+				replaceASTNode(parser, node, path);
+				optimizeNode(parser, node);
+				break;
+			}
+
+			optimizeNode(parser, node->ternary.thenPath);
+			optimizeNode(parser, node->ternary.elsePath);
+		}
+		break;
+
+		case TOY_AST_NODE_GROUPING: {
+			optimizeNode(parser, node->grouping.child);
+
+			if (isConstantNode(node->grouping.child)) {
+				Toy_ASTNode* child = node->grouping.child;
+				node->grouping.child = NULL;
+				replaceASTNode(parser, node, child);
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_BLOCK:
+			beginParserScope(parser);
+
+			for (int i = 0; i < node->block.count; i++) {
+				optimizeNode(parser, &node->block.nodes[i]);
+			}
+
+			endParserScope(parser);
+		break;
+
+		case TOY_AST_NODE_INDEX:
+			optimizeNode(parser, node->index.first);
+			optimizeNode(parser, node->index.second);
+			optimizeNode(parser, node->index.third);
+		break;
+
+		case TOY_AST_NODE_VAR_DECL: {
+			optimizeNode(parser, node->varDecl.expression);
+
+			//only record constants that the interpreter won't need to convert
+			Toy_Literal type = node->varDecl.typeLiteral;
+			Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+			if (TOY_IS_TYPE(type) && TOY_AS_TYPE(type).constant && isConstantNode(node->varDecl.expression)) {
+				Toy_Literal literal = node->varDecl.expression->atomic.literal;
+
+				if (TOY_AS_TYPE(type).typeOf == TOY_LITERAL_ANY || TOY_AS_TYPE(type).typeOf == literal.type) {
+					value = literal;
+				}
+			}
+
+			declareParserVariable(parser, node->varDecl.identifier, value);
+		}
+		break;
+
+		case TOY_AST_NODE_FN_COLLECTION:
+			for (int i = 0; i < node->fnCollection.count; i++) {
+				optimizeNode(parser, &node->fnCollection.nodes[i]);
+			}
+		break;
+
+		case TOY_AST_NODE_FN_DECL:
+			declareParserVariable(parser, node->fnDecl.identifier, TOY_TO_NULL_LITERAL);
+
+			beginParserScope(parser);
+
+			for (int i = 0; i < node->fnDecl.arguments->fnCollection.count; i++) {
+				if (node->fnDecl.arguments->fnCollection.nodes[i].type == TOY_AST_NODE_VAR_DECL) {
+					declareParserVariable(parser, node->fnDecl.arguments->fnCollection.nodes[i].varDecl.identifier, TOY_TO_NULL_LITERAL);
+				}
+			}
+
+			optimizeNode(parser, node->fnDecl.block);
+
+			endParserScope(parser);
+		break;
+
+		case TOY_AST_NODE_FN_CALL:
+			optimizeNode(parser, node->fnCall.arguments);
+		break;
+
+		case TOY_AST_NODE_FN_RETURN:
+			optimizeNode(parser, node->returns.returns);
+		break;
+
+		case TOY_AST_NODE_IF: {
+			optimizeNode(parser, node->pathIf.condition);
+
+			//only one path can ever run
+			if (isConstantNode(node->pathIf.condition)) {
+				Toy_ASTNode* path = NULL;
+
+				if (TOY_IS_TRUTHY(node->pathIf.condition->atomic.literal)) {
+					path = node->pathIf.thenPath;
+					node->pathIf.thenPath = NULL;
+				}
+				else {
+					path = node->pathIf.elsePath;
+					node->pathIf.elsePath = NULL;
+				}
+
+				if (path == NULL) {
+					Toy_emitASTNodePass(&parser->arena, &path);
+				}
+
+				replaceASTNode(parser, node, path);
+				optimizeNode(parser, node);
+				break;
+			}
+
+			optimizeBranch(parser, node->pathIf.thenPath);
+			optimizeBranch(parser, node->pathIf.elsePath);
+		}
+		break;
+
+		case TOY_AST_NODE_WHILE: {
+			optimizeNode(parser, node->pathWhile.condition);
+
+			//the body can never run
+			if (isConstantNode(node->pathWhile.condition) && !TOY_IS_TRUTHY(node->pathWhile.condition->atomic.literal)) {
+				Toy_ASTNode* pass = NULL;
+				Toy_emitASTNodePass(&parser->arena, &pass);
+				replaceASTNode(parser, node, pass);
+				break;
+			}
+
+			optimizeBranch(parser, node->pathWhile.thenPath);
+		}
+		break;
+
+		case TOY_AST_NODE_FOR:
+			beginParserScope(parser);
+
+			optimizeNode(parser, node->pathFor.preClause);
+			optimizeNode(parser, node->pathFor.condition);
+			optimizeNode(parser, node->pathFor.postClause);
+			optimizeBranch(parser, node->pathFor.thenPath);
+
+			endParserScope(parser);
+		break;
+
+		case TOY_AST_NODE_AND:
+		case TOY_AST_NODE_OR: {
+			optimizeNode(parser, node->pathAnd.left);
+
+			if (!isConstantNode(node->pathAnd.left)) {
+				optimizeNode(parser, node->pathAnd.right);
+				break;
+			}
+
+			//&& results in a falsy lhs, || results in a truthy lhs, otherwise both result in the rhs
+			Toy_ASTNode* path = NULL;
+
+			if (TOY_IS_TRUTHY(node->pathAnd.left->atomic.literal) == (node->type == TOY_AST_NODE_OR)) {
+				path = node->pathAnd.left;
+				node->pathAnd.left = NULL;
+				replaceASTNode(parser, node, path);
+			}
+			else {
+				path = node->pathAnd.right;
+				node->pathAnd.right = NULL;
+				replaceASTNode(parser, node, path);
+				optimizeNode(parser, node);
+			}
+		}
+		break;
+
+		case TOY_AST_NODE_IMPORT:
+			if (parser->constantCount > 0) {
+				pushParserConstant(parser, TOY_TO_NULL_LITERAL, TOY_TO_NULL_LITERAL);
+			}
+		break;
+
+		//compounds are stored as literals by the compiler, so are left alone
+		case TOY_AST_NODE_ERROR:
+		case TOY_AST_NODE_COMPOUND:
+		case TOY_AST_NODE_PAIR:
+		case TOY_AST_NODE_BREAK:
+		case TOY_AST_NODE_CONTINUE:
+		case TOY_AST_NODE_PREFIX_INCREMENT:
+		case TOY_AST_NODE_PREFIX_DECREMENT:
+		case TOY_AST_NODE_POSTFIX_INCREMENT:
+		case TOY_AST_NODE_POSTFIX_DECREMENT:
+		case TOY_AST_NODE_PASS:
+		break;
+	}
+}
+
 //exposed functions
 void Toy_initParser(Toy_Parser* parser, Toy_Lexer* lexer) {
 	parser->lexer = lexer;
@@ -1921,6 +2386,14 @@ void Toy_initParser(Toy_Parser* parser, Toy_Lexer* lexer) {
 
 	parser->previous.type = TOY_TOKEN_NULL;
 	parser->current.type = TOY_TOKEN_NULL;
+
+	parser->constants = NULL;
+	parser->constantCapacity = 0;
+	parser->constantCount = 0;
+	parser->constantDepth = 0;
+
+	Toy_initASTArena(&parser->arena);
+
 	advance(parser);
 }
 
@@ -1931,15 +2404,31 @@ void Toy_freeParser(Toy_Parser* parser) {
 
 	parser->previous.type = TOY_TOKEN_NULL;
 	parser->current.type = TOY_TOKEN_NULL;
+
+	for (int i = 0; i < parser->constantCount; i++) {
+		Toy_freeLiteral(parser->constants[i].identifier);
+		Toy_freeLiteral(parser->constants[i].value);
+	}
+
+	TOY_FREE_ARRAY(Toy_private_parser_constant, parser->constants, parser->constantCapacity);
+
+	parser->constants = NULL;
+	parser->constantCapacity = 0;
+	parser->constantCount = 0;
+	parser->constantDepth = 0;
+
+	Toy_freeASTArena(&parser->arena);
 }
 
 Toy_ASTNode* Toy_scanParser(Toy_Parser* parser) {
+	//the previous tree has been freed by now, so its memory can be reused in one go
+	Toy_clearASTArena(&parser->arena);
+
 	//check for EOF
 	if (match(parser, TOY_TOKEN_EOF)) {
 		return NULL;
 	}
 
-	//returns nodes on the heap
 	Toy_ASTNode* node = NULL;
 
 	//process the grammar rule for this line
@@ -1949,9 +2438,12 @@ Toy_ASTNode* Toy_scanParser(Toy_Parser* parser) {
 		synchronize(parser);
 		//return an error node for this iteration
 		Toy_freeASTNode(node);
-		node = TOY_ALLOCATE(Toy_ASTNode, 1);
+		node = Toy_private_allocateASTNodes(&parser->arena, 1);
 		node->type = TOY_AST_NODE_ERROR;
 	}
+	else {
+		optimizeNode(parser, node);
+	}
 
 	return node;
 }
@@ -56,6 +56,13 @@ const unsigned char* Toy_compileString(const char* source, size_t* size) {
 #include "toy_lexer.h"
 #include "toy_ast_node.h"
 
+//const variables with literal values, visible from the current point in the program
+typedef struct Toy_private_parser_constant {
+	Toy_Literal identifier; //null marks an import, which can declare anything
+	Toy_Literal value; //null when a later declaration hides the constant
+	int depth;
+} Toy_private_parser_constant;
+
 //Parsers are bound to a lexer, and turn the outputted tokens into AST nodes
 typedef struct {
 	Toy_Lexer* lexer;
@@ -65,6 +72,15 @@ typedef struct {
 	//track the last two outputs from the lexer
 	Toy_Token current;
 	Toy_Token previous;
+
+	//for propagating constants into later statements
+	Toy_private_parser_constant* constants;
+	int constantCapacity;
+	int constantCount;
+	int constantDepth;
+
+	//the nodes of each tree, released together at the next scan
+	Toy_ASTArena arena;
 } Toy_Parser;
 
 /*!
@@ -90,7 +106,11 @@ TOY_API void Toy_freeParser(Toy_Parser* parser);
 
 This function returns an abstract syntax tree representing part of the program, or an error node. The abstract syntax tree must be passed to `Toy_writeCompiler()` and/or `Toy_freeASTNode()`.
 
+The nodes of each tree are allocated from an arena within the parser, rather than one at a time. `Toy_freeASTNode()` only releases the literals held by such a tree, and the memory of the whole tree is reused by the next call to this function (or released by `Toy_freeParser()`) - so each tree must be finished with, and freed, before the next is scanned.
+
 This function should be called repeatedly until it returns `NULL`, indicating the end of the program.
+
+Each abstract syntax tree is simplified before it is returned: `const` variables with literal values are replaced by those values in later statements, expressions with constant operands are folded, and `if` and `while` statements with constant conditions lose the branches that can never run.
 !*/
 TOY_API Toy_ASTNode* Toy_scanParser(Toy_Parser* parser);
 
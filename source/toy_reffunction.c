@@ -1,27 +1,34 @@
 #include "toy_reffunction.h"
 
+#include "toy_memory.h"
+#include "toy_literal_array.h"
+#include "toy_context.h"
+
 #include <string.h>
 
 //memory allocation
-extern void* Toy_private_defaultMemoryAllocator(void* pointer, size_t oldSize, size_t newSize);
-static Toy_RefFunctionAllocatorFn allocate = Toy_private_defaultMemoryAllocator;
+static void* allocate(void* pointer, size_t oldSize, size_t newSize) {
+	return Toy_getContext()->refFunctionAllocator(pointer, oldSize, newSize);
+}
 
 void Toy_setRefFunctionAllocatorFn(Toy_RefFunctionAllocatorFn allocator) {
-	allocate = allocator;
+	Toy_getContext()->refFunctionAllocator = allocator;
 }
 
 //API
 Toy_RefFunction* Toy_createRefFunction(const void* data, size_t length) {
 	//allocate the memory area (including metadata space)
-	Toy_RefFunction* refFunction = allocate(NULL, 0, sizeof(size_t) + sizeof(int) + sizeof(char) * length);
+	Toy_RefFunction* refFunction = allocate(NULL, 0, sizeof(Toy_RefFunction) + sizeof(char) * length);
 
 	if (refFunction == NULL) {
 		return NULL;
 	}
 
 	//set the data
-	refFunction->refCount = 1;
+	atomic_init(&refFunction->refCount, 1);
 	refFunction->length = length;
+	refFunction->literalCache = NULL;
+	refFunction->codeStart = -1;
 	memcpy(refFunction->data, data, refFunction->length);
 
 	return refFunction;
@@ -29,14 +36,19 @@ Toy_RefFunction* Toy_createRefFunction(const void* data, size_t length) {
 
 void Toy_deleteRefFunction(Toy_RefFunction* refFunction) {
 	//decrement, then check
-	refFunction->refCount--;
-	if (refFunction->refCount <= 0) {
-		allocate(refFunction, sizeof(size_t) + sizeof(int) + sizeof(char) * (refFunction->length + 1), 0);
+	if (atomic_fetch_sub_explicit(&refFunction->refCount, 1, memory_order_acq_rel) == 1) {
+		//free the decoded literals, if the function was ever called
+		if (refFunction->literalCache != NULL) {
+			Toy_freeLiteralArray(refFunction->literalCache);
+			TOY_FREE(Toy_LiteralArray, refFunction->literalCache);
+		}
+
+		allocate(refFunction, sizeof(Toy_RefFunction) + sizeof(char) * refFunction->length, 0);
 	}
 }
 
 int Toy_countRefFunction(Toy_RefFunction* refFunction) {
-	return refFunction->refCount;
+	return atomic_load_explicit(&refFunction->refCount, memory_order_relaxed);
 }
 
 size_t Toy_lengthRefFunction(Toy_RefFunction* refFunction) {
@@ -45,7 +57,7 @@ size_t Toy_lengthRefFunction(Toy_RefFunction* refFunction) {
 
 Toy_RefFunction* Toy_copyRefFunction(Toy_RefFunction* refFunction) {
 	//Cheaty McCheater Face
-	refFunction->refCount++;
+	atomic_fetch_add_explicit(&refFunction->refCount, 1, memory_order_relaxed);
 	return refFunction;
 }
 
@@ -12,10 +12,17 @@ This module reserves the right to instead preform a deep copy when it sees fit (
 
 #include "toy_common.h"
 
+#include <stdatomic.h>
+
+//forward declare, so the decoded literals can be cached here
+struct Toy_LiteralArray;
+
 //the RefFunction structure
 typedef struct Toy_RefFunction {
 	size_t length;
-	int refCount;
+	atomic_int refCount;
+	struct Toy_LiteralArray* literalCache; //decoded on the first call, then shared between calls
+	int codeStart; //where the code section begins, after the literal and function sections
 	unsigned char data[];
 } Toy_RefFunction;
 
@@ -46,14 +53,14 @@ TOY_API void Toy_setRefFunctionAllocatorFn(Toy_RefFunctionAllocatorFn);
 
 This function returns a new `Toy_RefFunction`, containing a copy of `data`, or `NULL` on error.
 
-This function also sets the returned `refFunction`'s reference counter to 1.
+This function also sets the returned `refFunction`'s reference counter to 1. The `literalCache` is left empty, to be filled by the interpreter the first time the function is called.
 !*/
 TOY_API Toy_RefFunction* Toy_createRefFunction(const void* data, size_t length);
 
 /*!
 ### void Toy_deleteRefFunction(Toy_RefFunction* refFunction)
 
-This function reduces the `refFunction`'s reference counter by 1 and, if it reaches 0, frees the memory.
+This function reduces the `refFunction`'s reference counter by 1 and, if it reaches 0, frees the memory, including the cached literals (if any).
 !*/
 TOY_API void Toy_deleteRefFunction(Toy_RefFunction* refFunction);
 
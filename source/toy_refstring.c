@@ -1,11 +1,194 @@
 #include "toy_refstring.h"
 
+#include "toy_context.h"
+
 //memory allocation
-extern void* Toy_private_defaultMemoryAllocator(void* pointer, size_t oldSize, size_t newSize);
-static Toy_RefStringAllocatorFn allocate = Toy_private_defaultMemoryAllocator;
+static void* allocate(void* pointer, size_t oldSize, size_t newSize) {
+	return Toy_getContext()->refStringAllocator(pointer, oldSize, newSize);
+}
 
 void Toy_setRefStringAllocatorFn(Toy_RefStringAllocatorFn allocator) {
-	allocate = allocator;
+	Toy_getContext()->refStringAllocator = allocator;
+}
+
+//one character refstrings, which are never freed - raw storage, because an array can't hold a flexible array member
+#define CHARACTER_STRIDE (((sizeof(Toy_RefString) + 2) + _Alignof(Toy_RefString) - 1) / _Alignof(Toy_RefString) * _Alignof(Toy_RefString))
+static _Alignas(Toy_RefString) unsigned char characterTable[256 * CHARACTER_STRIDE];
+static atomic_int characterTableState = 0; //0 is empty, 1 is being filled, 2 is ready
+
+//slices shorter than this are copied instead
+#define SLICE_MINIMUM 32
+
+static bool isCharacterRefString(Toy_RefString* refString) {
+	return (unsigned char*)refString >= characterTable && (unsigned char*)refString < characterTable + sizeof(characterTable);
+}
+
+static void fillCharacterTable() {
+	int expected = 0;
+
+	//another thread got here first, so wait for it
+	if (!atomic_compare_exchange_strong(&characterTableState, &expected, 1)) {
+		while (atomic_load_explicit(&characterTableState, memory_order_acquire) != 2) {
+			//NO OP
+		}
+		return;
+	}
+
+	for (int c = 0; c < 256; c++) {
+		Toy_RefString* refString = (Toy_RefString*)&characterTable[c * CHARACTER_STRIDE];
+
+		refString->length = 1;
+		refString->capacity = 1;
+		atomic_init(&refString->refCount, 1);
+		refString->interned = NULL;
+		refString->parent = NULL;
+		refString->offset = 0;
+		atomic_init(&refString->cstring, NULL);
+		refString->data[0] = (char)c;
+		refString->data[1] = '\0';
+	}
+
+	atomic_store_explicit(&characterTableState, 2, memory_order_release);
+}
+
+static Toy_RefString* getCharacterRefString(unsigned char c) {
+	if (atomic_load_explicit(&characterTableState, memory_order_acquire) != 2) {
+		fillCharacterTable();
+	}
+
+	//not counted, so threads indexing strings don't contend over these
+	return (Toy_RefString*)&characterTable[c * CHARACTER_STRIDE];
+}
+
+static const char* charsOf(Toy_RefString* refString) {
+	return refString->parent == NULL ? refString->data : refString->parent->data + refString->offset;
+}
+
+//the intern tables live in each context, and are locked while in use, as another thread can release an interned refstring
+static void lockInternTable(Toy_Context* context) {
+	while (atomic_flag_test_and_set_explicit(&context->internLock, memory_order_acquire)) {
+		//NO OP
+	}
+}
+
+static void unlockInternTable(Toy_Context* context) {
+	atomic_flag_clear_explicit(&context->internLock, memory_order_release);
+}
+
+static unsigned int hashInternString(const char* cstring, size_t length) {
+	unsigned int hash = 2166136261u;
+
+	for (size_t i = 0; i < length; i++) {
+		hash *= 16777619;
+		hash ^= (unsigned char)cstring[i];
+	}
+
+	return hash;
+}
+
+static bool growInternTable(Toy_Context* context) {
+	int oldCapacity = context->internCapacity;
+	int newCapacity = oldCapacity < 64 ? 64 : oldCapacity * 2;
+
+	//grow in place, so the table stays with the allocator that created it
+	Toy_RefString** entries = context->refStringAllocator(NULL, 0, sizeof(Toy_RefString*) * context->internCount);
+	int entryCount = 0;
+
+	if (entries == NULL && context->internCount > 0) {
+		return false;
+	}
+
+	for (int i = 0; i < oldCapacity; i++) {
+		if (context->internTable[i] != NULL) {
+			entries[entryCount++] = context->internTable[i];
+		}
+	}
+
+	Toy_RefString** table = context->refStringAllocator(context->internTable, sizeof(Toy_RefString*) * oldCapacity, sizeof(Toy_RefString*) * newCapacity);
+
+	if (table == NULL) {
+		context->refStringAllocator(entries, sizeof(Toy_RefString*) * context->internCount, 0);
+		return false;
+	}
+
+	context->internTable = table;
+	context->internCapacity = newCapacity;
+
+	for (int i = 0; i < context->internCapacity; i++) {
+		context->internTable[i] = NULL;
+	}
+
+	for (int i = 0; i < entryCount; i++) {
+		unsigned int index = hashInternString(entries[i]->data, entries[i]->length) & (context->internCapacity - 1);
+
+		while (context->internTable[index] != NULL) {
+			index = (index + 1) & (context->internCapacity - 1);
+		}
+
+		context->internTable[index] = entries[i];
+	}
+
+	context->refStringAllocator(entries, sizeof(Toy_RefString*) * context->internCount, 0);
+	return true;
+}
+
+static void releaseInternTable(Toy_Context* context) {
+	context->refStringAllocator(context->internTable, sizeof(Toy_RefString*) * context->internCapacity, 0);
+	context->internTable = NULL;
+	context->internCapacity = 0;
+	context->internCount = 0;
+}
+
+static void removeInternedRefString(Toy_RefString* refString) {
+	Toy_Context* context = refString->interned;
+	lockInternTable(context);
+
+	unsigned int mask = context->internCapacity - 1;
+	unsigned int index = hashInternString(refString->data, refString->length) & mask;
+
+	while (context->internTable[index] != refString) {
+		index = (index + 1) & mask;
+	}
+
+	context->internTable[index] = NULL;
+	context->internCount--;
+
+	//shift the rest of the cluster back, so no probe sequence is broken
+	unsigned int next = (index + 1) & mask;
+	while (context->internTable[next] != NULL) {
+		unsigned int home = hashInternString(context->internTable[next]->data, context->internTable[next]->length) & mask;
+
+		//move it back unless its home lies cyclically within (index, next]
+		if ((next > index && (home <= index || home > next)) || (next < index && home <= index && home > next)) {
+			context->internTable[index] = context->internTable[next];
+			context->internTable[next] = NULL;
+			index = next;
+		}
+
+		next = (next + 1) & mask;
+	}
+
+	//release the table once it's empty, so it never outlives a memory region
+	if (context->internCount == 0) {
+		releaseInternTable(context);
+	}
+
+	unlockInternTable(context);
+}
+
+//called by Toy_freeContext() - anything still interned is left as an ordinary refstring
+void Toy_private_releaseInternTable() {
+	Toy_Context* context = Toy_getContext();
+	lockInternTable(context);
+
+	for (int i = 0; i < context->internCapacity; i++) {
+		if (context->internTable[i] != NULL) {
+			context->internTable[i]->interned = NULL;
+		}
+	}
+
+	releaseInternTable(context);
+	unlockInternTable(context);
 }
 
 //API
@@ -15,34 +198,263 @@ Toy_RefString* Toy_createRefString(const char* cstring) {
 	return Toy_createRefStringLength(cstring, length);
 }
 
-Toy_RefString* Toy_createRefStringLength(const char* cstring, size_t length) {
+static Toy_RefString* allocateRefString(size_t length, size_t capacity) {
 	//allocate the memory area (including metadata space)
-	Toy_RefString* refString = allocate(NULL, 0, sizeof(size_t) + sizeof(int) + sizeof(char) * (length + 1));
+	Toy_RefString* refString = allocate(NULL, 0, sizeof(Toy_RefString) + sizeof(char) * (capacity + 1));
 
 	if (refString == NULL) {
 		return NULL;
 	}
 
 	//set the data
-	refString->refCount = 1;
+	atomic_init(&refString->refCount, 1);
 	refString->length = length;
-	strncpy(refString->data, cstring, refString->length);
+	refString->capacity = capacity;
+	refString->interned = NULL;
+	refString->parent = NULL;
+	refString->offset = 0;
+	atomic_init(&refString->cstring, NULL);
 
 	refString->data[refString->length] = '\0'; //string terminator
 
 	return refString;
 }
 
+Toy_RefString* Toy_createRefStringLength(const char* cstring, size_t length) {
+	Toy_RefString* refString = allocateRefString(length, length);
+
+	if (refString == NULL) {
+		return NULL;
+	}
+
+	//an empty string may not have a buffer at all
+	if (length > 0) {
+		memcpy(refString->data, cstring, length);
+	}
+
+	return refString;
+}
+
+Toy_RefString* Toy_concatRefString(Toy_RefString* lhs, Toy_RefString* rhs) {
+	Toy_RefString* refString = allocateRefString(lhs->length + rhs->length, lhs->length + rhs->length);
+
+	if (refString == NULL) {
+		return NULL;
+	}
+
+	memcpy(refString->data, charsOf(lhs), lhs->length);
+	memcpy(refString->data + lhs->length, charsOf(rhs), rhs->length);
+
+	return refString;
+}
+
+Toy_RefString* Toy_appendRefString(Toy_RefString* lhs, Toy_RefString* rhs) {
+	size_t length = lhs->length + rhs->length;
+
+	//write into the spare capacity (never touch interned or shared values)
+	if (!lhs->interned && length <= lhs->capacity && !isCharacterRefString(lhs)) {
+		memcpy(lhs->data + lhs->length, charsOf(rhs), rhs->length);
+		lhs->length = length;
+		lhs->data[lhs->length] = '\0';
+
+		return Toy_copyRefString(lhs);
+	}
+
+	//leave room to grow, so repeated appends only copy a logarithmic number of times
+	Toy_RefString* refString = allocateRefString(length, length < 8 ? 8 : length * 2);
+
+	if (refString == NULL) {
+		return NULL;
+	}
+
+	memcpy(refString->data, charsOf(lhs), lhs->length);
+	memcpy(refString->data + lhs->length, charsOf(rhs), rhs->length);
+
+	return refString;
+}
+
+Toy_RefString* Toy_sliceRefString(Toy_RefString* refString, size_t offset, size_t length) {
+	if (length == 1) {
+		return getCharacterRefString((unsigned char)charsOf(refString)[offset]);
+	}
+
+	if (offset == 0 && length == refString->length) {
+		return Toy_copyRefString(refString);
+	}
+
+	if (length < SLICE_MINIMUM) {
+		return Toy_createRefStringLength(charsOf(refString) + offset, length);
+	}
+
+	//always share the original memory, rather than building a chain of slices
+	if (refString->parent != NULL) {
+		offset += refString->offset;
+		refString = refString->parent;
+	}
+
+	Toy_RefString* slice = allocate(NULL, 0, sizeof(Toy_RefString) + sizeof(char));
+
+	if (slice == NULL) {
+		return NULL;
+	}
+
+	atomic_init(&slice->refCount, 1);
+	slice->length = length;
+	slice->capacity = 0;
+	slice->interned = NULL;
+	slice->parent = Toy_copyRefString(refString);
+	slice->offset = offset;
+	atomic_init(&slice->cstring, NULL);
+	slice->data[0] = '\0';
+
+	return slice;
+}
+
 void Toy_deleteRefString(Toy_RefString* refString) {
+	if (isCharacterRefString(refString)) {
+		return;
+	}
+
 	//decrement, then check
-	refString->refCount--;
-	if (refString->refCount <= 0) {
-		allocate(refString, sizeof(size_t) + sizeof(int) + sizeof(char) * (refString->length + 1), 0);
+	if (atomic_fetch_sub_explicit(&refString->refCount, 1, memory_order_acq_rel) == 1) {
+		if (refString->interned) {
+			removeInternedRefString(refString);
+		}
+
+		if (refString->parent != NULL) {
+			Toy_deleteRefString(refString->parent);
+		}
+
+		if (atomic_load_explicit(&refString->cstring, memory_order_acquire) != NULL) {
+			Toy_deleteRefString(atomic_load_explicit(&refString->cstring, memory_order_acquire));
+		}
+
+		allocate(refString, sizeof(Toy_RefString) + sizeof(char) * (refString->capacity + 1), 0);
+	}
+}
+
+//take a reference, unless another thread has already released the last one
+static bool reviveRefString(Toy_RefString* refString) {
+	int count = atomic_load_explicit(&refString->refCount, memory_order_relaxed);
+
+	while (count > 0) {
+		if (atomic_compare_exchange_weak_explicit(&refString->refCount, &count, count + 1, memory_order_acq_rel, memory_order_relaxed)) {
+			return true;
+		}
 	}
+
+	return false;
+}
+
+//find the interned refstring and take a reference to it, or the empty slot where it belongs
+static Toy_RefString** findInternSlot(Toy_Context* context, const char* cstring, size_t length) {
+	unsigned int mask = context->internCapacity - 1;
+	unsigned int index = hashInternString(cstring, length) & mask;
+
+	while (context->internTable[index] != NULL) {
+		//skip over any that are waiting to be removed
+		if (context->internTable[index]->length == length && (length == 0 || memcmp(context->internTable[index]->data, cstring, length) == 0) && reviveRefString(context->internTable[index])) {
+			break;
+		}
+
+		index = (index + 1) & mask;
+	}
+
+	return &context->internTable[index];
+}
+
+Toy_RefString* Toy_internRefStringLength(const char* cstring, size_t length) {
+	Toy_Context* context = Toy_getContext();
+	lockInternTable(context);
+
+	context->internStats.lookups++;
+
+	//keep the load factor under 3/4
+	if ((context->internCount + 1) * 4 > context->internCapacity * 3 && !growInternTable(context)) {
+		unlockInternTable(context);
+		return NULL;
+	}
+
+	Toy_RefString** slot = findInternSlot(context, cstring, length);
+
+	if (*slot != NULL) {
+		context->internStats.hits++;
+		unlockInternTable(context);
+		return *slot;
+	}
+
+	Toy_RefString* refString = Toy_createRefStringLength(cstring, length);
+
+	if (refString != NULL) {
+		refString->interned = context;
+		*slot = refString;
+		context->internCount++;
+	}
+
+	unlockInternTable(context);
+	return refString;
+}
+
+Toy_RefString* Toy_internRefString(Toy_RefString* refString) {
+	if (refString->interned) {
+		return refString;
+	}
+
+	//slices and characters are shared, so intern a copy instead
+	if (refString->parent != NULL || isCharacterRefString(refString)) {
+		Toy_RefString* result = Toy_internRefStringLength(charsOf(refString), refString->length);
+
+		if (result == NULL) {
+			return refString; //still usable, just not interned
+		}
+
+		Toy_deleteRefString(refString);
+		return result;
+	}
+
+	Toy_Context* context = Toy_getContext();
+	lockInternTable(context);
+
+	context->internStats.lookups++;
+
+	if ((context->internCount + 1) * 4 > context->internCapacity * 3 && !growInternTable(context)) {
+		unlockInternTable(context);
+		return refString; //still usable, just not interned
+	}
+
+	Toy_RefString** slot = findInternSlot(context, refString->data, refString->length);
+
+	if (*slot != NULL) {
+		context->internStats.hits++;
+		Toy_RefString* result = *slot;
+		unlockInternTable(context);
+
+		Toy_deleteRefString(refString);
+		return result;
+	}
+
+	refString->interned = context;
+	*slot = refString;
+	context->internCount++;
+
+	unlockInternTable(context);
+	return refString;
+}
+
+Toy_RefStringInternStats Toy_getRefStringInternStats() {
+	Toy_Context* context = Toy_getContext();
+	lockInternTable(context);
+
+	Toy_RefStringInternStats stats = context->internStats;
+	stats.count = context->internCount;
+	stats.capacity = context->internCapacity;
+
+	unlockInternTable(context);
+	return stats;
 }
 
 int Toy_countRefString(Toy_RefString* refString) {
-	return refString->refCount;
+	return atomic_load_explicit(&refString->refCount, memory_order_relaxed);
 }
 
 size_t Toy_lengthRefString(Toy_RefString* refString) {
@@ -51,17 +463,50 @@ size_t Toy_lengthRefString(Toy_RefString* refString) {
 
 Toy_RefString* Toy_copyRefString(Toy_RefString* refString) {
 	//Cheaty McCheater Face
-	refString->refCount++;
+	if (!isCharacterRefString(refString)) {
+		atomic_fetch_add_explicit(&refString->refCount, 1, memory_order_relaxed);
+	}
 	return refString;
 }
 
 Toy_RefString* Toy_deepCopyRefString(Toy_RefString* refString) {
 	//create a new string, with a new refCount
-	return Toy_createRefStringLength(refString->data, refString->length);
+	return Toy_createRefStringLength(charsOf(refString), refString->length);
 }
 
 const char* Toy_toCString(Toy_RefString* refString) {
-	return refString->data;
+	if (refString->parent == NULL) {
+		return refString->data;
+	}
+
+	//a slice that runs to the end of its parent can use the parent's terminator
+	if (refString->offset + refString->length == refString->parent->length) {
+		return charsOf(refString);
+	}
+
+	//otherwise, make a terminated copy once, and keep it until the slice is freed
+	Toy_RefString* copy = atomic_load_explicit(&refString->cstring, memory_order_acquire);
+
+	if (copy == NULL) {
+		copy = Toy_createRefStringLength(charsOf(refString), refString->length);
+
+		if (copy == NULL) {
+			return NULL;
+		}
+
+		//another thread may have made one at the same time
+		Toy_RefString* expected = NULL;
+		if (!atomic_compare_exchange_strong_explicit(&refString->cstring, &expected, copy, memory_order_acq_rel, memory_order_acquire)) {
+			Toy_deleteRefString(copy);
+			copy = expected;
+		}
+	}
+
+	return copy->data;
+}
+
+const char* Toy_dataRefString(Toy_RefString* refString) {
+	return charsOf(refString);
 }
 
 bool Toy_equalsRefString(Toy_RefString* lhs, Toy_RefString* rhs) {
@@ -70,13 +515,18 @@ bool Toy_equalsRefString(Toy_RefString* lhs, Toy_RefString* rhs) {
 		return true;
 	}
 
+	//interned values are unique within their table
+	if (lhs->interned != NULL && lhs->interned == rhs->interned) {
+		return false;
+	}
+
 	//different length
 	if (lhs->length != rhs->length) {
 		return false;
 	}
 
 	//same string
-	return strncmp(lhs->data, rhs->data, lhs->length) == 0;
+	return memcmp(charsOf(lhs), charsOf(rhs), lhs->length) == 0;
 }
 
 bool Toy_equalsRefStringCString(Toy_RefString* lhs, char* cstring) {
@@ -89,5 +539,5 @@ bool Toy_equalsRefStringCString(Toy_RefString* lhs, char* cstring) {
 	}
 
 	//same string
-	return strncmp(lhs->data, cstring, lhs->length) == 0;
+	return memcmp(charsOf(lhs), cstring, lhs->length) == 0;
 }
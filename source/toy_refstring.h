@@ -7,7 +7,7 @@ This header defines the structure `Toy_RefString`, as well as all of the related
 
 [refstring](https://github.com/Ratstail91/refstring) is a stand-alone utility written to reduce the amount of memory manipulation used within Toy. It was independantly written and tested, before being incorporated into Toy proper. As such it has it's own memory management API, which by default is tied into Toy's [core memory API](toy_memory_h.md).
 
-Instances of `Toy_RefString` are reference counted - that is, rather than copying an existing string in memory, a pointer to the refstring is returned, and the internal reference counter is increased by 1. When the pointer is no longer needed, `Toy_DeleteRefString` can be called; this will decrement the internal reference counter by 1, and only free it when it reaches 0. This has multiple benefits, when used correctly:
+Instances of `Toy_RefString` are reference counted - that is, rather than copying an existing string in memory, a pointer to the refstring is returned, and the internal reference counter is increased by 1. When the pointer is no longer needed, `Toy_DeleteRefString` can be called; this will decrement the internal reference counter by 1, and only free it when it reaches 0. The reference counter is atomic, so a refstring can be shared between threads. This has multiple benefits, when used correctly:
 
 * Reduced memory usage
 * Faster program execution
@@ -17,15 +17,32 @@ This module reserves the right to instead preform a deep copy when it sees fit (
 
 #include "toy_common.h"
 
+#include <stdatomic.h>
 #include <string.h>
 
+//forward declare, interned refstrings belong to a context's intern table
+struct Toy_Context;
+
 //the RefString structure
 typedef struct Toy_RefString {
 	size_t length;
-	int refCount;
+	size_t capacity; //room for this many characters, not counting the terminator
+	atomic_int refCount;
+	struct Toy_Context* interned; //the context whose intern table holds this, where no other refstring has the same value
+	struct Toy_RefString* parent; //a slice reads its characters from the parent, starting at offset
+	size_t offset;
+	_Atomic(struct Toy_RefString*) cstring; //a terminated copy of a slice, made by Toy_toCString()
 	char data[];
 } Toy_RefString;
 
+//the intern table's usage, for diagnostics
+typedef struct Toy_RefStringInternStats {
+	size_t lookups;
+	size_t hits;
+	int count;
+	int capacity;
+} Toy_RefStringInternStats;
+
 /*!
 ## Defined Interfaces
 !*/
@@ -64,6 +81,56 @@ This function also sets the returned refstring's reference counter to 1.
 !*/
 TOY_API Toy_RefString* Toy_createRefStringLength(const char* cstring, size_t length);
 
+/*!
+### Toy_RefString* Toy_concatRefString(Toy_RefString* lhs, Toy_RefString* rhs)
+
+This function returns a new `Toy_RefString`, containing the value of `lhs` followed by the value of `rhs`, or `NULL` on error. Neither argument is modified.
+
+This function also sets the returned refstring's reference counter to 1.
+!*/
+TOY_API Toy_RefString* Toy_concatRefString(Toy_RefString* lhs, Toy_RefString* rhs);
+
+/*!
+### Toy_RefString* Toy_appendRefString(Toy_RefString* lhs, Toy_RefString* rhs)
+
+This function returns a refstring containing the value of `lhs` followed by the value of `rhs`, or `NULL` on error. If `lhs` isn't interned and has enough spare capacity, `rhs` is written into it in place, and `lhs` is returned with its reference counter increased by 1. Otherwise, a new refstring is returned, with room to grow geometrically, so that appending to it repeatedly takes amortized constant time.
+
+Because `lhs` can be changed, the caller must make sure nothing else that holds a reference to `lhs` can see it - `Toy_concatRefString` should be used instead when that's in doubt.
+!*/
+TOY_API Toy_RefString* Toy_appendRefString(Toy_RefString* lhs, Toy_RefString* rhs);
+
+/*!
+### Toy_RefString* Toy_sliceRefString(Toy_RefString* refString, size_t offset, size_t length)
+
+This function returns a refstring containing `length` characters of `refString`, starting at `offset`, or `NULL` on error. The range must lie within `refString`.
+
+Long slices share the memory of `refString`, holding a reference to it instead of copying the characters. Single characters come from a table of preallocated one character refstrings, so they're never allocated, and aren't reference counted. Short slices are copied, so they don't keep a large parent alive.
+!*/
+TOY_API Toy_RefString* Toy_sliceRefString(Toy_RefString* refString, size_t offset, size_t length);
+
+/*!
+### Toy_RefString* Toy_internRefStringLength(const char* cstring, size_t length)
+
+This function returns the interned `Toy_RefString` containing `cstring`, creating it if it doesn't exist yet, or `NULL` on error. Either way, the reference counter of the returned refstring is increased by 1.
+
+Each context has an intern table of its own, see [toy_context.h](toy_context_h.md) - this function uses the current context's table. Interned refstrings from the same table with different pointers never have the same value, so `Toy_equalsRefString` can compare them by pointer alone. A refstring is removed from its intern table when it is freed, even by another thread.
+!*/
+TOY_API Toy_RefString* Toy_internRefStringLength(const char* cstring, size_t length);
+
+/*!
+### Toy_RefString* Toy_internRefString(Toy_RefString* refString)
+
+This function takes ownership of one reference to `refString`, and returns a reference to the interned refstring with the same value. If there isn't one yet, `refString` itself becomes the interned refstring.
+!*/
+TOY_API Toy_RefString* Toy_internRefString(Toy_RefString* refString);
+
+/*!
+### Toy_RefStringInternStats Toy_getRefStringInternStats()
+
+This function returns the number of intern table lookups made so far within the current context, how many of them found an existing refstring, and the current size of the table, for debugging.
+!*/
+TOY_API Toy_RefStringInternStats Toy_getRefStringInternStats();
+
 /*!
 ### void Toy_deleteRefString(Toy_RefString* refString)
 
@@ -105,13 +172,22 @@ TOY_API Toy_RefString* Toy_deepCopyRefString(Toy_RefString* refString);
 ### const char* Toy_toCString(Toy_RefString* refString)
 
 This function exposes the interal cstring of `refString`. Only use this function when dealing with external APIs.
+
+A slice doesn't have a terminator of its own, so the first call on one copies its characters into a terminated refstring, which is kept until the slice is freed.
 !*/
 TOY_API const char* Toy_toCString(Toy_RefString* refString);
 
+/*!
+### const char* Toy_dataRefString(Toy_RefString* refString)
+
+This function exposes the characters of `refString`, which are only guaranteed to be terminated after `Toy_toCString` has been called. Use this together with `Toy_lengthRefString`, wherever a cstring isn't needed.
+!*/
+TOY_API const char* Toy_dataRefString(Toy_RefString* refString);
+
 /*!
 ### bool Toy_equalsRefString(Toy_RefString* lhs, Toy_RefString* rhs)
 
-This function returns true when the two refstrings are either the same refstring, or contain the same value. Otherwise it returns false.
+This function returns true when the two refstrings are either the same refstring, or contain the same value. Otherwise it returns false. Two different refstrings interned in the same table are never equal, so their contents aren't compared.
 !*/
 TOY_API bool Toy_equalsRefString(Toy_RefString* lhs, Toy_RefString* rhs);
 
@@ -2,6 +2,62 @@
 
 #include "toy_memory.h"
 
+#include <stdatomic.h>
+
+//scopes are numbered as they're created, so a cache can tell a scope apart from a newer one in the same memory
+static atomic_uint nextScopeId = 1;
+
+static void initScope(Toy_Scope* scope) {
+	Toy_initLiteralDictionary(&scope->variables);
+	Toy_initLiteralArray(&scope->slotNames);
+	scope->slots = NULL;
+	scope->slotCapacity = 0;
+	scope->slotCount = 0;
+	scope->declaredNames = 0;
+	scope->id = atomic_fetch_add_explicit(&nextScopeId, 1, memory_order_relaxed);
+}
+
+static void freeSlots(Toy_Scope* scope) {
+	for (int i = 0; i < scope->slotCount; i++) {
+		Toy_freeLiteral(scope->slots[i].value);
+		Toy_freeLiteral(scope->slots[i].type);
+	}
+
+	TOY_FREE_ARRAY(Toy_private_scope_slot, scope->slots, scope->slotCapacity);
+	Toy_freeLiteralArray(&scope->slotNames);
+	scope->slots = NULL;
+	scope->slotCapacity = 0;
+	scope->slotCount = 0;
+}
+
+//make room for "count" more slots, returning the index of the first
+static int pushSlots(Toy_Scope* scope, int count) {
+	if (scope->slotCount + count > scope->slotCapacity) {
+		int oldCapacity = scope->slotCapacity;
+
+		while (scope->slotCount + count > scope->slotCapacity) {
+			scope->slotCapacity = TOY_GROW_CAPACITY(scope->slotCapacity);
+		}
+
+		scope->slots = TOY_GROW_ARRAY(Toy_private_scope_slot, scope->slots, oldCapacity, scope->slotCapacity);
+	}
+
+	int first = scope->slotCount;
+
+	for (int i = first; i < first + count; i++) {
+		scope->slots[i].value = TOY_TO_NULL_LITERAL;
+		scope->slots[i].type = TOY_TO_NULL_LITERAL;
+	}
+
+	scope->slotCount += count;
+	return first;
+}
+
+static uint64_t nameBit(Toy_Literal key) {
+	unsigned int hash = TOY_IS_IDENTIFIER(key) ? (unsigned int)TOY_HASH_I(key) : (unsigned int)Toy_hashLiteral(key);
+	return (uint64_t)1 << (hash >> 26);
+}
+
 //run up the ancestor chain, freeing anything with 0 references left
 static void freeAncestorChain(Toy_Scope* scope) {
 	while (scope != NULL) {
@@ -11,7 +67,7 @@ static void freeAncestorChain(Toy_Scope* scope) {
 
 		if (scope->references <= 0) {
 			Toy_freeLiteralDictionary(&scope->variables);
-			Toy_freeLiteralDictionary(&scope->types);
+			freeSlots(scope);
 			TOY_FREE(Toy_Scope, scope);
 		}
 
@@ -19,6 +75,106 @@ static void freeAncestorChain(Toy_Scope* scope) {
 	}
 }
 
+//find a declared variable within this scope only, returning its index in slots
+static int findLocalVariable(Toy_Scope* scope, Toy_Literal key, uint64_t bit) {
+	if (!(scope->declaredNames & bit)) {
+		return -1;
+	}
+
+	//the compiler's slots are named here too, but may not be declared yet
+	Toy_Literal index = Toy_getLiteralDictionary(&scope->variables, key);
+
+	if (!TOY_IS_INTEGER(index) || TOY_IS_NULL(scope->slots[TOY_AS_INTEGER(index)].type)) {
+		return -1;
+	}
+
+	return TOY_AS_INTEGER(index);
+}
+
+//find the slot `depth` ancestors up, or NULL if it doesn't exist
+static Toy_private_scope_slot* getSlot(Toy_Scope* scope, int depth, int slot) {
+	while (scope != NULL && depth > 0) {
+		scope = scope->ancestor;
+		depth--;
+	}
+
+	if (scope == NULL || slot < 0 || slot >= scope->slotNames.count) {
+		return NULL;
+	}
+
+	return &scope->slots[slot];
+}
+
+//does the chain starting at scope pass through target?
+static bool chainContains(Toy_Scope* scope, Toy_Scope* target) {
+	for (Toy_Scope* ptr = scope; ptr != NULL; ptr = ptr->ancestor) {
+		if (ptr == target) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void copyContents(Toy_Scope* scope, Toy_Scope* original, Toy_Scope* from, Toy_Scope* to);
+
+//copy the scopes of a closure up to `from`, and continue the chain from `to` instead
+static Toy_Scope* forkChain(Toy_Scope* scope, Toy_Scope* from, Toy_Scope* to) {
+	if (!chainContains(scope, from)) {
+		return Toy_copyScope(scope);
+	}
+
+	if (scope == from) {
+		for (Toy_Scope* ptr = to; ptr != NULL; ptr = ptr->ancestor) {
+			ptr->references++;
+		}
+
+		return to;
+	}
+
+	Toy_Scope* fork = TOY_ALLOCATE(Toy_Scope, 1);
+	fork->ancestor = forkChain(scope->ancestor, from, to); //the ancestors have already counted this reference
+	fork->references = 1;
+
+	copyContents(fork, scope, from, to);
+
+	return fork;
+}
+
+//copy a literal, moving any closure over `from` onto `to`
+static Toy_Literal forkLiteral(Toy_Literal original, Toy_Scope* from, Toy_Scope* to) {
+	if (!TOY_IS_FUNCTION(original)) {
+		return Toy_copyLiteral(original);
+	}
+
+	Toy_Literal literal = TOY_TO_FUNCTION_LITERAL(Toy_copyRefFunction(TOY_AS_FUNCTION(original).inner.ptr));
+	TOY_AS_FUNCTION(literal).scope = forkChain(TOY_AS_FUNCTION(original).scope, from, to);
+
+	return literal;
+}
+
+//copy the variables and slots of one scope into another
+static void copyContents(Toy_Scope* scope, Toy_Scope* original, Toy_Scope* from, Toy_Scope* to) {
+	//the names are shared until either scope declares another variable
+	Toy_shareLiteralDictionary(&scope->variables, &original->variables);
+	Toy_shareLiteralArray(&scope->slotNames, &original->slotNames);
+	scope->slots = NULL;
+	scope->slotCapacity = 0;
+	scope->slotCount = 0;
+	scope->declaredNames = original->declaredNames;
+	scope->id = atomic_fetch_add_explicit(&nextScopeId, 1, memory_order_relaxed);
+
+	//functions own their closures, so the values are copied one at a time
+	if (original->slotCount > 0) {
+		pushSlots(scope, original->slotCount);
+
+		for (int i = 0; i < original->slotCount; i++) {
+			scope->slots[i].value = forkLiteral(original->slots[i].value, from, to);
+			scope->slots[i].type = Toy_copyLiteral(original->slots[i].type);
+		}
+	}
+}
+
 //return false if invalid type
 static bool checkType(Toy_Literal typeLiteral, Toy_Literal original, Toy_Literal value, bool constCheck) {
 	//for constants, fail if original != value
@@ -168,8 +324,7 @@ static bool checkType(Toy_Literal typeLiteral, Toy_Literal original, Toy_Literal
 Toy_Scope* Toy_pushScope(Toy_Scope* ancestor) {
 	Toy_Scope* scope = TOY_ALLOCATE(Toy_Scope, 1);
 	scope->ancestor = ancestor;
-	Toy_initLiteralDictionary(&scope->variables);
-	Toy_initLiteralDictionary(&scope->types);
+	initScope(scope);
 
 	//tick up all scope reference counts
 	scope->references = 0;
@@ -188,16 +343,10 @@ Toy_Scope* Toy_popScope(Toy_Scope* scope) {
 	Toy_Scope* ret = scope->ancestor;
 
 	//BUGFIX: when freeing a scope, free the functions' scopes manually - I *think* this is related to the closure hack-in
-	for (int i = 0; i < scope->variables.capacity; i++) {
-		//handle keys, just in case
-		if (TOY_IS_FUNCTION(scope->variables.entries[i].key)) {
-			Toy_popScope(TOY_AS_FUNCTION(scope->variables.entries[i].key).scope);
-			TOY_AS_FUNCTION(scope->variables.entries[i].key).scope = NULL;
-		}
-
-		if (TOY_IS_FUNCTION(scope->variables.entries[i].value)) {
-			Toy_popScope(TOY_AS_FUNCTION(scope->variables.entries[i].value).scope);
-			TOY_AS_FUNCTION(scope->variables.entries[i].value).scope = NULL;
+	for (int i = 0; i < scope->slotCount; i++) {
+		if (TOY_IS_FUNCTION(scope->slots[i].value)) {
+			Toy_popScope(TOY_AS_FUNCTION(scope->slots[i].value).scope);
+			TOY_AS_FUNCTION(scope->slots[i].value).scope = NULL;
 		}
 	}
 
@@ -213,8 +362,6 @@ Toy_Scope* Toy_copyScope(Toy_Scope* original) {
 
 	Toy_Scope* scope = TOY_ALLOCATE(Toy_Scope, 1);
 	scope->ancestor = original->ancestor;
-	Toy_initLiteralDictionary(&scope->variables);
-	Toy_initLiteralDictionary(&scope->types);
 
 	//tick up all scope reference counts
 	scope->references = 0;
@@ -222,105 +369,264 @@ Toy_Scope* Toy_copyScope(Toy_Scope* original) {
 		ptr->references++;
 	}
 
-	//copy the contents of the dictionaries
-	for (int i = 0; i < original->variables.capacity; i++) {
-		if (!TOY_IS_NULL(original->variables.entries[i].key)) {
-			Toy_setLiteralDictionary(&scope->variables, original->variables.entries[i].key, original->variables.entries[i].value);
-		}
+	copyContents(scope, original, NULL, NULL);
+
+	return scope;
+}
+
+Toy_Scope* Toy_forkScope(Toy_Scope* original) {
+	if (original == NULL) {
+		return NULL;
 	}
 
-	for (int i = 0; i < original->types.capacity; i++) {
-		if (!TOY_IS_NULL(original->types.entries[i].key)) {
-			Toy_setLiteralDictionary(&scope->types, original->types.entries[i].key, original->types.entries[i].value);
-		}
+	Toy_Scope* scope = TOY_ALLOCATE(Toy_Scope, 1);
+	scope->ancestor = original->ancestor;
+
+	//tick up all scope reference counts
+	scope->references = 0;
+	for (Toy_Scope* ptr = scope; ptr != NULL; ptr = ptr->ancestor) {
+		ptr->references++;
 	}
 
+	//closures over the original are moved onto the fork
+	copyContents(scope, original, original, scope);
+
 	return scope;
 }
 
 //returns false if error
 bool Toy_declareScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal type) {
-	//don't redefine a variable within this scope
-	if (Toy_existsLiteralDictionary(&scope->variables, key)) {
-		return false;
+	Toy_Literal index = Toy_getLiteralDictionary(&scope->variables, key);
+
+	//the compiler may have set aside a slot for this, otherwise don't redefine a variable within this scope
+	if (TOY_IS_INTEGER(index)) {
+		return TOY_AS_INTEGER(index) < scope->slotNames.count && Toy_declareScopeSlot(scope, TOY_AS_INTEGER(index), type);
 	}
 
 	if (!TOY_IS_TYPE(type)) {
 		return false;
 	}
 
-	//store the type, for later checking on assignment
-	Toy_setLiteralDictionary(&scope->types, key, type);
+	//store the type alongside the value, for later checking on assignment
+	int slot = pushSlots(scope, 1);
+	scope->slots[slot].type = Toy_copyLiteral(type);
 
-	Toy_setLiteralDictionary(&scope->variables, key, TOY_TO_NULL_LITERAL);
+	Toy_setLiteralDictionary(&scope->variables, key, TOY_TO_INTEGER_LITERAL(slot));
+	scope->declaredNames |= nameBit(key);
 	return true;
 }
 
 bool Toy_isDeclaredScopeVariable(Toy_Scope* scope, Toy_Literal key) {
-	while (scope != NULL) {
-		if (Toy_existsLiteralDictionary(&scope->variables, key)) {
-			return true;
-		}
+	return Toy_private_findScopeVariable(scope, key, NULL) != NULL;
+}
 
-		scope = scope->ancestor;
+//return false if undefined, or can't be assigned
+bool Toy_setScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal value, bool constCheck) {
+	Toy_private_scope_slot* slot = Toy_private_findScopeVariable(scope, key, NULL);
+
+	if (slot == NULL) {
+		return false;
 	}
 
-	return false;
+	return Toy_private_setScopeSlotValue(slot, value, constCheck);
 }
 
-//return false if undefined, or can't be assigned
-bool Toy_setScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal value, bool constCheck) {
-	while (scope != NULL) {
-		//if it's not in this scope, keep searching up the chain
-		if (!Toy_existsLiteralDictionary(&scope->variables, key)) {
-			scope = scope->ancestor;
-			continue;
-		}
+bool Toy_getScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal* valueHandle) {
+	Toy_private_scope_slot* slot = Toy_private_findScopeVariable(scope, key, NULL);
 
-		//type checking
-		Toy_Literal typeLiteral = Toy_getLiteralDictionary(&scope->types, key);
-		Toy_Literal original = Toy_getLiteralDictionary(&scope->variables, key);
+	if (slot == NULL) {
+		return false;
+	}
 
-		if (!checkType(typeLiteral, original, value, constCheck)) {
-			Toy_freeLiteral(typeLiteral);
-			Toy_freeLiteral(original);
-			return false;
+	*valueHandle = Toy_copyLiteral(slot->value);
+	return true;
+}
+
+Toy_Literal Toy_getScopeType(Toy_Scope* scope, Toy_Literal key) {
+	Toy_private_scope_slot* slot = Toy_private_findScopeVariable(scope, key, NULL);
+
+	if (slot == NULL) {
+		return TOY_TO_NULL_LITERAL;
+	}
+
+	return Toy_copyLiteral(slot->type);
+}
+
+void Toy_setScopeSlots(Toy_Scope* scope, Toy_LiteralArray* names, Toy_LiteralDictionary* lookup) {
+	if (scope->slotNames.count > 0 || names->count == 0) {
+		return;
+	}
+
+	//the names are shared with the literal cache
+	Toy_shareLiteralArray(&scope->slotNames, names);
+
+	int named = scope->slotCount;
+	pushSlots(scope, names->count);
+
+	//the slots are named alongside the variables, so one lookup finds either
+	if (named == 0) {
+		Toy_freeLiteralDictionary(&scope->variables);
+		Toy_shareLiteralDictionary(&scope->variables, lookup);
+		return;
+	}
+
+	//the compiler's slots go first, so move any variables declared before now out of the way
+	for (int i = named - 1; i >= 0; i--) {
+		scope->slots[i + names->count] = scope->slots[i];
+		scope->slots[i].value = TOY_TO_NULL_LITERAL;
+		scope->slots[i].type = TOY_TO_NULL_LITERAL;
+	}
+
+	Toy_unshareLiteralDictionary(&scope->variables);
+
+	for (int i = 0; i < scope->variables.capacity; i++) {
+		if (!TOY_IS_NULL(scope->variables.entries[i].key)) {
+			scope->variables.entries[i].value = TOY_TO_INTEGER_LITERAL(TOY_AS_INTEGER(scope->variables.entries[i].value) + names->count);
+		}
+	}
+
+	//a variable already declared keeps its name (the compiler never gives it a slot as well)
+	for (int i = 0; i < names->count; i++) {
+		if (!Toy_existsLiteralDictionary(&scope->variables, names->literals[i])) {
+			Toy_setLiteralDictionary(&scope->variables, names->literals[i], TOY_TO_INTEGER_LITERAL(i));
 		}
+	}
 
-		//actually assign
-		Toy_setLiteralDictionary(&scope->variables, key, value); //key & value are copied here
+	//any cached indexes are out of date
+	scope->id = atomic_fetch_add_explicit(&nextScopeId, 1, memory_order_relaxed);
+}
 
-		Toy_freeLiteral(typeLiteral);
-		Toy_freeLiteral(original);
+bool Toy_declareScopeSlot(Toy_Scope* scope, int slot, Toy_Literal type) {
+	Toy_private_scope_slot* ptr = getSlot(scope, 0, slot);
 
-		return true;
+	//don't redefine a variable within this scope
+	if (ptr == NULL || !TOY_IS_NULL(ptr->type)) {
+		return false;
 	}
 
-	return false;
+	if (!TOY_IS_TYPE(type)) {
+		return false;
+	}
+
+	ptr->type = Toy_copyLiteral(type);
+	scope->declaredNames |= nameBit(scope->slotNames.literals[slot]);
+	return true;
 }
 
-bool Toy_getScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal* valueHandle) {
-	//optimized to reduce call stack
-	while (scope != NULL) {
-		if (Toy_existsLiteralDictionary(&scope->variables, key)) {
-			*valueHandle = Toy_getLiteralDictionary(&scope->variables, key);
-			return true;
-		}
+bool Toy_setScopeSlot(Toy_Scope* scope, int depth, int slot, Toy_Literal value, bool constCheck) {
+	Toy_private_scope_slot* ptr = getSlot(scope, depth, slot);
+
+	if (ptr == NULL) {
+		return false;
+	}
 
+	return Toy_private_setScopeSlotValue(ptr, value, constCheck);
+}
+
+bool Toy_getScopeSlot(Toy_Scope* scope, int depth, int slot, Toy_Literal* valueHandle) {
+	Toy_private_scope_slot* ptr = getSlot(scope, depth, slot);
+
+	if (ptr == NULL || TOY_IS_NULL(ptr->type)) {
+		return false;
+	}
+
+	*valueHandle = Toy_copyLiteral(ptr->value);
+	return true;
+}
+
+Toy_Literal Toy_getScopeSlotType(Toy_Scope* scope, int depth, int slot) {
+	Toy_private_scope_slot* ptr = getSlot(scope, depth, slot);
+
+	if (ptr == NULL) {
+		return TOY_TO_NULL_LITERAL;
+	}
+
+	return Toy_copyLiteral(ptr->type);
+}
+
+Toy_Literal Toy_getScopeSlotName(Toy_Scope* scope, int depth, int slot) {
+	while (scope != NULL && depth > 0) {
 		scope = scope->ancestor;
+		depth--;
 	}
 
-	return false;
+	if (scope == NULL || slot < 0 || slot >= scope->slotNames.count) {
+		return TOY_TO_NULL_LITERAL;
+	}
+
+	return Toy_copyLiteral(scope->slotNames.literals[slot]);
 }
 
-Toy_Literal Toy_getScopeType(Toy_Scope* scope, Toy_Literal key) {
-	while (scope != NULL) {
-		if (Toy_existsLiteralDictionary(&scope->types, key)) {
-			return Toy_getLiteralDictionary(&scope->types, key);
+Toy_private_scope_slot* Toy_private_findScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_private_scope_cache* cache) {
+	const uint64_t bit = nameBit(key);
+
+	//only identifiers are cached - they're interned, so the same name is always the same refstring
+	if (!TOY_IS_IDENTIFIER(key)) {
+		cache = NULL;
+	}
+
+	//the cached variable is still visible, unless a scope on the way to it may have declared the same name since
+	if (cache != NULL && TOY_IS_IDENTIFIER(cache->name) && TOY_AS_IDENTIFIER(cache->name) == TOY_AS_IDENTIFIER(key)) {
+		for (Toy_Scope* ptr = scope; ptr != NULL; ptr = ptr->ancestor) {
+			if (ptr == cache->scope && ptr->id == cache->id) {
+				return &ptr->slots[cache->slot];
+			}
+
+			if (ptr->declaredNames & bit) {
+				break;
+			}
 		}
+	}
 
-		scope = scope->ancestor;
+	//search each scope in turn
+	for (Toy_Scope* ptr = scope; ptr != NULL; ptr = ptr->ancestor) {
+		int slot = findLocalVariable(ptr, key, bit);
+
+		if (slot < 0) {
+			continue;
+		}
+
+		if (cache != NULL) {
+			if (!TOY_IS_IDENTIFIER(cache->name) || TOY_AS_IDENTIFIER(cache->name) != TOY_AS_IDENTIFIER(key)) {
+				Toy_freeLiteral(cache->name);
+				cache->name = Toy_copyLiteral(key);
+			}
+
+			cache->scope = ptr;
+			cache->id = ptr->id;
+			cache->slot = slot;
+		}
+
+		return &ptr->slots[slot];
+	}
+
+	return NULL;
+}
+
+bool Toy_private_setScopeSlotValue(Toy_private_scope_slot* slot, Toy_Literal value, bool constCheck) {
+	//undeclared slots have no type
+	if (TOY_IS_NULL(slot->type)) {
+		return false;
+	}
+
+	//type checking
+	if (!checkType(slot->type, slot->value, value, constCheck)) {
+		return false;
 	}
 
-	return TOY_TO_NULL_LITERAL;
+	//actually assign
+	Toy_freeLiteral(slot->value);
+	slot->value = Toy_copyLiteral(value);
+
+	return true;
+}
+
+void Toy_private_freeScopeCache(Toy_private_scope_cache* cache, int count) {
+	for (int i = 0; i < count; i++) {
+		Toy_freeLiteral(cache[i].name);
+		cache[i].name = TOY_TO_NULL_LITERAL;
+		cache[i].scope = NULL;
+		cache[i].id = 0;
+		cache[i].slot = -1;
+	}
 }
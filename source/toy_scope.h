@@ -7,6 +7,10 @@ This header defines the scope structure, which stores all of the variables used
 
 Scopes are arranged into a linked list of ancestors, each of which is reference counted. When a scope is popped off the end of the chain, every ancestor scope has it's reference counter reduced by 1 and, if any reach 0, they are freed.
 
+Local variables can also be resolved to numbered slots by the compiler. Each scope can hold a flat array of these slots, which are accessed by their index and the number of ancestors to skip, rather than being looked up by name. Slots are still visible to the name-based functions, so native functions and closures can find them as normal.
+
+Every other variable is kept in the same array, after the compiler's slots, so a variable's value and type are stored together - the `variables` dictionary only maps each name to its index. Looking a variable up by name takes a single probe of each scope's dictionary, and each scope also remembers a bit for every name declared within it, so scopes that can't hold a variable are skipped without a probe at all.
+
 This is also where Toy's type system lives.
 !*/
 
@@ -14,13 +18,32 @@ This is also where Toy's type system lives.
 #include "toy_literal_array.h"
 #include "toy_literal_dictionary.h"
 
+//the type is null until the slot's variable is declared
+typedef struct Toy_private_scope_slot {
+	Toy_Literal value;
+	Toy_Literal type;
+} Toy_private_scope_slot;
+
 typedef struct Toy_Scope {
-	Toy_LiteralDictionary variables; //only allow identifiers as the keys
-	Toy_LiteralDictionary types; //the types, indexed by identifiers
+	Toy_LiteralDictionary variables; //maps identifiers to their index in slots, declared or not
+	Toy_LiteralArray slotNames; //the identifiers of each slot, set by the compiler
+	Toy_private_scope_slot* slots; //the compiler's slots, followed by every other variable
+	int slotCapacity;
+	int slotCount;
+	uint64_t declaredNames; //a bit for each declared identifier, taken from its hash
+	unsigned int id; //unique to this scope, as the memory of a freed scope may be reused
 	struct Toy_Scope* ancestor;
 	int references; //how many scopes point here
 } Toy_Scope;
 
+//where an identifier was last found, so it can be found again without searching each scope
+typedef struct Toy_private_scope_cache {
+	Toy_Literal name;
+	Toy_Scope* scope;
+	unsigned int id;
+	int slot;
+} Toy_private_scope_cache;
+
 /*!
 ## Defined Functions
 !*/
@@ -44,10 +67,19 @@ TOY_API Toy_Scope* Toy_popScope(Toy_Scope* scope);
 
 This function copies an existing scope, and returns the copy.
 
-This copies the internal dictionaries, so it can be memory intensive.
+The internal dictionaries are shared with `original` until either scope writes to them, but any functions declared within are copied along with their closures.
 !*/
 TOY_API Toy_Scope* Toy_copyScope(Toy_Scope* original);
 
+/*!
+### Toy_Scope* Toy_forkScope(Toy_Scope* original)
+
+This function copies an existing scope, like `Toy_copyScope()`, except that functions declared within `original` are rebound to the copy - when called, they'll see the copy's variables instead of the original's. Either scope can be freed first.
+
+This is used to fork interpreters, see `Toy_forkInterpreter()`.
+!*/
+TOY_API Toy_Scope* Toy_forkScope(Toy_Scope* original);
+
 /*!
 ### bool Toy_declareScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal type)
 
@@ -88,3 +120,80 @@ TOY_API bool Toy_getScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_Literal
 This function returns a new `Toy_Literal` representing the type of the variable named `key`.
 !*/
 TOY_API Toy_Literal Toy_getScopeType(Toy_Scope* scope, Toy_Literal key);
+
+/*!
+### void Toy_setScopeSlots(Toy_Scope* scope, Toy_LiteralArray* names, Toy_LiteralDictionary* lookup)
+
+This function gives `scope` one slot for each identifier in `names`. `lookup` maps each of those identifiers to its index in `names`, and is shared with `scope` so its variables can be found by name. This can only be done once, before any slots are declared.
+!*/
+TOY_API void Toy_setScopeSlots(Toy_Scope* scope, Toy_LiteralArray* names, Toy_LiteralDictionary* lookup);
+
+/*!
+### bool Toy_declareScopeSlot(Toy_Scope* scope, int slot, Toy_Literal type)
+
+This function declares the variable held in `slot` of `scope`, giving it the type of `type`.
+
+This function returns true on success, otherwise it returns false (such as if the slot is already declared).
+!*/
+TOY_API bool Toy_declareScopeSlot(Toy_Scope* scope, int slot, Toy_Literal type);
+
+/*!
+### bool Toy_setScopeSlot(Toy_Scope* scope, int depth, int slot, Toy_Literal value, bool constCheck)
+
+This function sets the variable held in `slot` of the scope `depth` ancestors above `scope`, following the same rules as `Toy_setScopeVariable()`.
+
+This function returns true on success, otherwise it returns false.
+!*/
+TOY_API bool Toy_setScopeSlot(Toy_Scope* scope, int depth, int slot, Toy_Literal value, bool constCheck);
+
+/*!
+### bool Toy_getScopeSlot(Toy_Scope* scope, int depth, int slot, Toy_Literal* value)
+
+This function sets the literal pointed to by `value` to equal the variable held in `slot` of the scope `depth` ancestors above `scope`.
+
+This function returns true on success, otherwise it returns false (such as if the slot hasn't been declared yet).
+!*/
+TOY_API bool Toy_getScopeSlot(Toy_Scope* scope, int depth, int slot, Toy_Literal* value);
+
+/*!
+### Toy_Literal Toy_getScopeSlotType(Toy_Scope* scope, int depth, int slot)
+
+This function returns a new `Toy_Literal` representing the type of the variable held in `slot` of the scope `depth` ancestors above `scope`. This is null if the slot hasn't been declared yet.
+!*/
+TOY_API Toy_Literal Toy_getScopeSlotType(Toy_Scope* scope, int depth, int slot);
+
+/*!
+### Toy_Literal Toy_getScopeSlotName(Toy_Scope* scope, int depth, int slot)
+
+This function returns a new `Toy_Literal` representing the identifier of `slot` in the scope `depth` ancestors above `scope`, or null if there is no such slot.
+!*/
+TOY_API Toy_Literal Toy_getScopeSlotName(Toy_Scope* scope, int depth, int slot);
+
+/*!
+### Toy_private_scope_slot* Toy_private_findScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_private_scope_cache* cache)
+
+This function returns the storage of the declared variable named `key`, searching up the ancestor chain from `scope`, or `NULL` if it isn't declared. The pointer is only valid until another variable is declared within the same scope.
+
+If `cache` isn't `NULL`, it's checked first, and then updated with wherever the variable was found. A cached variable is used only if it can still be seen from `scope` - every scope on the way there is checked, without any hashing, for a declaration that might hide it.
+
+Private functions are not intended for general use.
+!*/
+TOY_API Toy_private_scope_slot* Toy_private_findScopeVariable(Toy_Scope* scope, Toy_Literal key, Toy_private_scope_cache* cache);
+
+/*!
+### bool Toy_private_setScopeSlotValue(Toy_private_scope_slot* slot, Toy_Literal value, bool constCheck)
+
+This function sets the variable stored in `slot`, following the same rules as `Toy_setScopeVariable()`.
+
+Private functions are not intended for general use.
+!*/
+TOY_API bool Toy_private_setScopeSlotValue(Toy_private_scope_slot* slot, Toy_Literal value, bool constCheck);
+
+/*!
+### void Toy_private_freeScopeCache(Toy_private_scope_cache* cache, int count)
+
+This function releases the names held by an array of `count` caches, and clears them.
+
+Private functions are not intended for general use.
+!*/
+TOY_API void Toy_private_freeScopeCache(Toy_private_scope_cache* cache, int count);
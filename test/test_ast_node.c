@@ -21,7 +21,7 @@ int main() {
 
 		//generate the node
 		Toy_ASTNode* node = NULL;
-		Toy_emitASTNodeLiteral(&node, literal);
+		Toy_emitASTNodeLiteral(NULL, &node, literal);
 
 		//check node type
 		ASSERT(node->type == TOY_AST_NODE_LITERAL);
@@ -37,11 +37,11 @@ int main() {
 		char* str = "foobar";
 		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 		Toy_ASTNode* childNode = NULL;
-		Toy_emitASTNodeLiteral(&childNode, literal);
+		Toy_emitASTNodeLiteral(NULL, &childNode, literal);
 
 		//generate the unary node
 		Toy_ASTNode* unary = NULL;
-		Toy_emitASTNodeUnary(&unary, TOY_OP_PRINT, childNode);
+		Toy_emitASTNodeUnary(NULL, &unary, TOY_OP_PRINT, childNode);
 
 		//check node type
 		ASSERT(unary->type == TOY_AST_NODE_UNARY);
@@ -57,13 +57,13 @@ int main() {
 		char* str = "foobar";
 		Toy_Literal literal = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 		Toy_ASTNode* nodeHandle = NULL;
-		Toy_emitASTNodeLiteral(&nodeHandle, literal);
+		Toy_emitASTNodeLiteral(NULL, &nodeHandle, literal);
 
 		Toy_ASTNode* rhsChildNode = NULL;
-		Toy_emitASTNodeLiteral(&rhsChildNode, literal);
+		Toy_emitASTNodeLiteral(NULL, &rhsChildNode, literal);
 
 		//generate the unary node
-		Toy_emitASTNodeBinary(&nodeHandle, rhsChildNode, TOY_OP_PRINT);
+		Toy_emitASTNodeBinary(NULL, &nodeHandle, rhsChildNode, TOY_OP_PRINT);
 
 		//check node type
 		ASSERT(nodeHandle->type == TOY_AST_NODE_BINARY);
@@ -89,16 +89,16 @@ int main() {
 		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString(idn));
 		Toy_Literal string = TOY_TO_STRING_LITERAL(Toy_createRefString(str));
 
-		Toy_emitASTNodeCompound(&dictionary, TOY_LITERAL_DICTIONARY);
-		Toy_emitASTNodeLiteral(&left, identifier);
-		Toy_emitASTNodeLiteral(&right, string);
+		Toy_emitASTNodeCompound(NULL, &dictionary, TOY_LITERAL_DICTIONARY);
+		Toy_emitASTNodeLiteral(NULL, &left, identifier);
+		Toy_emitASTNodeLiteral(NULL, &right, string);
 
 		//grow the node if needed
 		if (dictionary->compound.capacity < dictionary->compound.count + 1) {
 			int oldCapacity = dictionary->compound.capacity;
 
 			dictionary->compound.capacity = TOY_GROW_CAPACITY(oldCapacity);
-			dictionary->compound.nodes = TOY_GROW_ARRAY(Toy_ASTNode, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
+			dictionary->compound.nodes = Toy_private_growASTNodes(NULL, dictionary->compound.nodes, oldCapacity, dictionary->compound.capacity);
 		}
 
 		//store the left and right in the node
@@ -110,6 +110,49 @@ int main() {
 		Toy_freeLiteral(string);
 	}
 
+	//test arenas
+	{
+		Toy_ASTArena arena;
+		Toy_initASTArena(&arena);
+
+		Toy_Literal string = TOY_TO_STRING_LITERAL(Toy_createRefString("foobar"));
+
+		for (int round = 0; round < 3; round++) {
+			//a block large enough to need several chunks
+			Toy_ASTNode* block = NULL;
+			Toy_emitASTNodeBlock(&arena, &block);
+
+			for (int i = 0; i < 1000; i++) {
+				if (block->block.capacity < block->block.count + 1) {
+					int oldCapacity = block->block.capacity;
+
+					block->block.capacity = TOY_GROW_CAPACITY(oldCapacity);
+					block->block.nodes = Toy_private_growASTNodes(&arena, block->block.nodes, oldCapacity, block->block.capacity);
+				}
+
+				Toy_ASTNode* node = NULL;
+				Toy_emitASTNodeLiteral(&arena, &node, string);
+				block->block.nodes[block->block.count++] = *node;
+				Toy_private_freeASTNodes(node, 1);
+			}
+
+			ASSERT(block->block.count == 1000);
+			ASSERT(arena.chunks != NULL && arena.chunks->next != NULL);
+
+			//the literals are released, and the memory goes with the arena
+			Toy_freeASTNode(block);
+			Toy_clearASTArena(&arena);
+
+			ASSERT(arena.chunks->next == NULL && arena.chunks->count == 0);
+		}
+
+		//only the original reference is left
+		ASSERT(Toy_countRefString(TOY_AS_STRING(string)) == 1);
+
+		Toy_freeLiteral(string);
+		Toy_freeASTArena(&arena);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -88,6 +88,49 @@ int main() {
 		Toy_freeCompiler(&compiler);
 	}
 
+	{
+		//source, with enough repeated literals to grow the literal index several times
+		char* source = malloc(64 * 1000);
+		int length = 0;
+
+		for (int i = 0; i < 1000; i++) {
+			length += sprintf(source + length, "var v%d: int = %d; v%d = %d.5; print \"s%d\";\n", i, i % 100, i / 2, i % 50, i % 200);
+		}
+
+		//test literal deduplication
+		Toy_Lexer lexer;
+		Toy_Parser parser;
+		Toy_Compiler compiler;
+
+		Toy_initLexer(&lexer, source);
+		Toy_initParser(&parser, &lexer);
+		Toy_initCompiler(&compiler);
+
+		Toy_ASTNode* node = Toy_scanParser(&parser);
+		while (node != NULL) {
+			if (node->type == TOY_AST_NODE_ERROR) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Error node found" TOY_CC_RESET);
+				return -1;
+			}
+
+			Toy_writeCompiler(&compiler, node);
+			Toy_freeASTNode(node);
+
+			node = Toy_scanParser(&parser);
+		}
+
+		//1000 identifiers, 100 integers, 50 floats, 200 strings and 1 type
+		if (compiler.literalCache.count != 1351) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Unexpected literal cache size %d\n" TOY_CC_RESET, compiler.literalCache.count);
+			return -1;
+		}
+
+		//cleanup
+		free(source);
+		Toy_freeParser(&parser);
+		Toy_freeCompiler(&compiler);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
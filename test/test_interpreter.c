@@ -18,6 +18,12 @@ static void noPrintFn(const char* output) {
 	//NO OP
 }
 
+//count the print output, to check a script ran to the end
+int printCount = 0;
+static void countPrintFn(const char* output) {
+	printCount++;
+}
+
 int failedAssertions = 0;
 int ignoredAssertions = 0;
 static void noAssertFn(const char* output) {
@@ -114,6 +120,10 @@ int main() {
 			"casting.toy",
 			"coercions.toy",
 			"comparisons.toy",
+			"compound-copies.toy",
+			"constant-folding.toy",
+			"local-slots.toy",
+			"call-frames.toy",
 			"dot-and-matrix.toy",
 			"dot-assignments-bugfix.toy",
 			"dot-chaining.toy",
@@ -136,30 +146,278 @@ int main() {
 			"long-array.toy",
 			"long-dictionary.toy",
 			"long-literals.toy",
+			"long-strings.toy",
 			"native-functions.toy",
 			"or-chaining-bugfix.toy",
 			"panic-within-functions.toy",
 			"polyfill-insert.toy",
 			"polyfill-remove.toy",
+			"quickening.toy",
 			"short-circuit.toy",
+			"string-append.toy",
+			"superinstructions.toy",
 			"ternary-expressions.toy",
 			"trailing-comma-bugfix.toy",
 			"types.toy",
 			NULL
 		};
 
-		for (int i = 0; filenames[i]; i++) {
-			printf("Running %s\n", filenames[i]);
+		//and again, with the optimizer enabled
+		for (int optimize = 0; optimize < 2; optimize++) {
+			Toy_setBytecodeOptimization(optimize);
 
-			char buffer[128];
-			snprintf(buffer, 128, "scripts/%s", filenames[i]);
+			for (int i = 0; filenames[i]; i++) {
+				printf("Running %s%s\n", filenames[i], optimize ? " (optimized)" : "");
 
-			runSourceFileCustom(buffer);
+				char buffer[128];
+				snprintf(buffer, 128, "scripts/%s", filenames[i]);
+
+				runSourceFileCustom(buffer);
+			}
 		}
+
+		Toy_setBytecodeOptimization(false);
+	}
+
+	{
+		//source, with more than 65536 literals and jumps across more than 64KB of code, both at the top level and within a function
+		const int lines = 70000;
+		char* source = malloc(lines * 64 + 2048);
+		int length = 0;
+
+		length += sprintf(source + length, "var total: int = 0;\nfn wide(x: int) {\n\tvar t: int = 0;\n\tfn narrow() { return x > 0 ? 1 : 2; }\n\tif (x > 0 && narrow() == 1) {\n");
+		for (int i = 0; i < lines / 4; i++) {
+			length += sprintf(source + length, "\t\tt = t + %d - %d + 1;\n", i, i);
+		}
+		length += sprintf(source + length, "\t}\n\treturn t;\n}\nfor (var loops: int = 0; loops < 3; loops++) {\n\tif (loops == 0 || false) {\n\t\tcontinue;\n\t}\n");
+		for (int i = 0; i < lines; i++) {
+			length += sprintf(source + length, "\ttotal = total + %d - %d + 1;\n", i, i);
+		}
+		length += sprintf(source + length, "\tbreak;\n}\nassert total == %d, \"wide jumps failed\";\nassert wide(1) == %d, \"wide function failed\";\nprint \"done\";\n", lines, lines / 4);
+
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString(source, &size);
+		free(source);
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, countPrintFn);
+		Toy_setInterpreterAssert(&interpreter, noAssertFn);
+
+		Toy_runInterpreter(&interpreter, tb, size);
+		Toy_freeInterpreter(&interpreter);
+
+		//a broken jump can stop the script before the assertions
+		if (printCount != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Wide script didn't run to the end\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//borrowed bytecode can be run repeatedly, and is never written to
+		const char* source =
+			"fn sum(n: int) {\n"
+			"	var t: int = 0;\n"
+			"	for (var i: int = 0; i < n; i++) {\n"
+			"		t = t + i;\n"
+			"	}\n"
+			"	return t;\n"
+			"}\n"
+			"var total: int = 0;\n"
+			"for (var i: int = 0; i < 100; i++) {\n"
+			"	total = total + i * 2;\n"
+			"}\n"
+			"assert total == 9900 && sum(100) == 4950, \"borrowed bytecode failed\";\n"
+			"print \"done\";\n";
+
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString(source, &size);
+
+		unsigned char* original = malloc(size);
+		memcpy(original, tb, size);
+
+		Toy_Bytecode bytecode;
+		Toy_initBytecode(&bytecode, tb, size);
+
+		printCount = 0;
+
+		for (int i = 0; i < 4; i++) {
+			Toy_Interpreter interpreter;
+			Toy_initInterpreter(&interpreter);
+			Toy_setInterpreterPrint(&interpreter, countPrintFn);
+			Toy_setInterpreterAssert(&interpreter, noAssertFn);
+
+			Toy_runInterpreterBytecode(&interpreter, &bytecode);
+
+			//the same interpreter can run it again, like the repl
+			if (i % 2 == 0) {
+				Toy_resetInterpreter(&interpreter);
+				Toy_runInterpreterBytecode(&interpreter, &bytecode);
+			}
+
+			Toy_freeInterpreter(&interpreter);
+
+			if (bytecode.codeStart < 0) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Borrowed bytecode wasn't decoded\n" TOY_CC_RESET);
+				return -1;
+			}
+		}
+
+		Toy_freeBytecode(&bytecode);
+
+		if (printCount != 6 || memcmp(original, tb, size) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Borrowed bytecode was run incorrectly, or modified\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		free(original);
+		free((void*)tb);
+	}
+
+	{
+		//mapped bytecode files can be quickened without changing the file
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString("var total: int = 0;\nfor (var i: int = 0; i < 10; i++) {\n	total = total + i;\n}\nassert total == 45, \"mapped bytecode failed\";\nprint \"done\";\n", &size);
+
+		if (!tb || Toy_writeFile("mapped.tb", tb, size) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to write the mapped bytecode file\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		size_t mappedSize = 0;
+		const unsigned char* mapped = Toy_mapFile("mapped.tb", &mappedSize);
+
+		if (!mapped || mappedSize != size || memcmp(mapped, tb, size) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to map the bytecode file\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_Bytecode bytecode;
+		Toy_initBytecode(&bytecode, mapped, mappedSize);
+		bytecode.writable = true;
+
+		printCount = 0;
+
+		for (int i = 0; i < 2; i++) {
+			Toy_Interpreter interpreter;
+			Toy_initInterpreter(&interpreter);
+			Toy_setInterpreterPrint(&interpreter, countPrintFn);
+			Toy_setInterpreterAssert(&interpreter, noAssertFn);
+
+			Toy_runInterpreterBytecode(&interpreter, &bytecode);
+			Toy_freeInterpreter(&interpreter);
+		}
+
+		Toy_freeBytecode(&bytecode);
+
+		//the writes (if any) went to a private copy
+		size_t fileSize = 0;
+		const unsigned char* file = Toy_readFile("mapped.tb", &fileSize);
+
+		if (printCount != 2 || !file || fileSize != size || memcmp(file, tb, size) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Mapped bytecode was run incorrectly, or the file was modified\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_unmapFile(mapped, mappedSize);
+		free((void*)file);
+		free((void*)tb);
+		remove("mapped.tb");
+	}
+
+	{
+		//the second compile of the same source is read from the bytecode cache
+		const char* source = "var cached: int = 40 + 2;\nassert cached == 42, \"cached bytecode failed\";\n";
+		char path[256];
+
+		Toy_setBytecodeCacheDirectory(".");
+
+		if (!Toy_getBytecodeCachePath(source, path, sizeof(path))) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to find the bytecode cache path\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		remove(path);
+
+		size_t missSize = 0;
+		const unsigned char* miss = Toy_compileStringCached(source, &missSize);
+		Toy_BytecodeCacheStats stats = Toy_getBytecodeCacheStats();
+
+		if (!miss || stats.hits != 0 || stats.misses != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Expected a bytecode cache miss\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		size_t hitSize = 0;
+		const unsigned char* hit = Toy_compileStringCached(source, &hitSize);
+		stats = Toy_getBytecodeCacheStats();
+
+		if (!hit || stats.hits != 1 || stats.misses != 1 || hitSize != missSize || memcmp(hit, miss, missSize) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Expected a bytecode cache hit, with the same bytecode\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//a different source has a different entry
+		char otherPath[256];
+		Toy_getBytecodeCachePath("var cached: int = 40 + 3;\n", otherPath, sizeof(otherPath));
+
+		if (strcmp(path, otherPath) == 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Different sources share a bytecode cache entry\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterAssert(&interpreter, noAssertFn);
+		Toy_runInterpreter(&interpreter, hit, hitSize);
+		Toy_freeInterpreter(&interpreter);
+
+		free((void*)miss);
+		remove(path);
+		Toy_setBytecodeCacheDirectory(NULL);
+	}
+
+	{
+		//the optimizer makes the bytecode smaller, without changing what it does
+		size_t sourceLength = 0;
+		const char* source = (const char*)Toy_readFile("scripts/superinstructions.toy", &sourceLength);
+
+		size_t plainSize = 0;
+		const unsigned char* plain = Toy_compileString(source, &plainSize);
+
+		Toy_setBytecodeOptimization(true);
+		size_t optimizedSize = 0;
+		const unsigned char* optimized = Toy_compileString(source, &optimizedSize);
+		Toy_setBytecodeOptimization(false);
+
+		free((void*)source);
+
+		if (!plain || !optimized || optimizedSize >= plainSize) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Optimized bytecode isn't smaller (%d >= %d bytes)\n" TOY_CC_RESET, (int)optimizedSize, (int)plainSize);
+			return -1;
+		}
+
+		printCount = 0;
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, countPrintFn);
+		Toy_setInterpreterAssert(&interpreter, noAssertFn);
+
+		Toy_runInterpreter(&interpreter, optimized, optimizedSize);
+		Toy_freeInterpreter(&interpreter);
+
+		if (printCount != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Optimized script didn't run to the end\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		free((void*)plain);
 	}
 
-	//1, to allow for the assertion test
-	if (ignoredAssertions > 1) {
+	//2, to allow for the assertion test, with and without the optimizer
+	if (ignoredAssertions > 2) {
 		fprintf(stderr, TOY_CC_ERROR "Assertions hidden: %d\n", ignoredAssertions);
 		return -1;
 	}
@@ -0,0 +1,134 @@
+#include "toy_interpreter.h"
+#include "toy_interpreter_pool.h"
+
+#include "toy_console_colors.h"
+
+#include "toy_memory.h"
+
+#include "../repl/repl_tools.h"
+#include "../repl/lib_standard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int failedAssertions = 0;
+static void countAssertFn(const char* output) {
+	fprintf(stderr, TOY_CC_ERROR "Assertion failure: %s\n" TOY_CC_RESET, output);
+	failedAssertions++;
+}
+
+//call handle(index), and check the greeting it returns
+static bool handleRequest(Toy_Interpreter* interpreter, int index, const char* expected) {
+	Toy_LiteralArray arguments;
+	Toy_initLiteralArray(&arguments);
+	Toy_LiteralArray returns;
+	Toy_initLiteralArray(&returns);
+
+	Toy_pushLiteralArray(&arguments, TOY_TO_INTEGER_LITERAL(index));
+
+	bool result = Toy_callFn(interpreter, "handle", &arguments, &returns) &&
+		returns.count == 1 &&
+		TOY_IS_STRING(returns.literals[0]) &&
+		strcmp(Toy_toCString(TOY_AS_STRING(returns.literals[0])), expected) == 0;
+
+	Toy_freeLiteralArray(&arguments);
+	Toy_freeLiteralArray(&returns);
+
+	return result;
+}
+
+//read an integer from the global scope
+static int getGlobalInteger(Toy_Interpreter* interpreter, const char* name) {
+	Toy_Literal key = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString(name));
+	Toy_Literal value = TOY_TO_NULL_LITERAL;
+
+	Toy_getScopeVariable(interpreter->scope, key, &value);
+	int result = TOY_IS_INTEGER(value) ? TOY_AS_INTEGER(value) : -1;
+
+	Toy_freeLiteral(key);
+	Toy_freeLiteral(value);
+
+	return result;
+}
+
+int main() {
+	{
+		//set up the snapshot
+		size_t size = 0;
+		const char* source = (const char*)Toy_readFile("scripts/interpreter-pool.toy", &size);
+		const unsigned char* tb = Toy_compileString(source, &size);
+		free((void*)source);
+
+		if (!tb) {
+			return -1;
+		}
+
+		Toy_Interpreter snapshot;
+		Toy_initInterpreter(&snapshot);
+		Toy_setInterpreterAssert(&snapshot, countAssertFn);
+		Toy_injectNativeHook(&snapshot, "standard", Toy_hookStandard);
+		Toy_runInterpreter(&snapshot, tb, size);
+
+		//handle several requests, more than the pool holds
+		Toy_InterpreterPool pool;
+		Toy_initInterpreterPool(&pool, &snapshot, 2);
+
+		const char* expected[] = { "hello alice", "hello bob", "hello carol" };
+
+		for (int i = 0; i < 12; i++) {
+			//sometimes there are more interpreters in use than idle
+			Toy_Interpreter* held[2] = { NULL, NULL };
+			if (i % 4 == 0) {
+				held[0] = Toy_acquireInterpreter(&pool);
+				held[1] = Toy_acquireInterpreter(&pool);
+			}
+
+			Toy_Interpreter* interpreter = Toy_acquireInterpreter(&pool);
+
+			if (!handleRequest(interpreter, i % 3, expected[i % 3])) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Request %d was handled incorrectly\n" TOY_CC_RESET, i);
+				return -1;
+			}
+
+			Toy_releaseInterpreter(&pool, interpreter);
+
+			for (int j = 0; j < 2; j++) {
+				if (held[j] != NULL) {
+					Toy_releaseInterpreter(&pool, held[j]);
+				}
+			}
+		}
+
+		if (pool.count != 3) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Expected 3 idle interpreters, found %d\n" TOY_CC_RESET, pool.count);
+			return -1;
+		}
+
+		//the snapshot itself is untouched
+		if (getGlobalInteger(&snapshot, "requests") != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: A request modified the snapshot\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//a fork can outlive its snapshot
+		Toy_Interpreter fork;
+		Toy_forkInterpreter(&fork, &snapshot);
+
+		Toy_freeInterpreterPool(&pool);
+		Toy_freeInterpreter(&snapshot);
+
+		if (!handleRequest(&fork, 1, "hello bob") || getGlobalInteger(&fork, "requests") != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: A fork failed after its snapshot was freed\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeInterpreter(&fork);
+	}
+
+	if (failedAssertions == 0) {
+		printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	}
+
+	return failedAssertions;
+}
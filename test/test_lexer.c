@@ -1,4 +1,5 @@
 #include "toy_lexer.h"
+#include "toy_keyword_types.h"
 
 #include "toy_console_colors.h"
 
@@ -43,6 +44,39 @@ int main() {
 		}
 	}
 
+	{
+		//every keyword in the table is recognized
+		for (int i = 0; Toy_keywordTypes[i].keyword; i++) {
+			Toy_Lexer lexer;
+			Toy_initLexer(&lexer, Toy_keywordTypes[i].keyword);
+
+			Toy_Token token = Toy_private_scanLexer(&lexer);
+
+			if (token.type != Toy_keywordTypes[i].type || Toy_findTypeByKeyword(Toy_keywordTypes[i].keyword) != Toy_keywordTypes[i].type) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Keyword not recognized: %s" TOY_CC_RESET, Toy_keywordTypes[i].keyword);
+				return -1;
+			}
+		}
+
+		//names close to a keyword are identifiers
+		char* source = "i ifs fo format a assertion asserts astypes Null typ trues continued";
+
+		Toy_Lexer lexer;
+		Toy_initLexer(&lexer, source);
+
+		for (Toy_Token token = Toy_private_scanLexer(&lexer); token.type != TOY_TOKEN_EOF; token = Toy_private_scanLexer(&lexer)) {
+			if (token.type != TOY_TOKEN_IDENTIFIER) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Identifier lexed as a keyword: %.*s" TOY_CC_RESET, token.length, token.lexeme);
+				return -1;
+			}
+		}
+
+		if (Toy_findTypeByKeyword("f") != TOY_TOKEN_EOF) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Prefix of a keyword found as a keyword" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -1,9 +1,11 @@
 #include "toy_literal.h"
+#include "toy_literal_array.h"
 
 #include "toy_memory.h"
 #include "toy_console_colors.h"
 
 #include <stdio.h>
+#include <string.h>
 
 int main() {
 	{
@@ -45,6 +47,196 @@ int main() {
 		Toy_freeLiteral(literal);
 	}
 
+	{
+		//test interned identifiers
+		Toy_RefStringInternStats before = Toy_getRefStringInternStats();
+
+		Toy_Literal first = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("foobar"));
+		Toy_Literal second = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("foobar"));
+		Toy_Literal third = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("fizzbuzz"));
+		Toy_Literal string = TOY_TO_STRING_LITERAL(Toy_createRefString("foobar"));
+
+		if (TOY_AS_IDENTIFIER(first) != TOY_AS_IDENTIFIER(second) || Toy_countRefString(TOY_AS_IDENTIFIER(first)) != 2) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: identical identifiers weren't interned\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (!Toy_literalsAreEqual(first, second) || Toy_literalsAreEqual(first, third)) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: interned identifiers compared incorrectly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//uninterned strings still compare by value
+		if (!Toy_equalsRefString(TOY_AS_STRING(string), TOY_AS_IDENTIFIER(first))) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: interned and uninterned refstrings compared incorrectly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_RefStringInternStats during = Toy_getRefStringInternStats();
+
+		if (during.lookups - before.lookups != 3 || during.hits - before.hits != 1 || during.count - before.count != 2) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: unexpected intern table stats\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeLiteral(first);
+		Toy_freeLiteral(second);
+		Toy_freeLiteral(third);
+		Toy_freeLiteral(string);
+
+		//freed refstrings leave the table
+		if (Toy_getRefStringInternStats().count != before.count) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: freed refstrings were left in the intern table\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//test the intern table across growth and removal
+		Toy_Literal literals[500];
+		char buffer[32];
+
+		for (int i = 0; i < 500; i++) {
+			snprintf(buffer, 32, "identifier%d", i);
+			literals[i] = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString(buffer));
+		}
+
+		//remove every other one, which shifts the clusters
+		for (int i = 0; i < 500; i += 2) {
+			Toy_freeLiteral(literals[i]);
+		}
+
+		for (int i = 1; i < 500; i += 2) {
+			snprintf(buffer, 32, "identifier%d", i);
+			Toy_RefString* refString = Toy_internRefStringLength(buffer, strlen(buffer));
+
+			if (refString != TOY_AS_IDENTIFIER(literals[i])) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: interned identifier lost from the table\n" TOY_CC_RESET);
+				return -1;
+			}
+
+			Toy_deleteRefString(refString);
+			Toy_freeLiteral(literals[i]);
+		}
+
+		if (Toy_getRefStringInternStats().count != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: intern table wasn't emptied\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
+	{
+		//test refstring slices
+		char buffer[128];
+		for (int i = 0; i < 100; i++) {
+			buffer[i] = 'a' + i % 26;
+		}
+		buffer[100] = '\0';
+
+		Toy_RefString* parent = Toy_createRefString(buffer);
+
+		//single characters come from the table
+		Toy_RefString* first = Toy_sliceRefString(parent, 3, 1);
+		Toy_RefString* second = Toy_sliceRefString(parent, 29, 1);
+
+		if (first != second || !Toy_equalsRefStringCString(first, "d") || Toy_countRefString(parent) != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: single character slices weren't shared\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//long slices share the parent, and slices of slices share the same parent
+		Toy_RefString* middle = Toy_sliceRefString(parent, 10, 50);
+		Toy_RefString* inner = Toy_sliceRefString(middle, 5, 40);
+
+		if (Toy_countRefString(parent) != 3 || Toy_lengthRefString(inner) != 40 || memcmp(Toy_dataRefString(inner), buffer + 15, 40) != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: long slices didn't share their parent\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//a slice to the end of the parent is already terminated
+		Toy_RefString* tail = Toy_sliceRefString(parent, 60, 40);
+
+		if (strcmp(Toy_toCString(tail), buffer + 60) != 0 || Toy_countRefString(parent) != 4) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: tail slice wasn't terminated\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//otherwise, the slice gets a terminated copy, made only once
+		if (strlen(Toy_toCString(middle)) != 50 || strncmp(Toy_toCString(middle), buffer + 10, 50) != 0 || Toy_toCString(middle) != Toy_toCString(middle) || Toy_countRefString(parent) != 4) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: slice wasn't terminated correctly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//slices and copies compare by value
+		Toy_RefString* copy = Toy_createRefStringLength(buffer + 15, 40);
+
+		if (!Toy_equalsRefString(inner, copy)) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: slice compared incorrectly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		//interning a slice interns a copy
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_copyRefString(inner));
+
+		if (TOY_AS_IDENTIFIER(identifier) == inner || !Toy_equalsRefString(TOY_AS_IDENTIFIER(identifier), copy)) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: slice wasn't interned correctly\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeLiteral(identifier);
+		Toy_deleteRefString(copy);
+		Toy_deleteRefString(tail);
+		Toy_deleteRefString(inner);
+		Toy_deleteRefString(middle);
+		Toy_deleteRefString(second);
+		Toy_deleteRefString(first);
+
+		if (Toy_countRefString(parent) != 1) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: slices didn't release their parent\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_deleteRefString(parent);
+	}
+
+	{
+		//test that hashes depend on every byte, and on the order of array elements
+		Toy_Literal lhs = TOY_TO_STRING_LITERAL(Toy_createRefStringLength("key\0one", 7));
+		Toy_Literal rhs = TOY_TO_STRING_LITERAL(Toy_createRefStringLength("key\0two", 7));
+
+		Toy_LiteralArray* forward = TOY_ALLOCATE(Toy_LiteralArray, 1);
+		Toy_LiteralArray* backward = TOY_ALLOCATE(Toy_LiteralArray, 1);
+		Toy_initLiteralArray(forward);
+		Toy_initLiteralArray(backward);
+
+		Toy_pushLiteralArray(forward, TOY_TO_INTEGER_LITERAL(1));
+		Toy_pushLiteralArray(forward, TOY_TO_INTEGER_LITERAL(2));
+		Toy_pushLiteralArray(backward, TOY_TO_INTEGER_LITERAL(2));
+		Toy_pushLiteralArray(backward, TOY_TO_INTEGER_LITERAL(1));
+
+		Toy_Literal forwardLiteral = TOY_TO_ARRAY_LITERAL(forward);
+		Toy_Literal backwardLiteral = TOY_TO_ARRAY_LITERAL(backward);
+
+		bool failed = Toy_hashLiteral(lhs) == Toy_hashLiteral(rhs) || Toy_hashLiteral(forwardLiteral) == Toy_hashLiteral(backwardLiteral);
+
+		//a seed changes the hashes of new literals
+		int unseeded = Toy_hashLiteral(lhs);
+		Toy_setLiteralHashSeed(42);
+		failed = failed || Toy_hashLiteral(lhs) == unseeded;
+		Toy_setLiteralHashSeed(0);
+		failed = failed || Toy_hashLiteral(lhs) != unseeded;
+
+		Toy_freeLiteral(lhs);
+		Toy_freeLiteral(rhs);
+		Toy_freeLiteral(forwardLiteral);
+		Toy_freeLiteral(backwardLiteral);
+
+		if (failed) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Literal hashes collided unexpectedly\n" TOY_CC_RESET);
+			return -1;
+		}
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -67,6 +67,39 @@ int main() {
 		Toy_freeLiteralArray(&array);
 	}
 
+	{
+		//test that shared copies stay independent
+		Toy_LiteralArray array;
+		Toy_initLiteralArray(&array);
+
+		for (int i = 0; i < 10; i++) {
+			Toy_pushLiteralArray(&array, TOY_TO_INTEGER_LITERAL(i));
+		}
+
+		Toy_LiteralArray copy;
+		Toy_shareLiteralArray(&copy, &array);
+
+		if (copy.literals != array.literals) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Array copy didn't share the original buffer\n" TOY_CC_RESET);
+			Toy_freeLiteralArray(&copy);
+			Toy_freeLiteralArray(&array);
+			return -1;
+		}
+
+		Toy_setLiteralArray(&copy, TOY_TO_INTEGER_LITERAL(0), TOY_TO_INTEGER_LITERAL(42));
+		Toy_pushLiteralArray(&copy, TOY_TO_INTEGER_LITERAL(10));
+
+		if (copy.literals == array.literals || array.count != 10 || copy.count != 11 || TOY_AS_INTEGER(array.literals[0]) != 0 || TOY_AS_INTEGER(copy.literals[0]) != 42) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Modifying an array copy affected the original\n" TOY_CC_RESET);
+			Toy_freeLiteralArray(&copy);
+			Toy_freeLiteralArray(&array);
+			return -1;
+		}
+
+		Toy_freeLiteralArray(&copy);
+		Toy_freeLiteralArray(&array);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -32,6 +32,121 @@ int main() {
 		Toy_freeLiteralDictionary(&dictionary);
 	}
 
+	{
+		//test that shared copies stay independent
+		Toy_Literal key = TOY_TO_STRING_LITERAL(Toy_createRefString("key"));
+
+		Toy_LiteralDictionary dictionary;
+		Toy_initLiteralDictionary(&dictionary);
+
+		Toy_setLiteralDictionary(&dictionary, key, TOY_TO_INTEGER_LITERAL(1));
+
+		Toy_LiteralDictionary copy;
+		Toy_shareLiteralDictionary(&copy, &dictionary);
+
+		Toy_setLiteralDictionary(&copy, key, TOY_TO_INTEGER_LITERAL(2));
+
+		Toy_Literal original = Toy_getLiteralDictionary(&dictionary, key);
+		Toy_Literal modified = Toy_getLiteralDictionary(&copy, key);
+
+		if (copy.entries == dictionary.entries || TOY_AS_INTEGER(original) != 1 || TOY_AS_INTEGER(modified) != 2) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Modifying a dictionary copy affected the original\n" TOY_CC_RESET);
+			Toy_freeLiteral(key);
+			Toy_freeLiteralDictionary(&copy);
+			Toy_freeLiteralDictionary(&dictionary);
+			return -1;
+		}
+
+		//share again, then remove from the original
+		Toy_freeLiteralDictionary(&copy);
+		Toy_shareLiteralDictionary(&copy, &dictionary);
+
+		Toy_removeLiteralDictionary(&dictionary, key);
+
+		if (Toy_existsLiteralDictionary(&dictionary, key) || !Toy_existsLiteralDictionary(&copy, key)) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Removing from a dictionary affected its copy\n" TOY_CC_RESET);
+			Toy_freeLiteral(key);
+			Toy_freeLiteralDictionary(&copy);
+			Toy_freeLiteralDictionary(&dictionary);
+			return -1;
+		}
+
+		Toy_freeLiteral(key);
+		Toy_freeLiteralDictionary(&copy);
+		Toy_freeLiteralDictionary(&dictionary);
+	}
+
+	{
+		//test growing, removing, reusing removed slots and shrinking
+		Toy_LiteralDictionary dictionary;
+		Toy_initLiteralDictionary(&dictionary);
+
+		for (int i = 0; i < 1000; i++) {
+			Toy_setLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i), TOY_TO_INTEGER_LITERAL(i * 2));
+		}
+
+		int grownCapacity = dictionary.capacity;
+
+		//remove the odd keys, then replace them with new keys
+		for (int i = 1; i < 1000; i += 2) {
+			Toy_removeLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i));
+			Toy_setLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i + 1000), TOY_TO_INTEGER_LITERAL(i));
+		}
+
+		int found = 0;
+		for (int i = 0; i < 2000; i++) {
+			Toy_Literal value = Toy_getLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i));
+
+			bool expected = (i < 1000 && i % 2 == 0) || (i >= 1000 && i % 2 == 1);
+			int expectedValue = i < 1000 ? i * 2 : i - 1000;
+
+			if (expected != Toy_existsLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i)) || (expected && (!TOY_IS_INTEGER(value) || TOY_AS_INTEGER(value) != expectedValue))) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Dictionary lookup failed for key %d\n" TOY_CC_RESET, i);
+				Toy_freeLiteralDictionary(&dictionary);
+				return -1;
+			}
+
+			found += expected;
+		}
+
+		//every entry can still be found by iterating
+		int iterated = 0;
+		for (int i = 0; i < dictionary.capacity; i++) {
+			iterated += !TOY_IS_NULL(dictionary.entries[i].key);
+		}
+
+		if (found != 1000 || iterated != 1000 || dictionary.count != 1000 || dictionary.capacity != grownCapacity) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Dictionary has the wrong contents after reusing removed slots\n" TOY_CC_RESET);
+			Toy_freeLiteralDictionary(&dictionary);
+			return -1;
+		}
+
+		//remove all but a few entries
+		for (int i = 0; i < 2000; i++) {
+			if (i % 100 != 0) {
+				Toy_removeLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i));
+			}
+		}
+
+		if (dictionary.count != 10 || dictionary.capacity >= grownCapacity / 8) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Dictionary didn't shrink (count %d, capacity %d)\n" TOY_CC_RESET, dictionary.count, dictionary.capacity);
+			Toy_freeLiteralDictionary(&dictionary);
+			return -1;
+		}
+
+		for (int i = 0; i < 1000; i += 100) {
+			Toy_Literal value = Toy_getLiteralDictionary(&dictionary, TOY_TO_INTEGER_LITERAL(i));
+
+			if (!TOY_IS_INTEGER(value) || TOY_AS_INTEGER(value) != i * 2) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Dictionary lost an entry while shrinking\n" TOY_CC_RESET);
+				Toy_freeLiteralDictionary(&dictionary);
+				return -1;
+			}
+		}
+
+		Toy_freeLiteralDictionary(&dictionary);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
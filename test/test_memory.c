@@ -58,6 +58,73 @@ void testMemoryAllocation() {
 	}
 }
 
+void testMemoryRegion() {
+	//allocated before the region
+	int* outside = TOY_ALLOCATE(int, 10);
+
+	callCount = 0;
+
+	if (!Toy_beginMemoryRegion() || Toy_beginMemoryRegion()) {
+		fprintf(stderr, TOY_CC_ERROR "Failed to begin exactly one memory region\n" TOY_CC_RESET);
+		exit(-1);
+	}
+
+	testMemoryAllocation();
+
+	{
+		//freed blocks are recycled by size class
+		int* first = TOY_ALLOCATE(int, 4);
+		TOY_FREE_ARRAY(int, first, 4);
+		int* second = TOY_ALLOCATE(int, 3);
+
+		if (first != second) {
+			fprintf(stderr, TOY_CC_ERROR "Memory region didn't recycle a freed block\n" TOY_CC_RESET);
+			exit(-1);
+		}
+
+		//growing keeps the contents, within and across size classes
+		second[0] = 42;
+		second = TOY_GROW_ARRAY(int, second, 3, 4);
+		second = TOY_GROW_ARRAY(int, second, 4, 1000);
+		second[999] = 69;
+		second = TOY_GROW_ARRAY(int, second, 1000, 8000);
+
+		if (second[0] != 42 || second[999] != 69) {
+			fprintf(stderr, TOY_CC_ERROR "Memory region lost the contents of a grown array\n" TOY_CC_RESET);
+			exit(-1);
+		}
+
+		second = TOY_SHRINK_ARRAY(int, second, 8000, 2);
+
+		if (second[0] != 42) {
+			fprintf(stderr, TOY_CC_ERROR "Memory region lost the contents of a shrunk array\n" TOY_CC_RESET);
+			exit(-1);
+		}
+
+		//left for the end of the region
+		for (int i = 0; i < 1000; i++) {
+			TOY_ALLOCATE(int, 8);
+		}
+	}
+
+	//memory from before the region can still be freed
+	TOY_FREE_ARRAY(int, outside, 10);
+
+	//the region itself, a chunk, the chunk list, a large allocation and its release, and the outside free
+	if (callCount != 6) {
+		fprintf(stderr, TOY_CC_ERROR "Unexpected call count for memory region; was called %d times\n" TOY_CC_RESET, callCount);
+		exit(-1);
+	}
+
+	Toy_endMemoryRegion();
+
+	//everything else is released at once
+	if (callCount != 9) {
+		fprintf(stderr, TOY_CC_ERROR "Unexpected call count after the memory region; was called %d times\n" TOY_CC_RESET, callCount);
+		exit(-1);
+	}
+}
+
 int main() {
 	//test the default allocator
 	testMemoryAllocation();
@@ -71,6 +138,9 @@ int main() {
 		return -1;
 	}
 
+	//test the memory region, on top of the custom allocator
+	testMemoryRegion();
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -103,6 +103,8 @@ int main() {
 			"declare-types-dictionary-value.toy",
 			"index-access-bugfix.toy",
 			"index-arrays-non-integer.toy",
+			"infinite-recursion.toy",
+			"quickened-division-by-zero.toy",
 			"string-concat.toy",
 			"unary-inverted-nothing.toy",
 			"unary-negative-nothing.toy",
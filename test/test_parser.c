@@ -159,6 +159,59 @@ int main() {
 		Toy_freeParser(&parser);
 	}
 
+	{
+		//test constant propagation and dead branch elimination
+		const char* source = "var SIZE: int const = 100;\nprint (SIZE - 1) * 2;\nif (SIZE < 0) { print SIZE; }\n{ var SIZE: int = 5; print SIZE; }\n";
+
+		Toy_Lexer lexer;
+		Toy_Parser parser;
+		Toy_initLexer(&lexer, source);
+		Toy_initParser(&parser, &lexer);
+
+		//the declaration is kept
+		Toy_ASTNode* node = Toy_scanParser(&parser);
+
+		if (node == NULL || node->type != TOY_AST_NODE_VAR_DECL) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Constant declaration was not kept\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeASTNode(node);
+
+		//the expression reading it is folded
+		node = Toy_scanParser(&parser);
+
+		if (node == NULL || node->type != TOY_AST_NODE_UNARY || node->unary.child->type != TOY_AST_NODE_LITERAL || !TOY_IS_INTEGER(node->unary.child->atomic.literal) || TOY_AS_INTEGER(node->unary.child->atomic.literal) != 198) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Constant expression was not folded\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeASTNode(node);
+
+		//the dead branch is removed
+		node = Toy_scanParser(&parser);
+
+		if (node == NULL || node->type != TOY_AST_NODE_PASS) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Dead branch was not removed\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeASTNode(node);
+
+		//a local with the same name hides the constant
+		node = Toy_scanParser(&parser);
+
+		if (node == NULL || node->type != TOY_AST_NODE_BLOCK || node->block.count != 2 || node->block.nodes[1].unary.child->type != TOY_AST_NODE_LITERAL || !TOY_IS_IDENTIFIER(node->block.nodes[1].unary.child->atomic.literal)) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Hidden constant was propagated\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeASTNode(node);
+
+		//cleanup
+		Toy_freeParser(&parser);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
@@ -118,6 +118,170 @@ int main() {
 		Toy_freeLiteral(type);
 	}
 
+	{
+		//prerequisites
+		char* idn_raw = "foobar";
+
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString(idn_raw));
+		Toy_Literal type = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, false);
+
+		Toy_LiteralArray names;
+		Toy_initLiteralArray(&names);
+		Toy_pushLiteralArray(&names, identifier);
+
+		Toy_LiteralDictionary lookup;
+		Toy_initLiteralDictionary(&lookup);
+		Toy_setLiteralDictionary(&lookup, identifier, TOY_TO_INTEGER_LITERAL(0));
+
+		//test slots
+		Toy_Scope* scope = Toy_pushScope(NULL);
+		Toy_setScopeSlots(scope, &names, &lookup);
+
+		Toy_Literal ref;
+		if (Toy_getScopeSlot(scope, 0, 0, &ref) || Toy_isDeclaredScopeVariable(scope, identifier)) {
+			printf(TOY_CC_ERROR "Undeclared slot was visible" TOY_CC_RESET);
+			return -1;
+		}
+
+		//declaring by name uses the slot
+		if (!Toy_declareScopeVariable(scope, identifier, type) || Toy_declareScopeSlot(scope, 0, type)) {
+			printf(TOY_CC_ERROR "Failed to declare the slot by name" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (!Toy_setScopeSlot(scope, 0, 0, TOY_TO_INTEGER_LITERAL(42), true)) {
+			printf(TOY_CC_ERROR "Failed to set the slot" TOY_CC_RESET);
+			return -1;
+		}
+
+		//deeper scope
+		scope = Toy_pushScope(scope);
+
+		if (!Toy_getScopeVariable(scope, identifier, &ref) || TOY_AS_INTEGER(ref) != 42) {
+			printf(TOY_CC_ERROR "Failed to get the slot by name" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (!Toy_setScopeVariable(scope, identifier, TOY_TO_INTEGER_LITERAL(69), true)) {
+			printf(TOY_CC_ERROR "Failed to set the slot by name" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (!Toy_getScopeSlot(scope, 1, 0, &ref) || TOY_AS_INTEGER(ref) != 69) {
+			printf(TOY_CC_ERROR "Failed to get the slot from a deeper scope" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (Toy_setScopeSlot(scope, 1, 0, TOY_TO_BOOLEAN_LITERAL(true), true)) {
+			printf(TOY_CC_ERROR "Set the slot to the wrong type" TOY_CC_RESET);
+			return -1;
+		}
+
+		//cleanup
+		scope = Toy_popScope(scope);
+		scope = Toy_popScope(scope);
+
+		Toy_freeLiteralDictionary(&lookup);
+		Toy_freeLiteralArray(&names);
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(type);
+	}
+
+	{
+		//prerequisites
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("foobar"));
+		Toy_Literal other = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("other"));
+		Toy_Literal type = TOY_TO_TYPE_LITERAL(TOY_LITERAL_INTEGER, false);
+
+		Toy_private_scope_cache cache = { TOY_TO_NULL_LITERAL, NULL, 0, -1 };
+
+		//test the lookup cache
+		Toy_Scope* global = Toy_pushScope(NULL);
+		Toy_declareScopeVariable(global, identifier, type);
+		Toy_setScopeVariable(global, identifier, TOY_TO_INTEGER_LITERAL(42), false);
+
+		Toy_Scope* scope = Toy_pushScope(global);
+		Toy_private_scope_slot* slot = Toy_private_findScopeVariable(scope, identifier, &cache);
+
+		if (slot == NULL || TOY_AS_INTEGER(slot->value) != 42 || cache.scope != global) {
+			printf(TOY_CC_ERROR "Failed to cache a variable" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (Toy_private_findScopeVariable(scope, identifier, &cache) != slot) {
+			printf(TOY_CC_ERROR "Cached variable was not found again" TOY_CC_RESET);
+			return -1;
+		}
+
+		//shadowing after a cached lookup
+		Toy_declareScopeVariable(scope, identifier, type);
+		Toy_setScopeVariable(scope, identifier, TOY_TO_INTEGER_LITERAL(69), false);
+
+		slot = Toy_private_findScopeVariable(scope, identifier, &cache);
+
+		if (slot == NULL || TOY_AS_INTEGER(slot->value) != 69 || cache.scope != scope) {
+			printf(TOY_CC_ERROR "Cached variable hid a shadowing variable" TOY_CC_RESET);
+			return -1;
+		}
+
+		//a new scope may reuse the memory of the old one
+		scope = Toy_popScope(scope);
+		scope = Toy_pushScope(global);
+
+		slot = Toy_private_findScopeVariable(scope, identifier, &cache);
+
+		if (slot == NULL || TOY_AS_INTEGER(slot->value) != 42 || cache.scope != global) {
+			printf(TOY_CC_ERROR "Cached variable outlived its scope" TOY_CC_RESET);
+			return -1;
+		}
+
+		//slots set after a variable was declared move it
+		Toy_declareScopeVariable(scope, other, type);
+		Toy_setScopeVariable(scope, other, TOY_TO_INTEGER_LITERAL(7), false);
+		Toy_private_findScopeVariable(scope, other, &cache);
+
+		Toy_LiteralArray names;
+		Toy_initLiteralArray(&names);
+		Toy_pushLiteralArray(&names, identifier);
+
+		Toy_LiteralDictionary lookup;
+		Toy_initLiteralDictionary(&lookup);
+		Toy_setLiteralDictionary(&lookup, identifier, TOY_TO_INTEGER_LITERAL(0));
+
+		Toy_setScopeSlots(scope, &names, &lookup);
+
+		slot = Toy_private_findScopeVariable(scope, other, &cache);
+
+		if (slot == NULL || TOY_AS_INTEGER(slot->value) != 7 || cache.slot != 1) {
+			printf(TOY_CC_ERROR "Cached variable was not moved with its slot" TOY_CC_RESET);
+			return -1;
+		}
+
+		//the slot hides the global once it's declared, by name
+		if (!Toy_declareScopeVariable(scope, identifier, type) || !Toy_setScopeSlot(scope, 0, 0, TOY_TO_INTEGER_LITERAL(69), false)) {
+			printf(TOY_CC_ERROR "Failed to declare the slot after a variable" TOY_CC_RESET);
+			return -1;
+		}
+
+		slot = Toy_private_findScopeVariable(scope, identifier, &cache);
+
+		if (slot == NULL || TOY_AS_INTEGER(slot->value) != 69 || cache.scope != scope || cache.slot != 0) {
+			printf(TOY_CC_ERROR "Failed to find the slot after a variable" TOY_CC_RESET);
+			return -1;
+		}
+
+		//cleanup
+		scope = Toy_popScope(scope);
+		global = Toy_popScope(global);
+
+		Toy_private_freeScopeCache(&cache, 1);
+		Toy_freeLiteralDictionary(&lookup);
+		Toy_freeLiteralArray(&names);
+		Toy_freeLiteral(identifier);
+		Toy_freeLiteral(other);
+		Toy_freeLiteral(type);
+	}
+
 	printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
 	return 0;
 }
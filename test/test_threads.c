@@ -0,0 +1,223 @@
+#include "toy_interpreter.h"
+#include "toy_context.h"
+
+#include "toy_console_colors.h"
+
+#include "toy_memory.h"
+
+#include "../repl/repl_tools.h"
+#include "../repl/lib_standard.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define THREAD_COUNT 8
+#define RUN_COUNT 10
+#define SHARE_COUNT 1000
+
+//exercises strings, slices, copy-on-write compounds, functions and the standard library
+static const char* source =
+	"import standard;\n"
+	"fn fib(n: int) {\n"
+	"	if (n < 2) {\n"
+	"		return n;\n"
+	"	}\n"
+	"	return fib(n - 1) + fib(n - 2);\n"
+	"}\n"
+	"var text: string = \"\";\n"
+	"for (var i: int = 0; i < 40; i++) {\n"
+	"	text += \"abcd\";\n"
+	"}\n"
+	"var numbers = [1, 2, 3];\n"
+	"var copy = numbers;\n"
+	"copy[0] = 10;\n"
+	"var names = [\"first\": 1, \"second\": 2];\n"
+	"var other = names;\n"
+	"other[\"third\"] = 3;\n"
+	"assert fib(15) == 610, \"recursion failed\";\n"
+	"assert text[5] == \"b\" && text.length() == 160, \"string building failed\";\n"
+	"assert text[4:39] == text[8:43], \"string slicing failed\";\n"
+	"assert numbers[0] == 1 && copy[0] == 10, \"array copies failed\";\n"
+	"assert names.length() == 2 && other.length() == 3, \"dictionary copies failed\";\n"
+	"assert numbers.toString() == \"[1,2,3]\", \"toString failed\";\n"
+	"print text[100:139];\n";
+
+static atomic_int failedAssertions = 0;
+static atomic_int printCount = 0;
+
+static void countPrintFn(const char* output) {
+	if (strcmp(output, "abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd") == 0) {
+		printCount++;
+	}
+}
+
+static void countAssertFn(const char* output) {
+	fprintf(stderr, TOY_CC_ERROR "Assertion failure: %s\n" TOY_CC_RESET, output);
+	failedAssertions++;
+}
+
+//created by the main thread, and shared with every worker
+typedef struct Shared {
+	Toy_Literal string;
+	Toy_Literal slice;
+	Toy_Literal array;
+	Toy_Literal identifiers[THREAD_COUNT]; //each worker releases one reference to the same interned identifier
+} Shared;
+
+typedef struct Worker {
+	pthread_t thread;
+	int index;
+	Shared* shared;
+	bool failed;
+} Worker;
+
+static void* runWorker(void* arg) {
+	Worker* worker = (Worker*)arg;
+	Shared* shared = worker->shared;
+
+	//each worker has its own context, and every other one also runs within a memory region
+	Toy_Context context;
+	Toy_initContext(&context);
+	Toy_setContext(&context);
+
+	if (worker->index % 2 == 1) {
+		Toy_beginMemoryRegion();
+	}
+
+	//run the script several times, each with a fresh interpreter
+	for (int run = 0; run < RUN_COUNT; run++) {
+		size_t size = 0;
+		const unsigned char* tb = Toy_compileString(source, &size);
+
+		if (!tb) {
+			worker->failed = true;
+			break;
+		}
+
+		Toy_Interpreter interpreter;
+		Toy_initInterpreter(&interpreter);
+		Toy_setInterpreterPrint(&interpreter, countPrintFn);
+		Toy_setInterpreterAssert(&interpreter, countAssertFn);
+		Toy_injectNativeHook(&interpreter, "standard", Toy_hookStandard);
+
+		Toy_runInterpreter(&interpreter, tb, size);
+		Toy_freeInterpreter(&interpreter);
+	}
+
+	if (worker->index % 2 == 1) {
+		Toy_endMemoryRegion();
+	}
+
+	//literals from the main thread are shared, rather than copied into the region
+	Toy_setContext(NULL);
+
+	for (int i = 0; i < SHARE_COUNT; i++) {
+		Toy_Literal string = Toy_copyLiteral(shared->string);
+		Toy_Literal array = Toy_copyLiteral(shared->array);
+
+		//slices read from the shared string, and the shared slice is terminated on demand
+		Toy_RefString* slice = Toy_sliceRefString(TOY_AS_STRING(string), i % 32, 64);
+
+		if (strlen(Toy_toCString(TOY_AS_STRING(shared->slice))) != 64 || Toy_equalsRefString(slice, TOY_AS_STRING(shared->slice)) != (i % 32 == 16)) {
+			worker->failed = true;
+		}
+
+		//writing to a shared array gives this copy its own buffer
+		Toy_pushLiteralArray(TOY_AS_ARRAY(array), TOY_TO_INTEGER_LITERAL(worker->index));
+
+		if (TOY_AS_ARRAY(array)->count != 4 || TOY_AS_ARRAY(shared->array)->count != 3) {
+			worker->failed = true;
+		}
+
+		Toy_deleteRefString(slice);
+		Toy_freeLiteral(array);
+		Toy_freeLiteral(string);
+	}
+
+	Toy_freeLiteral(shared->identifiers[worker->index]);
+
+	Toy_freeContext(&context);
+	return NULL;
+}
+
+int main() {
+	{
+		//run N interpreters on N threads at once - build with -fsanitize=thread to check for data races
+		Shared shared;
+
+		char buffer[129];
+		for (int i = 0; i < 128; i++) {
+			buffer[i] = 'a' + i % 26;
+		}
+		buffer[128] = '\0';
+
+		shared.string = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer));
+		shared.slice = TOY_TO_STRING_LITERAL(Toy_sliceRefString(TOY_AS_STRING(shared.string), 16, 64));
+
+		Toy_LiteralArray* array = TOY_ALLOCATE(Toy_LiteralArray, 1);
+		Toy_initLiteralArray(array);
+		Toy_pushLiteralArray(array, TOY_TO_INTEGER_LITERAL(1));
+		Toy_pushLiteralArray(array, shared.string);
+		Toy_pushLiteralArray(array, TOY_TO_INTEGER_LITERAL(3));
+		shared.array = TOY_TO_ARRAY_LITERAL(array);
+
+		Toy_Literal identifier = TOY_TO_IDENTIFIER_LITERAL(Toy_createRefString("shared"));
+		for (int i = 0; i < THREAD_COUNT; i++) {
+			shared.identifiers[i] = Toy_copyLiteral(identifier);
+		}
+		Toy_freeLiteral(identifier);
+
+		//start the workers
+		Worker workers[THREAD_COUNT];
+
+		for (int i = 0; i < THREAD_COUNT; i++) {
+			workers[i].index = i;
+			workers[i].shared = &shared;
+			workers[i].failed = false;
+
+			if (pthread_create(&workers[i].thread, NULL, runWorker, &workers[i]) != 0) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Failed to start a thread\n" TOY_CC_RESET);
+				return -1;
+			}
+		}
+
+		for (int i = 0; i < THREAD_COUNT; i++) {
+			pthread_join(workers[i].thread, NULL);
+
+			if (workers[i].failed) {
+				fprintf(stderr, TOY_CC_ERROR "ERROR: Worker %d failed\n" TOY_CC_RESET, i);
+				return -1;
+			}
+		}
+
+		//every worker ran every script to the end
+		if (printCount != THREAD_COUNT * RUN_COUNT) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Expected %d prints, found %d\n" TOY_CC_RESET, THREAD_COUNT * RUN_COUNT, printCount);
+			return -1;
+		}
+
+		//the last worker to finish removed the identifier from the main thread's intern table
+		if (Toy_getRefStringInternStats().count != 0) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Shared identifier was left in the intern table\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		if (Toy_countRefString(TOY_AS_STRING(shared.string)) != 3) {
+			fprintf(stderr, TOY_CC_ERROR "ERROR: Shared string has the wrong reference count\n" TOY_CC_RESET);
+			return -1;
+		}
+
+		Toy_freeLiteral(shared.array);
+		Toy_freeLiteral(shared.slice);
+		Toy_freeLiteral(shared.string);
+	}
+
+	if (failedAssertions == 0) {
+		printf(TOY_CC_NOTICE "All good\n" TOY_CC_RESET);
+	}
+
+	return failedAssertions;
+}
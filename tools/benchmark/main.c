@@ -0,0 +1,567 @@
+#include "repl_tools.h"
+#include "drive_system.h"
+#include "lib_standard.h"
+#include "lib_math.h"
+#include "toy_interpreter_pool.h"
+#include "toy_memory.h"
+#include "toy_lexer.h"
+#include "toy_console_colors.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//usage: benchmark file.toy [operations]
+//operations is the amount of work the script is known to do (function calls, iterations, etc.), used to report a rate
+static double timeSourceFile(const char* fname) {
+	clock_t start = clock();
+	Toy_runSourceFile(fname);
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//usage: benchmark -c file.toy
+//only the lexer, parser and compiler are timed, not the interpreter
+static double timeCompileSource(const char* source) {
+	size_t size = 0;
+
+	clock_t start = clock();
+	const unsigned char* tb = Toy_compileString(source, &size);
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	if (tb == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Failed to compile the benchmark source\n" TOY_CC_RESET);
+		return -1;
+	}
+
+	free((void*)tb);
+	return seconds;
+}
+
+//usage: benchmark -s lines
+//generates a large source file, which reuses a limited pool of names and values (so it fits in the literal cache)
+static char* generateSyntheticSource(int lines) {
+	const size_t lineMax = 64;
+	char* source = malloc(lineMax * (lines + 1) + 1);
+	size_t count = 0;
+
+	for (int i = 0; i < lines; i++) {
+		if (i < 16384) {
+			count += sprintf(source + count, "var v%d = %d;\n", i, i % 8192);
+		}
+		else if (i % 8 == 0) {
+			count += sprintf(source + count, "print \"line %d\";\n", i % 4096);
+		}
+		else {
+			count += sprintf(source + count, "v%d = v%d + %d * %d.5;\n", i % 16384, (i + 1) % 16384, i % 8192, i % 1024);
+		}
+	}
+
+	source[count] = '\0';
+	return source;
+}
+
+//usage: benchmark -t [lines]
+//only the lexer is timed, over the same generated source as -s - reported in megabytes per second
+static void benchmarkLexer(int lines) {
+	char* source = generateSyntheticSource(lines);
+	size_t length = strlen(source);
+
+	int tokens = 0;
+
+	clock_t start = clock();
+
+	Toy_Lexer lexer;
+	Toy_initLexer(&lexer, source);
+
+	for (Toy_Token token = Toy_private_scanLexer(&lexer); token.type != TOY_TOKEN_EOF; token = Toy_private_scanLexer(&lexer)) {
+		tokens++;
+	}
+
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	printf("Lexer Benchmark Report (%d lines, %.1f MB):\n", lines, length / 1e6);
+	printf("\t%d tokens\n\t%f seconds\n\t%.1f MB per second\n", tokens, seconds, seconds > 0 ? length / 1e6 / seconds : 0);
+
+	free(source);
+}
+
+//usage: benchmark -p file.toy requests
+//the script declares fn handle(request: int), which is called once per request - first with a new interpreter set up for each request, then with forks from a pool
+static Toy_Interpreter* setupInterpreter(Toy_Bytecode* bytecode) {
+	Toy_Interpreter* interpreter = malloc(sizeof(Toy_Interpreter));
+	Toy_initInterpreter(interpreter);
+	Toy_injectNativeHook(interpreter, "standard", Toy_hookStandard);
+	Toy_injectNativeHook(interpreter, "math", Toy_hookMath);
+	Toy_runInterpreterBytecode(interpreter, bytecode);
+
+	return interpreter;
+}
+
+static void handleRequest(Toy_Interpreter* interpreter, int request) {
+	Toy_LiteralArray arguments;
+	Toy_initLiteralArray(&arguments);
+	Toy_LiteralArray returns;
+	Toy_initLiteralArray(&returns);
+
+	Toy_pushLiteralArray(&arguments, TOY_TO_INTEGER_LITERAL(request));
+	Toy_callFn(interpreter, "handle", &arguments, &returns);
+
+	Toy_freeLiteralArray(&arguments);
+	Toy_freeLiteralArray(&returns);
+}
+
+static double timeRequests(Toy_Bytecode* bytecode, int requests, bool pooled) {
+	clock_t start = clock();
+
+	if (pooled) {
+		Toy_Interpreter* snapshot = setupInterpreter(bytecode);
+		Toy_InterpreterPool pool;
+		Toy_initInterpreterPool(&pool, snapshot, 1);
+
+		for (int i = 0; i < requests; i++) {
+			Toy_Interpreter* interpreter = Toy_acquireInterpreter(&pool);
+			handleRequest(interpreter, i);
+			Toy_releaseInterpreter(&pool, interpreter);
+		}
+
+		Toy_freeInterpreterPool(&pool);
+		Toy_freeInterpreter(snapshot);
+		free(snapshot);
+	}
+	else {
+		for (int i = 0; i < requests; i++) {
+			Toy_Interpreter* interpreter = setupInterpreter(bytecode);
+			handleRequest(interpreter, i);
+			Toy_freeInterpreter(interpreter);
+			free(interpreter);
+		}
+	}
+
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//usage: benchmark -l directory [rounds]
+//the startup latency of every .tb file in a directory, such as one filled by "toyrepl -c file.toy -o directory/file.tb" - reading each file and handing it to the interpreter, versus mapping it
+static void noPrintFn(const char* output) {
+	//NO OP
+}
+
+static void runStartup(const char* path, bool mapped) {
+	Toy_Interpreter interpreter;
+	Toy_initInterpreter(&interpreter);
+	Toy_setInterpreterPrint(&interpreter, noPrintFn);
+	Toy_setInterpreterAssert(&interpreter, noPrintFn);
+	Toy_setInterpreterError(&interpreter, noPrintFn);
+	Toy_injectNativeHook(&interpreter, "standard", Toy_hookStandard);
+	Toy_injectNativeHook(&interpreter, "math", Toy_hookMath);
+
+	size_t size = 0;
+
+	if (mapped) {
+		const unsigned char* tb = Toy_mapFile(path, &size);
+
+		if (tb != NULL) {
+			Toy_Bytecode bytecode;
+			Toy_initBytecode(&bytecode, tb, size);
+			bytecode.writable = true;
+
+			Toy_runInterpreterBytecode(&interpreter, &bytecode);
+
+			Toy_freeBytecode(&bytecode);
+			Toy_unmapFile(tb, size);
+		}
+	}
+	else {
+		const unsigned char* tb = Toy_readFile(path, &size);
+
+		if (tb != NULL) {
+			Toy_runInterpreter(&interpreter, tb, size);
+		}
+	}
+
+	Toy_freeInterpreter(&interpreter);
+}
+
+static double timeStartup(char** paths, int count, int rounds, bool mapped) {
+	clock_t start = clock();
+
+	for (int round = 0; round < rounds; round++) {
+		for (int i = 0; i < count; i++) {
+			runStartup(paths[i], mapped);
+		}
+	}
+
+	return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static int benchmarkStartup(const char* directory, int rounds) {
+	DIR* dir = opendir(directory);
+
+	if (dir == NULL) {
+		fprintf(stderr, TOY_CC_ERROR "Could not open directory \"%s\"\n" TOY_CC_RESET, directory);
+		return -1;
+	}
+
+	//collect the bytecode files
+	char** paths = NULL;
+	int count = 0;
+	int capacity = 0;
+
+	struct dirent* entry;
+	while ((entry = readdir(dir)) != NULL) {
+		const char* extension = strrchr(entry->d_name, '.');
+
+		if (!extension || strcmp(extension, ".tb")) {
+			continue;
+		}
+
+		if (count == capacity) {
+			capacity = capacity < 8 ? 8 : capacity * 2;
+			paths = realloc(paths, sizeof(char*) * capacity);
+		}
+
+		paths[count] = malloc(strlen(directory) + strlen(entry->d_name) + 2);
+		sprintf(paths[count], "%s/%s", directory, entry->d_name);
+		count++;
+	}
+
+	closedir(dir);
+
+	if (count == 0) {
+		fprintf(stderr, TOY_CC_ERROR "No .tb files found in \"%s\"\n" TOY_CC_RESET, directory);
+		free(paths);
+		return -1;
+	}
+
+	double read = timeStartup(paths, count, rounds, false);
+	double mapped = timeStartup(paths, count, rounds, true);
+
+	printf("Startup Benchmark Report (%s, %d files, %d rounds):\n", directory, count, rounds);
+	printf("\tread:   %f seconds, %.1f microseconds per file\n", read, read * 1000000 / (count * rounds));
+	printf("\tmapped: %f seconds, %.1f microseconds per file\n", mapped, mapped * 1000000 / (count * rounds));
+
+	for (int i = 0; i < count; i++) {
+		free(paths[i]);
+	}
+	free(paths);
+
+	return 0;
+}
+
+//usage: benchmark -d [entries]
+//the dictionary on its own, with string keys - inserting every key, looking up each one that exists and a missing key for each, then removing and inserting keys so the contents turn over while the size stays the same
+static double timeDictionaryPass(Toy_LiteralDictionary* dictionary, Toy_Literal* keys, Toy_Literal* others, int count, int pass) {
+	clock_t start = clock();
+	int found = 0;
+
+	for (int i = 0; i < count; i++) {
+		switch(pass) {
+			case 0:
+				Toy_setLiteralDictionary(dictionary, keys[i], TOY_TO_INTEGER_LITERAL(i));
+				break;
+
+			case 1:
+				found += Toy_existsLiteralDictionary(dictionary, keys[i]);
+				break;
+
+			case 2:
+				found += Toy_existsLiteralDictionary(dictionary, others[i]);
+				break;
+
+			case 3:
+				Toy_removeLiteralDictionary(dictionary, keys[i]);
+				Toy_setLiteralDictionary(dictionary, others[i], TOY_TO_INTEGER_LITERAL(i));
+				break;
+		}
+	}
+
+	double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	if ((pass == 1 && found != count) || (pass == 2 && found != 0)) {
+		fprintf(stderr, TOY_CC_ERROR "Dictionary benchmark found %d of %d keys\n" TOY_CC_RESET, found, count);
+	}
+
+	return seconds;
+}
+
+static void benchmarkDictionary(int count) {
+	Toy_Literal* keys = malloc(sizeof(Toy_Literal) * count);
+	Toy_Literal* others = malloc(sizeof(Toy_Literal) * count);
+	char buffer[32];
+
+	for (int i = 0; i < count; i++) {
+		sprintf(buffer, "key%d", i);
+		keys[i] = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer));
+		sprintf(buffer, "other%d", i);
+		others[i] = TOY_TO_STRING_LITERAL(Toy_createRefString(buffer));
+	}
+
+	Toy_LiteralDictionary dictionary;
+	Toy_initLiteralDictionary(&dictionary);
+
+	const char* names[] = { "insert", "lookup hit", "lookup miss", "delete churn" };
+
+	printf("Dictionary Benchmark Report (%d entries):\n", count);
+
+	for (int pass = 0; pass < 4; pass++) {
+		double seconds = timeDictionaryPass(&dictionary, keys, others, count, pass);
+		printf("\t%-13s %f seconds, %.1f nanoseconds per operation\n", names[pass], seconds, seconds * 1000000000 / count);
+	}
+
+	Toy_freeLiteralDictionary(&dictionary);
+
+	for (int i = 0; i < count; i++) {
+		Toy_freeLiteral(keys[i]);
+		Toy_freeLiteral(others[i]);
+	}
+
+	free(keys);
+	free(others);
+}
+
+//usage: benchmark -h [entries]
+//how well several realistic sets of keys are spread out by the hash - how many keys share a hash, and how many groups of a dictionary are probed to find each key
+static Toy_Literal makeHashKey(int set, int index, int count) {
+	char buffer[32];
+
+	switch(set) {
+		case 0: //generated variable names
+			sprintf(buffer, "v%d", index);
+			break;
+
+		case 1: //numbers as strings
+			sprintf(buffer, "%d", index);
+			break;
+
+		case 2: //names with a shared prefix and suffix
+			sprintf(buffer, "entity_%d_position", index);
+			break;
+
+		case 3: { //anagrams, which only differ in the order of their letters
+			int length = 0;
+			for (int i = 0; i < 7; i++) {
+				buffer[length++] = "abcdefgh"[index % 8];
+				index /= 8;
+			}
+			buffer[length] = '\0';
+			break;
+		}
+
+		case 4: { //pairs of integers, where both [x, y] and [y, x] exist
+			int side = 1;
+			while (side * side < count) {
+				side++;
+			}
+
+			Toy_LiteralArray* array = TOY_ALLOCATE(Toy_LiteralArray, 1);
+			Toy_initLiteralArray(array);
+			Toy_pushLiteralArray(array, TOY_TO_INTEGER_LITERAL(index % side));
+			Toy_pushLiteralArray(array, TOY_TO_INTEGER_LITERAL(index / side));
+			return TOY_TO_ARRAY_LITERAL(array);
+		}
+	}
+
+	return TOY_TO_STRING_LITERAL(Toy_createRefString(buffer));
+}
+
+static int compareHashes(const void* lhs, const void* rhs) {
+	unsigned int a = *(const unsigned int*)lhs;
+	unsigned int b = *(const unsigned int*)rhs;
+	return (a > b) - (a < b);
+}
+
+static void benchmarkHashes(int count) {
+	const char* names[] = { "names", "numbers", "prefixed", "anagrams", "pairs" };
+
+	Toy_Literal* keys = malloc(sizeof(Toy_Literal) * count);
+	unsigned int* hashes = malloc(sizeof(unsigned int) * count);
+
+	printf("Hash Benchmark Report (%d keys):\n", count);
+	printf("\t%-9s %9s %8s %6s %6s %6s %6s %6s %7s %9s\n", "keys", "collided", "probes", "1", "2", "3-4", "5-8", "9+", "longest", "seconds");
+
+	for (int set = 0; set < 5; set++) {
+		for (int i = 0; i < count; i++) {
+			keys[i] = makeHashKey(set, i, count);
+		}
+
+		//keys sharing their full hash with an earlier key
+		for (int i = 0; i < count; i++) {
+			hashes[i] = (unsigned int)Toy_hashLiteral(keys[i]);
+		}
+
+		qsort(hashes, count, sizeof(unsigned int), compareHashes);
+
+		int collided = 0;
+		for (int i = 1; i < count; i++) {
+			collided += hashes[i] == hashes[i - 1];
+		}
+
+		//fill a dictionary, then find each key again
+		clock_t start = clock();
+
+		Toy_LiteralDictionary dictionary;
+		Toy_initLiteralDictionary(&dictionary);
+
+		for (int i = 0; i < count; i++) {
+			Toy_setLiteralDictionary(&dictionary, keys[i], TOY_TO_INTEGER_LITERAL(i));
+		}
+
+		for (int i = 0; i < count; i++) {
+			Toy_existsLiteralDictionary(&dictionary, keys[i]);
+		}
+
+		double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+		//the distribution of probe lengths, in groups
+		int buckets[5] = { 0, 0, 0, 0, 0 };
+		int longest = 0;
+		double total = 0;
+
+		for (int i = 0; i < count; i++) {
+			int probes = Toy_probeLiteralDictionary(&dictionary, keys[i]);
+
+			buckets[probes <= 1 ? 0 : probes <= 2 ? 1 : probes <= 4 ? 2 : probes <= 8 ? 3 : 4]++;
+			longest = probes > longest ? probes : longest;
+			total += probes;
+		}
+
+		printf("\t%-9s %9d %8.3f %6d %6d %6d %6d %6d %7d %9f\n", names[set], collided, total / count, buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], longest, seconds);
+
+		Toy_freeLiteralDictionary(&dictionary);
+
+		for (int i = 0; i < count; i++) {
+			Toy_freeLiteral(keys[i]);
+		}
+	}
+
+	free(keys);
+	free(hashes);
+}
+
+int main(int argc, const char* argv[]) {
+	if (argc <= 1) {
+		fprintf(stderr, TOY_CC_ERROR "Usage: %s [-O] file.toy [operations]\n       %s [-O] -c file.toy\n       %s -s lines\n       %s [-O] -p file.toy requests\n       %s -l directory [rounds]\n       %s -d [entries]\n       %s -h [entries]\n       %s -t [lines]\n" TOY_CC_RESET, argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+		return -1;
+	}
+
+	//usage: benchmark -O ... - the same as without it, but with the bytecode optimized
+	if (!strcmp(argv[1], "-O") && argc > 2) {
+		Toy_setBytecodeOptimization(true);
+		argv++;
+		argc--;
+	}
+
+	//compile-only benchmarks
+	if ((!strcmp(argv[1], "-c") || !strcmp(argv[1], "-s")) && argc > 2) {
+		char* source = NULL;
+
+		if (!strcmp(argv[1], "-c")) {
+			size_t size = 0;
+			source = (char*)Toy_readFile(argv[2], &size);
+		}
+		else {
+			source = generateSyntheticSource(atoi(argv[2]));
+		}
+
+		if (source == NULL) {
+			return -1;
+		}
+
+		double seconds = timeCompileSource(source);
+		free(source);
+
+		if (seconds < 0) {
+			return -1;
+		}
+
+		printf("Compile Benchmark Report (%s %s):\n\t%f seconds\n", argv[1], argv[2], seconds);
+		return 0;
+	}
+
+	//startup benchmarks
+	if (!strcmp(argv[1], "-l") && argc > 2) {
+		return benchmarkStartup(argv[2], argc > 3 ? atoi(argv[3]) : 100);
+	}
+
+	//dictionary benchmarks
+	if (!strcmp(argv[1], "-d")) {
+		if (argc > 2) {
+			benchmarkDictionary(atoi(argv[2]));
+		}
+		else {
+			benchmarkDictionary(1000);
+			benchmarkDictionary(100000);
+			benchmarkDictionary(1000000);
+		}
+		return 0;
+	}
+
+	//hash distribution benchmarks
+	if (!strcmp(argv[1], "-h")) {
+		benchmarkHashes(argc > 2 ? atoi(argv[2]) : 100000);
+		return 0;
+	}
+
+	//lexer benchmarks
+	if (!strcmp(argv[1], "-t")) {
+		benchmarkLexer(argc > 2 ? atoi(argv[2]) : 1000000);
+		return 0;
+	}
+
+	//request handling benchmarks
+	if (!strcmp(argv[1], "-p") && argc > 3) {
+		size_t size = 0;
+		char* source = (char*)Toy_readFile(argv[2], &size);
+
+		if (source == NULL) {
+			return -1;
+		}
+
+		const unsigned char* tb = Toy_compileString(source, &size);
+		free(source);
+
+		if (tb == NULL) {
+			return -1;
+		}
+
+		Toy_Bytecode bytecode;
+		Toy_initBytecode(&bytecode, tb, size);
+
+		int requests = atoi(argv[3]);
+		double fresh = timeRequests(&bytecode, requests, false);
+		double pooled = timeRequests(&bytecode, requests, true);
+
+		Toy_freeBytecode(&bytecode);
+		free((void*)tb);
+
+		printf("Request Benchmark Report (%s, %d requests):\n", argv[2], requests);
+		printf("\tnew interpreters: %f seconds, %.0f requests per second\n", fresh, fresh > 0 ? requests / fresh : 0);
+		printf("\tpooled forks:     %f seconds, %.0f requests per second\n", pooled, pooled > 0 ? requests / pooled : 0);
+		return 0;
+	}
+
+	//not used, except for print
+	Toy_initCommandLine(argc, argv);
+
+	//setup for runner
+	Toy_initDriveSystem();
+	Toy_setDrivePath("scripts", "scripts");
+
+	//run the benchmark
+	double seconds = timeSourceFile(argv[1]);
+
+	//lib cleanup
+	Toy_freeDriveSystem();
+
+	//report output
+	printf("Benchmark Report (%s):\n\t%f seconds\n", argv[1], seconds);
+
+	if (argc > 2) {
+		double operations = strtod(argv[2], NULL);
+		printf("\t%.0f operations\n\t%.0f operations per second\n", operations, seconds > 0 ? operations / seconds : 0);
+	}
+
+	return 0;
+}
@@ -73,6 +73,13 @@ const char *OP_STR[] = {
         EP(DIS_OP_POP_STACK),                 //
         EP(DIS_OP_TERNARY),                   //
         EP(DIS_OP_FN_END),                    //
+        EP(DIS_OP_SCOPE_SLOTS),               //
+        EP(DIS_OP_SLOT_DECL),                 //
+        EP(DIS_OP_SLOT_LOAD),                 //
+        EP(DIS_OP_SLOT_STORE),                //
+        EP(DIS_OP_IF_TRUE_JUMP),              //
+        EP(DIS_OP_SLOT_INCREMENT),            //
+        EP(DIS_OP_SLOT_DECREMENT),            //
 };
 
 const char *LIT_STR[] = {
@@ -102,6 +109,7 @@ enum DIS_ARG_TYPE {
     DIS_ARG_NONE,    //
     DIS_ARG_BYTE,    //
     DIS_ARG_WORD,    //
+    DIS_ARG_INDEX,   // word, or a 0xFFFF word followed by the full 32 bits
     DIS_ARG_INTEGER, //
     DIS_ARG_FLOAT,   //
     DIS_ARG_STRING   //
@@ -114,7 +122,7 @@ const uint8_t OP_ARGS[DIS_OP_END_OPCODES][3] = {
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_ASSERT
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_PRINT
         { DIS_ARG_BYTE, DIS_ARG_NONE, false }, // DIS_OP_LITERAL
-        { DIS_ARG_WORD, DIS_ARG_NONE, false }, // DIS_OP_LITERAL_LONG
+        { DIS_ARG_INDEX, DIS_ARG_NONE, false }, // DIS_OP_LITERAL_LONG
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_LITERAL_RAW
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_NEGATE
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_ADDITION
@@ -129,9 +137,9 @@ const uint8_t OP_ARGS[DIS_OP_END_OPCODES][3] = {
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_TYPE_DECL_removed
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_TYPE_DECL_LONG_removed
         { DIS_ARG_BYTE, DIS_ARG_BYTE, false }, // DIS_OP_VAR_DECL
-        { DIS_ARG_WORD, DIS_ARG_WORD, false }, // DIS_OP_VAR_DECL_LONG
+        { DIS_ARG_INDEX, DIS_ARG_INDEX, false }, // DIS_OP_VAR_DECL_LONG
         { DIS_ARG_BYTE, DIS_ARG_BYTE, false }, // DIS_OP_FN_DECL
-        { DIS_ARG_WORD, DIS_ARG_WORD, false }, // DIS_OP_FN_DECL_LONG
+        { DIS_ARG_INDEX, DIS_ARG_INDEX, false }, // DIS_OP_FN_DECL_LONG
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_VAR_ASSIGN
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_VAR_ADDITION_ASSIGN
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_VAR_SUBTRACTION_ASSIGN
@@ -153,14 +161,22 @@ const uint8_t OP_ARGS[DIS_OP_END_OPCODES][3] = {
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_COMPARE_GREATER
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_COMPARE_GREATER_EQUAL
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_INVERT
-        { DIS_ARG_WORD, DIS_ARG_NONE, true  }, // DIS_OP_AND
-        { DIS_ARG_WORD, DIS_ARG_NONE, true  }, // DIS_OP_OR
-        { DIS_ARG_WORD, DIS_ARG_NONE, true  }, // DIS_OP_JUMP
-        { DIS_ARG_WORD, DIS_ARG_NONE, true  }, // DIS_OP_IF_FALSE_JUMP
+        { DIS_ARG_INDEX, DIS_ARG_NONE, true  }, // DIS_OP_AND
+        { DIS_ARG_INDEX, DIS_ARG_NONE, true  }, // DIS_OP_OR
+        { DIS_ARG_INDEX, DIS_ARG_NONE, true  }, // DIS_OP_JUMP
+        { DIS_ARG_INDEX, DIS_ARG_NONE, true  }, // DIS_OP_IF_FALSE_JUMP
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_FN_CALL
         { DIS_ARG_WORD, DIS_ARG_NONE, false }, // DIS_OP_FN_RETURN
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_POP_STACK
         { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_TERNARY
+        { DIS_ARG_NONE, DIS_ARG_NONE, false }, // DIS_OP_FN_END
+        { DIS_ARG_INDEX, DIS_ARG_INDEX, false }, // DIS_OP_SCOPE_SLOTS
+        { DIS_ARG_BYTE, DIS_ARG_INDEX, false }, // DIS_OP_SLOT_DECL
+        { DIS_ARG_BYTE, DIS_ARG_BYTE, false }, // DIS_OP_SLOT_LOAD
+        { DIS_ARG_BYTE, DIS_ARG_BYTE, false }, // DIS_OP_SLOT_STORE
+        { DIS_ARG_INDEX, DIS_ARG_NONE, true  }, // DIS_OP_IF_TRUE_JUMP
+        { DIS_ARG_BYTE, DIS_ARG_BYTE, false }, // DIS_OP_SLOT_INCREMENT
+        { DIS_ARG_BYTE, DIS_ARG_BYTE, false }, // DIS_OP_SLOT_DECREMENT
 };
 
 typedef struct dis_program_s {
@@ -199,6 +215,11 @@ static int32_t readInt(const uint8_t *tb, uint32_t *count) {
     return ret;
 }
 
+static uint32_t readIndex(const uint8_t *tb, uint32_t *count) {
+    uint16_t ret = readWord(tb, count);
+    return ret != 0xFFFF ? ret : (uint32_t) readInt(tb, count);
+}
+
 static float readFloat(const uint8_t *tb, uint32_t *count) {
     float ret = 0;
     memcpy(&ret, tb + *count, 4);
@@ -305,6 +326,10 @@ static void dis_print_opcode(uint8_t op) {
 		        uint = readWord((*prg)->program, &pc);\
 		        if (p) printf(" w(%d)", uint); \
 		    break; \
+		    case DIS_ARG_INDEX: \
+		        uint = readIndex((*prg)->program, &pc);\
+		        if (p) printf(" w(%d)", uint); \
+		    break; \
 		    case DIS_ARG_INTEGER: \
 		        intg = readInt((*prg)->program, &pc); \
 		        if (p) printf(" i(%d)", intg); \
@@ -324,7 +349,7 @@ static void dis_print_opcode(uint8_t op) {
 
 static void dis_disassemble_section(dis_program_t **prg, uint32_t pc, uint32_t len, uint8_t spaces, bool is_function, bool alt_fmt) {
     uint8_t opcode = 0;
-    uint16_t uint = 0;
+    uint32_t uint = 0;
     int32_t intg = 0;
     float flt = 0;
     char *str = NULL;
@@ -332,8 +357,8 @@ static void dis_disassemble_section(dis_program_t **prg, uint32_t pc, uint32_t l
     // first 4 bytes of the program section within a function are actually specifying the parameter and return lists
     if (is_function) {
         printf("\n");
-        uint16_t args = readWord((*prg)->program, &pc);
-        uint16_t rets = readWord((*prg)->program, &pc);
+        uint32_t args = readIndex((*prg)->program, &pc);
+        uint32_t rets = readIndex((*prg)->program, &pc);
         if (!alt_fmt) {
             SPC(spaces);
             printf("| ");
@@ -344,15 +369,15 @@ static void dis_disassemble_section(dis_program_t **prg, uint32_t pc, uint32_t l
     uint32_t pc_start = pc;
 
     uint32_t labels_qty = 0;
-    uint16_t *label_line = NULL;
+    uint32_t *label_line = NULL;
     uint32_t *label_id = NULL;
     if (alt_fmt) {
         // first pass: search jump labels
-        label_line = malloc(sizeof(uint16_t));
+        label_line = malloc(sizeof(uint32_t));
         label_id = malloc(sizeof(uint32_t));
 
         while (pc < len) {
-            label_line = realloc(label_line, (labels_qty + 1) * sizeof(uint16_t));
+            label_line = realloc(label_line, (labels_qty + 1) * sizeof(uint32_t));
             label_id = realloc(label_id, (labels_qty + 1) * sizeof(uint32_t));
 
             opcode = (*prg)->program[pc];
@@ -414,7 +439,7 @@ static void dis_disassemble_section(dis_program_t **prg, uint32_t pc, uint32_t l
 
         if (alt_fmt) {
             if (OP_ARGS[opcode][2]) {
-                uint = readWord((*prg)->program, &pc);
+                uint = readIndex((*prg)->program, &pc);
                 for (uint32_t lbl = 0; lbl < labels_qty; lbl++) {
                     if (uint == label_line[lbl]) {
                         printf(" JL_%04d_", label_id[lbl]);
@@ -438,12 +463,13 @@ static void dis_disassemble_section(dis_program_t **prg, uint32_t pc, uint32_t l
         printf("\n    FN_RETURN w(0)");
 }
 
-#define LIT_ADD(a, b, c)  b[c] = a;  ++c;
+#define LIT_ADD(a, b, c)  if (c == b##_capacity) { b##_capacity *= 2; b = realloc(b, b##_capacity); }  b[c] = a;  ++c;
 static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uint8_t spaces, char *tree, bool alt_fmt) {
     uint32_t literal_count = 0;
-    uint8_t literal_type[65536];
+    uint32_t literal_type_capacity = 256;
+    uint8_t *literal_type = malloc(literal_type_capacity);
 
-    const unsigned short literalCount = readWord((*prg)->program, pc);
+    const uint32_t literalCount = readIndex((*prg)->program, pc);
 
     printf("\n");
     if (!alt_fmt) {
@@ -453,7 +479,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
         printf("--- ( Reading %d literals from cache ) ---\n", literalCount);
     }
 
-    for (int i = 0; i < literalCount; i++) {
+    for (uint32_t i = 0; i < literalCount; i++) {
         const unsigned char literalType = readByte((*prg)->program, pc);
 
         switch (literalType) {
@@ -528,7 +554,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
 
             case DIS_LITERAL_ARRAY_INTERMEDIATE:
             case DIS_LITERAL_ARRAY: {
-                unsigned short length = readWord((*prg)->program, pc);
+                uint32_t length = readIndex((*prg)->program, pc);
                 if (!alt_fmt) {
                     SPC(spaces);
                     printf("| | ");
@@ -538,8 +564,8 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
                     printf(".lit ARRAY ");
                 }
 
-                for (int i = 0; i < length; i++) {
-                    int index = readWord((*prg)->program, pc);
+                for (uint32_t i = 0; i < length; i++) {
+                    uint32_t index = readIndex((*prg)->program, pc);
                     printf("%d ", index);
                     LIT_ADD(DIS_LITERAL_NULL, literal_type, literal_count);
                     if (!(i % 15) && i != 0) {
@@ -562,7 +588,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
 
             case DIS_LITERAL_DICTIONARY_INTERMEDIATE:
             case DIS_LITERAL_DICTIONARY: {
-                unsigned short length = readWord((*prg)->program, pc);
+                uint32_t length = readIndex((*prg)->program, pc);
                 if (!alt_fmt) {
                     SPC(spaces);
                     printf("| | ");
@@ -571,9 +597,9 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
                     printf("    ");
                     printf(".lit DICTIONARY ");
                 }
-                for (int i = 0; i < length / 2; i++) {
-                    int key = readWord((*prg)->program, pc);
-                    int val = readWord((*prg)->program, pc);
+                for (uint32_t i = 0; i < length / 2; i++) {
+                    uint32_t key = readIndex((*prg)->program, pc);
+                    uint32_t val = readIndex((*prg)->program, pc);
 
                     if (!alt_fmt)
                         printf("(key: %d, val:%d) ", key, val);
@@ -598,7 +624,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
                 break;
 
             case DIS_LITERAL_FUNCTION: {
-                unsigned short index = readWord((*prg)->program, pc);
+                uint32_t index = readIndex((*prg)->program, pc);
                 LIT_ADD(DIS_LITERAL_FUNCTION_INTERMEDIATE, literal_type, literal_count);
                 if (!alt_fmt) {
                     SPC(spaces);
@@ -639,7 +665,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
                 }
 
                 if (literalType == DIS_LITERAL_ARRAY) {
-                    uint16_t vt = readWord((*prg)->program, pc);
+                    uint32_t vt = readIndex((*prg)->program, pc);
                     if (!alt_fmt) {
                         SPC(spaces);
                         printf("| | ");
@@ -649,8 +675,8 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
 
                     printf("\n");
                 } else if (literalType == DIS_LITERAL_DICTIONARY) {
-                    uint8_t kt = readWord((*prg)->program, pc);
-                    uint8_t vt = readWord((*prg)->program, pc);
+                    uint32_t kt = readIndex((*prg)->program, pc);
+                    uint32_t vt = readIndex((*prg)->program, pc);
                     if (!alt_fmt) {
                         SPC(spaces);
                         printf("| | ");
@@ -688,8 +714,8 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
         printf("--- ( end literal section ) ---\n");
     }
 
-    int functionCount = readWord((*prg)->program, pc);
-    int functionSize = readWord((*prg)->program, pc);
+    int functionCount = readIndex((*prg)->program, pc);
+    int functionSize = readIndex((*prg)->program, pc);
 
     if (functionCount) {
         if (!alt_fmt) {
@@ -705,7 +731,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
 
         for (uint32_t i = 0; i < literal_count; i++) {
             if (literal_type[i] == DIS_LITERAL_FUNCTION_INTERMEDIATE) {
-                size_t size = (size_t) readWord((*prg)->program, pc);
+                size_t size = (size_t) readIndex((*prg)->program, pc);
 
                 uint32_t fpc_start = *pc;
                 uint32_t fpc_end = *pc + size - 1;
@@ -771,6 +797,7 @@ static void dis_read_interpreter_sections(dis_program_t **prg, uint32_t *pc, uin
         }
     }
 
+    free(literal_type);
     consumeByte(DIS_OP_SECTION_END, (*prg)->program, pc);
 }
 
@@ -94,6 +94,18 @@ typedef enum DIS_OPCODES {
 
     //meta
     DIS_OP_FN_END,                     // different from SECTION_END
+
+    //local variables, resolved to numbered slots by the compiler
+    DIS_OP_SCOPE_SLOTS,                //
+    DIS_OP_SLOT_DECL,                  //
+    DIS_OP_SLOT_LOAD,                  //
+    DIS_OP_SLOT_STORE,                 //
+
+    //superinstructions, fused by the optimizer
+    DIS_OP_IF_TRUE_JUMP,               //
+    DIS_OP_SLOT_INCREMENT,             //
+    DIS_OP_SLOT_DECREMENT,             //
+
     DIS_OP_END_OPCODES,                // mark for end opcodes list. Not valid opcode
     DIS_OP_SECTION_END = 255,
 } dis_opcode_t;
@@ -2,9 +2,16 @@
 #include "toy_memory.h"
 #include "toy_console_colors.h"
 #include "lib_runner.h"
+#include "drive_system.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
 
 //tracker allocator
 int currentMemoryUsed = 0;
@@ -55,28 +62,77 @@ int main(int argc, const char* argv[]) {
 	Toy_initCommandLine(argc, argv);
 
 	//setup for runner
-	Toy_initDriveDictionary();
+	Toy_initDriveSystem();
+	Toy_setDrivePath("scripts", "scripts");
 
-	Toy_Literal driveLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString("scripts"));
-	Toy_Literal pathLiteral = TOY_TO_STRING_LITERAL(Toy_createRefString("scripts"));
+	Toy_setMemoryAllocator(trackerAllocator);
 
-	Toy_setLiteralDictionary(Toy_getDriveDictionary(), driveLiteral, pathLiteral);
+	//-r runs each file within a memory region, so only the region's chunks reach the tracker
+	//-c only compiles each file, and reports the time taken and the peak RSS of the process
+	bool useRegion = false;
+	bool compileOnly = false;
+	int firstFile = 1;
 
-	Toy_freeLiteral(driveLiteral);
-	Toy_freeLiteral(pathLiteral);
+	if (argc > 2 && !strcmp(argv[1], "-r")) {
+		useRegion = true;
+		firstFile = 2;
+	}
 
-	Toy_setMemoryAllocator(trackerAllocator);
+	if (argc > 2 && !strcmp(argv[1], "-c")) {
+		compileOnly = true;
+		firstFile = 2;
+	}
+
+	double compileSeconds = 0;
 
 	//run memory tests
-	for (int fileCounter = 1; fileCounter < argc; fileCounter++) {
-		Toy_runSourceFile(argv[fileCounter]);
+	for (int fileCounter = firstFile; fileCounter < argc; fileCounter++) {
+		if (useRegion) {
+			Toy_beginMemoryRegion();
+		}
+
+		if (compileOnly) {
+			size_t size = 0;
+			const char* source = (const char*)Toy_readFile(argv[fileCounter], &size);
+
+			if (source == NULL) {
+				continue;
+			}
+
+			clock_t start = clock();
+			const unsigned char* tb = Toy_compileString(source, &size);
+			compileSeconds += (double)(clock() - start) / CLOCKS_PER_SEC;
+
+			free((void*)tb);
+			free((void*)source);
+		}
+		else {
+			Toy_runSourceFile(argv[fileCounter]);
+		}
+
+		if (useRegion) {
+			Toy_endMemoryRegion();
+		}
 	}
 
 	//lib cleanup
-	Toy_freeDriveDictionary();
+	Toy_freeDriveSystem();
 
 	//report output
 	printf("Heap Memory Report:\n\t%d max bytes\n\t%d calls to the allocator\n\t%d calls to realloc()\n\t%d calls to free()\n\t%d discrepancies\n", maxMemoryUsed, memoryAllocCalls, memoryAllocRealloc, memoryAllocFree, memoryAllocCalls - memoryAllocRealloc - memoryAllocFree);
 
+	Toy_RefStringInternStats internStats = Toy_getRefStringInternStats();
+	if (compileOnly) {
+		printf("Compile Report:\n\t%f seconds\n", compileSeconds);
+
+#ifndef _WIN32
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		printf("\t%ld KB peak RSS\n", usage.ru_maxrss);
+#endif
+	}
+
+	printf("Intern Table Report:\n\t%zu lookups\n\t%zu hits (%.1f%%)\n", internStats.lookups, internStats.hits, internStats.lookups > 0 ? 100.0 * internStats.hits / internStats.lookups : 0.0);
+
 	return 0;
 }